@@ -0,0 +1,591 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        circle_store.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class stores a group of circles (trees or food
+//                 drops) as a structure of arrays. Each circle keeps
+//                 track of an amount of substance (food), which steadily
+//                 diminishes, and resizes accordingly.
+//
+//    Date:        10/3/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <numeric>
+
+// Source libraries
+#include "circle_store.h"
+
+//******************************************************************
+//
+//  Function:   CircleStore::size
+//
+//  Purpose:    returns the number of circles in the store
+//
+//  Parameters: none
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the number of circles
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint CircleStore::size() const {
+    return positions.size();
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::get_id
+//
+//  Purpose:    returns the stable id of a circle
+//
+//  Parameters: i
+//
+//  Member/Global Variables: ids
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: returns the id of circle i
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint CircleStore::get_id(GLuint i) const {
+    return ids[i];
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::get_position
+//
+//  Purpose:    returns the position of a circle
+//
+//  Parameters: i
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: returns the position of circle i
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 CircleStore::get_position(GLuint i) const {
+    return positions[i];
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::get_positions
+//
+//  Purpose:    returns the positions of every circle
+//
+//  Parameters: none
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the positions array, indexed like the circles
+//
+//  Calls:      none
+//
+//******************************************************************
+const std::vector<vec2>& CircleStore::get_positions() const {
+    return positions;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::get_radius
+//
+//  Purpose:    gets the radius of a circle
+//
+//  Parameters: i
+//
+//  Member/Global Variables: init_amounts, init_radii
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: the radius of circle i will be returned, in
+//                   proportion to how much of its starting amount is
+//                   left (circles that started with no amount, like
+//                   trees, keep their starting radius)
+//
+//  Calls:      get_amount
+//
+//******************************************************************
+float CircleStore::get_radius(GLuint i) const {
+    if (init_amounts[i] == 0) {
+        return init_radii[i];
+    }
+    return (get_amount(i) / init_amounts[i]) * init_radii[i];
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::get_init_radii
+//
+//  Purpose:    returns the radius every circle was added with
+//
+//  Parameters: none
+//
+//  Member/Global Variables: init_radii
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the starting radius of every circle, in
+//                   index order
+//
+//  Calls:      none
+//
+//******************************************************************
+const std::vector<float>& CircleStore::get_init_radii() const {
+    return init_radii;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::get_amount
+//
+//  Purpose:    gets the amount of substance of a circle
+//
+//  Parameters: i
+//
+//  Member/Global Variables: amounts, stamps, diminish_speeds, clock
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: the amount of circle i will be returned: what it
+//                   had when its amount last changed, less what has
+//                   diminished since (and never less than 0)
+//
+//  Calls:      none
+//
+//******************************************************************
+float CircleStore::get_amount(GLuint i) const {
+    float diminished = static_cast<float>((clock - stamps[i]) * diminish_speeds[i]);
+    if (diminished > amounts[i]) {
+        return 0;
+    }
+    return amounts[i] - diminished;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::add
+//
+//  Purpose:    adds a circle to the store
+//
+//  Parameters: pos, radius, amnt, dim_speed
+//
+//  Member/Global Variables: all of the circle arrays, slots, free_ids,
+//                           clock
+//
+//  Pre Conditions:  all parameters must have valid values
+//
+//  Post Conditions: a circle with the given values will be appended,
+//                   starting to diminish now, and its id returned
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint CircleStore::add(const vec2& pos, float radius, float amnt, float dim_speed) {
+    // reuse the id of a removed circle if there is one
+    GLuint id;
+    if (free_ids.size() > 0) {
+        id = free_ids.back();
+        free_ids.pop_back();
+    } else {
+        id = slots.size();
+        slots.push_back(NO_ID);
+    }
+    slots[id] = positions.size();
+
+    positions.push_back(pos);
+    init_radii.push_back(radius);
+    amounts.push_back(amnt);
+    stamps.push_back(clock);
+    init_amounts.push_back(amnt);
+    diminish_speeds.push_back(dim_speed);
+    ids.push_back(id);
+
+    return id;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::assign
+//
+//  Purpose:    replaces every circle with a batch of new circles
+//
+//  Parameters: pos, radius, count, amnt, dim_speed
+//
+//  Member/Global Variables: all of the circle arrays, slots, free_ids,
+//                           clock
+//
+//  Pre Conditions:  pos and radius must each hold count values
+//
+//  Post Conditions: the store will hold count circles with ids 0 to
+//                   count - 1, the same as adding each in turn to an
+//                   empty store; if enough room was reserved, nothing
+//                   is allocated
+//
+//  Calls:      std::iota
+//
+//******************************************************************
+void CircleStore::assign(const vec2* pos, const float* radius, GLuint count, float amnt, float dim_speed) {
+    positions.assign(pos, pos + count);
+    init_radii.assign(radius, radius + count);
+    amounts.assign(count, amnt);
+    stamps.assign(count, clock);
+    init_amounts.assign(count, amnt);
+    diminish_speeds.assign(count, dim_speed);
+
+    // circle i gets id i, as it would if the circles were added one by one
+    ids.resize(count);
+    slots.resize(count);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::iota(slots.begin(), slots.end(), 0);
+    free_ids.clear();
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::remove
+//
+//  Purpose:    removes a circle from the store
+//
+//  Parameters: i
+//
+//  Member/Global Variables: all of the circle arrays, slots, free_ids
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: circle i will be removed; order doesn't need to be
+//                   preserved, so the last circle is moved into index i
+//
+//  Calls:      none
+//
+//******************************************************************
+void CircleStore::remove(GLuint i) {
+    GLuint last = positions.size() - 1;
+
+    slots[ids[i]] = NO_ID;
+    free_ids.push_back(ids[i]);
+    if (i != last) {
+        // move the last circle into the freed index
+        positions[i] = positions[last];
+        init_radii[i] = init_radii[last];
+        amounts[i] = amounts[last];
+        stamps[i] = stamps[last];
+        init_amounts[i] = init_amounts[last];
+        diminish_speeds[i] = diminish_speeds[last];
+        ids[i] = ids[last];
+        slots[ids[i]] = i;
+    }
+
+    positions.pop_back();
+    init_radii.pop_back();
+    amounts.pop_back();
+    stamps.pop_back();
+    init_amounts.pop_back();
+    diminish_speeds.pop_back();
+    ids.pop_back();
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::reserve
+//
+//  Purpose:    allocates room for a number of circles up front
+//
+//  Parameters: count
+//
+//  Member/Global Variables: all of the circle arrays, slots, free_ids
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: adding and removing circles will not allocate memory
+//                   while the store holds at most count circles and no
+//                   more than count ids have been handed out
+//
+//  Calls:      none
+//
+//******************************************************************
+void CircleStore::reserve(GLuint count) {
+    positions.reserve(count);
+    init_radii.reserve(count);
+    amounts.reserve(count);
+    stamps.reserve(count);
+    init_amounts.reserve(count);
+    diminish_speeds.reserve(count);
+    ids.reserve(count);
+    slots.reserve(count);
+    free_ids.reserve(count);
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::clear
+//
+//  Purpose:    removes every circle from the store
+//
+//  Parameters: none
+//
+//  Member/Global Variables: all of the circle arrays, slots, free_ids,
+//                           clock
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the store will be empty, and ids and the clock will
+//                   start from 0;
+//                   the arrays keep their memory, so the store can be
+//                   refilled without allocating
+//
+//  Calls:      none
+//
+//******************************************************************
+void CircleStore::clear() {
+    positions.clear();
+    init_radii.clear();
+    amounts.clear();
+    stamps.clear();
+    init_amounts.clear();
+    diminish_speeds.clear();
+    ids.clear();
+    slots.clear();
+    free_ids.clear();
+    clock = 0;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::save
+//
+//  Purpose:    writes every circle to a snapshot
+//
+//  Parameters: out
+//
+//  Member/Global Variables: all of the circle arrays, slots, free_ids,
+//                           clock
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every array of the store, ids included, will have
+//                   been appended to out in one copy each, followed by
+//                   the clock
+//
+//  Calls:      SnapshotWriter::write_array, SnapshotWriter::write
+//
+//******************************************************************
+void CircleStore::save(SnapshotWriter& out) const {
+    out.write_array(positions);
+    out.write_array(init_radii);
+    out.write_array(amounts);
+    out.write_array(stamps);
+    out.write_array(init_amounts);
+    out.write_array(diminish_speeds);
+    out.write_array(ids);
+    out.write_array(slots);
+    out.write_array(free_ids);
+    out.write(clock);
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::restore
+//
+//  Purpose:    replaces every circle with the ones written to a snapshot
+//
+//  Parameters: in
+//
+//  Member/Global Variables: all of the circle arrays, slots, free_ids,
+//                           clock
+//
+//  Pre Conditions:  the next thing in the snapshot must be a store
+//                   written by save
+//
+//  Post Conditions: the store will be exactly as it was saved, ids and
+//                   clock included, so ids saved elsewhere find the same
+//                   circles again (the arrays only allocate if they have
+//                   no room); returns false if the snapshot ended or its
+//                   arrays don't all hold the same number of circles,
+//                   leaving the store in no particular state
+//
+//  Calls:      SnapshotReader::read_array, SnapshotReader::read
+//
+//******************************************************************
+bool CircleStore::restore(SnapshotReader& in) {
+    in.read_array(positions);
+    in.read_array(init_radii);
+    in.read_array(amounts);
+    in.read_array(stamps);
+    in.read_array(init_amounts);
+    in.read_array(diminish_speeds);
+    in.read_array(ids);
+    in.read_array(slots);
+    in.read_array(free_ids);
+
+    size_t count = positions.size();
+    return in.read(clock) && init_radii.size() == count && amounts.size() == count &&
+           stamps.size() == count && init_amounts.size() == count && diminish_speeds.size() == count &&
+           ids.size() == count;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::give_amount
+//
+//  Purpose:    gives a circle an amount of substance
+//
+//  Parameters: i, amnt
+//
+//  Member/Global Variables: amounts
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: the amount of circle i will be incremented by amnt
+//
+//  Calls:      settle
+//
+//******************************************************************
+void CircleStore::give_amount(GLuint i, float amnt) {
+    settle(i);
+    amounts[i] += amnt;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::take_amount
+//
+//  Purpose:    takes an amount of substance from a circle
+//
+//  Parameters: i, amnt
+//
+//  Member/Global Variables: amounts
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: the amount of circle i will either be 0 or
+//                   decremented by amnt, and the amount taken from the
+//                   circle will be returned
+//
+//  Calls:      settle
+//
+//******************************************************************
+float CircleStore::take_amount(GLuint i, float amnt) {
+    settle(i);
+    if (amnt > amounts[i]) {  // check to see if we can provide that much
+        float taken = amounts[i];
+        amounts[i] = 0;
+        return taken;  // return amount we took
+    } else {
+        amounts[i] -= amnt;
+        return amnt;  // return amount we took
+    }
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::advance
+//
+//  Purpose:    moves every circle forward in time, diminishing their
+//              amounts
+//
+//  Parameters: dt
+//
+//  Member/Global Variables: clock
+//
+//  Pre Conditions:  dt must not be negative
+//
+//  Post Conditions: every circle's amount (and so its size) will have
+//                   diminished by dt times its diminish speed, without
+//                   visiting any of them
+//
+//  Calls:      none
+//
+//******************************************************************
+void CircleStore::advance(float dt) {
+    clock += dt;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::settle
+//
+//  Purpose:    brings a circle's stored amount up to date
+//
+//  Parameters: i
+//
+//  Member/Global Variables: amounts, stamps, clock
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: amounts[i] will be the circle's current amount, and
+//                   it will diminish from now on
+//
+//  Calls:      get_amount
+//
+//******************************************************************
+void CircleStore::settle(GLuint i) {
+    amounts[i] = get_amount(i);
+    stamps[i] = clock;
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::find
+//
+//  Purpose:    finds the index of the circle with the given id
+//
+//  Parameters: id
+//
+//  Member/Global Variables: slots
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the index of the circle with id, or NO_ID
+//                   if no circle has that id
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint CircleStore::find(GLuint id) const {
+    if (id >= slots.size()) {
+        return NO_ID;
+    }
+    return slots[id];
+}
+
+//******************************************************************
+//
+//  Function:   CircleStore::is_gone
+//
+//  Purpose:    determines whether a circle's amount of substance
+//              is gone
+//
+//  Parameters: i
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  i must be a valid circle index
+//
+//  Post Conditions: true will be returned if the amount equals 0
+//
+//  Calls:      float_equal, get_amount
+//
+//******************************************************************
+bool CircleStore::is_gone(GLuint i) const {
+    return float_equal(get_amount(i), 0.0);
+}
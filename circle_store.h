@@ -0,0 +1,125 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        circle_store.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class stores a group of circles (trees or food
+//                 drops) as a structure of arrays. Each circle keeps
+//                 track of an amount of substance (food), which steadily
+//                 diminishes, and resizes accordingly.
+//
+//    Date:        10/3/2019
+//
+//*******************************************************************
+
+#ifndef CIRCLE_STORE_H
+#define CIRCLE_STORE_H
+
+// C/C++ Standard libraries
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "snapshot.h"
+#include "utilities.h"
+
+//******************************************************************
+//
+//  Class: CircleStore
+//
+//  Purpose:  To provide contiguous storage for circles, with one array
+//            per property. Circles are addressed by index for iteration,
+//            and by a stable id that survives other circles being removed.
+//            Amounts diminish linearly with time, so rather than ticking
+//            every circle, the store keeps a clock and each circle keeps
+//            its amount as of the last time something else changed it.
+//
+//  Functions:
+//           Constructors
+//             CircleStore() creates an empty store
+//           getters
+//             size to return the number of circles
+//             get_id(i) to return the stable id of circle i
+//             get_position(i) to return the position of circle i
+//             get_positions to return the positions of every circle
+//             get_radius(i) to return the radius of circle i
+//             get_init_radii to return the radius every circle was added with
+//             get_amount(i) to return the amount of substance circle i has
+//           mutators
+//             add(pos, radius, amnt, dim_speed) adds a circle with the given
+//                                               radius, amount of substance,
+//                                               and diminish speed, and
+//                                               returns its id
+//             assign(pos, radius, count, amnt,
+//                    dim_speed)  replaces every circle with count circles of
+//                                the given positions and radii, copying each
+//                                array in one go
+//             remove(i) removes circle i by swapping the last circle into
+//                       its place
+//             clear() removes every circle
+//             reserve(count) allocates room for count circles up front
+//             save(out) writes every circle to a snapshot
+//             restore(in) replaces every circle with the ones in a snapshot
+//             give_amount(i, amnt) to give an amount of substance to circle i
+//             take_amount(i, amnt) to take an amount of substance from circle i
+//             advance(dt) to move every circle dt forward in time
+//           helpers
+//             find(id) returns the index of the circle with id, or NO_ID
+//             is_gone(i) returns true if circle i is out of substance
+//           private helpers
+//             settle(i) brings circle i's stored amount up to the clock
+//
+//******************************************************************
+
+class CircleStore {
+ public:
+    CircleStore() : clock(0) {}
+
+    // getters
+    GLuint size() const;
+    GLuint get_id(GLuint i) const;
+    vec2 get_position(GLuint i) const;
+    const std::vector<vec2>& get_positions() const;
+    float get_radius(GLuint i) const;
+    const std::vector<float>& get_init_radii() const;
+    float get_amount(GLuint i) const;
+
+    // mutators
+    GLuint add(const vec2& pos, float radius, float amnt, float dim_speed);
+    void assign(const vec2* pos, const float* radius, GLuint count, float amnt, float dim_speed);
+    void remove(GLuint i);
+    void clear();
+    void reserve(GLuint count);
+    void save(SnapshotWriter& out) const;
+    bool restore(SnapshotReader& in);
+    void give_amount(GLuint i, float amnt);
+    float take_amount(GLuint i, float amnt);
+    void advance(float dt);
+
+    // helpers
+    GLuint find(GLuint id) const;
+    bool is_gone(GLuint i) const;
+ private:
+    std::vector<vec2> positions;  // position of each circle
+    std::vector<float> init_radii;  // radius of each circle when it was added
+    std::vector<float> amounts;  // amount of substance (food, or amount of tree) each circle had at its stamp
+    std::vector<double> stamps;  // clock time each circle's amount was last brought up to date
+    std::vector<float> init_amounts;  // amount of substance of each circle when it was added
+    std::vector<float> diminish_speeds;  // speed at which each circle's amount diminishes over time
+    std::vector<GLuint> ids;  // stable id of each circle
+
+    std::vector<GLuint> slots;  // index of the circle with each id (or NO_ID)
+    std::vector<GLuint> free_ids;  // ids of removed circles, ready for reuse
+
+    double clock;  // time since the store was last cleared
+
+    // private helpers
+    void settle(GLuint i);
+};
+
+#endif
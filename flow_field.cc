@@ -0,0 +1,351 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        flow_field.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides the walking distance to a food
+//                 drop, and the way to head to reach it, from every
+//                 small cell around the drop, found once by a wave
+//                 spreading out from the drop around the trees, so that
+//                 every unit going for the drop steers by looking up its
+//                 cell instead of searching for a path of its own.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+// Source libraries
+#include "flow_field.h"
+
+// Steps a cell can head to next: one of the 8 neighbors, straight to the goal, or nowhere
+const unsigned char FLOW_NEIGHBORS = 8;  // steps below this are neighbors, in the order of the offsets below
+const unsigned char FLOW_STRAIGHT = 8;  // the goal can be seen from the cell, so head right for it
+const unsigned char FLOW_NONE = 9;  // the cell is blocked, or too far to walk from the goal
+
+// Column and row offsets of each neighbor (the 4 sides first, then the corners), in opposite pairs
+const int FLOW_COLS[FLOW_NEIGHBORS] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+const int FLOW_ROWS[FLOW_NEIGHBORS] = { 0, 0, 1, -1, 1, -1, -1, 1 };
+
+//******************************************************************
+//
+//  Function:   FlowField::get_goal
+//
+//  Purpose:    returns the position the field leads to
+//
+//  Parameters: none
+//
+//  Member/Global Variables: goal
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the value of goal
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 FlowField::get_goal() const {
+    return goal;
+}
+
+//******************************************************************
+//
+//  Function:   FlowField::build
+//
+//  Purpose:    finds how to walk to a goal from every cell around it
+//
+//  Parameters: trees, g, range, low, high, size
+//
+//  Member/Global Variables: origin, goal, cell_size, cols, rows,
+//                           goal_cell, distances, steps, frontier,
+//                           FLOW_COLS, FLOW_ROWS, FLOW_NEIGHBORS,
+//                           FLOW_STRAIGHT, FLOW_NONE, MAX_CELLS
+//
+//  Pre Conditions:  trees must have been built with the clearance units
+//                   keep from trees, and range and size must be greater
+//                   than 0
+//
+//  Post Conditions: every cell within range of g on foot (plus a cell
+//                   or so of slack) will know its distance from g and
+//                   the neighbor a step closer, or that g can be seen
+//                   from it; cells whose centers are blocked by trees or
+//                   outside the box are never walked through (except
+//                   the goal's own); the field only covers the part of
+//                   the box within range, with cells as many times
+//                   bigger than size as keeps them to MAX_CELLS, and
+//                   memory is only allocated if the field has grown
+//
+//  Calls:      TreeGrid::point_blocked, TreeGrid::segment_blocked,
+//              get_center, std::ceil, std::floor, std::min, std::max,
+//              std::sqrt, std::push_heap, std::pop_heap, std::greater
+//
+//******************************************************************
+void FlowField::build(const TreeGrid& trees, const vec2& g, float range, const vec2& low, const vec2& high,
+                      float size) {
+    // the goal sits in the middle of a cell, with range and a cell of slack on every side, but
+    // only as far as the box (plus a cell, for units standing at its edge); a field that would
+    // still have too many cells is made of bigger ones
+    goal = g;
+    cell_size = size;
+    int min_col, min_row, max_col, max_row;  // cells of the field, counted from the goal's
+    while (true) {
+        int half = static_cast<int>(std::min(std::ceil(range / cell_size) + 1, static_cast<float>(MAX_CELLS)));
+        min_col = std::min(0, std::max(-half, static_cast<int>(std::ceil((low.x - goal.x) / cell_size)) - 1));
+        min_row = std::min(0, std::max(-half, static_cast<int>(std::ceil((low.y - goal.y) / cell_size)) - 1));
+        max_col = std::max(0, std::min(half, static_cast<int>(std::floor((high.x - goal.x) / cell_size)) + 1));
+        max_row = std::max(0, std::min(half, static_cast<int>(std::floor((high.y - goal.y) / cell_size)) + 1));
+        cols = max_col - min_col + 1;
+        rows = max_row - min_row + 1;
+        if (static_cast<double>(cols) * rows <= MAX_CELLS) {
+            break;
+        }
+        cell_size *= 2;
+    }
+    origin = goal + vec2(min_col - 0.5f, min_row - 0.5f) * cell_size;
+    goal_cell = -min_row * cols - min_col;
+    float limit = range + 2 * cell_size;  // farther than any lookup within range can add to a cell's distance
+
+    // cells a unit can't stand in are never reached
+    const float inf = std::numeric_limits<float>::infinity();
+    distances.assign(cols * rows, inf);
+    steps.assign(cols * rows, FLOW_NONE);
+    for (int cell = 0; cell < cols * rows; ++cell) {
+        vec2 center = get_center(cell);
+        bool inside = center.x >= low.x && center.y >= low.y && center.x <= high.x && center.y <= high.y;
+        if (!inside || trees.point_blocked(center)) {
+            distances[cell] = -1;  // blocked
+        }
+    }
+
+    // spread a wave out from the goal, always from the closest cell not spread from yet
+    const float diagonal = std::sqrt(2.0f) * cell_size;
+    distances[goal_cell] = 0;
+    frontier.clear();
+    frontier.push_back(std::make_pair(0.0f, static_cast<GLuint>(goal_cell)));
+    while (!frontier.empty()) {
+        std::pop_heap(frontier.begin(), frontier.end(), std::greater<std::pair<float, GLuint>>());
+        float distance = frontier.back().first;
+        int cell = frontier.back().second;
+        frontier.pop_back();
+        if (distance > distances[cell] || distance > limit) {
+            continue;  // already reached a shorter way, or too far to matter
+        }
+
+        int col = cell % cols;
+        int row = cell / cols;
+        for (unsigned char step = 0; step < FLOW_NEIGHBORS; ++step) {
+            int next_col = col + FLOW_COLS[step];
+            int next_row = row + FLOW_ROWS[step];
+            if (next_col < 0 || next_row < 0 || next_col >= cols || next_row >= rows) {
+                continue;
+            }
+            int next = next_row * cols + next_col;
+            bool corner = step >= 4;
+            if (distances[next] < 0 ||
+                (corner && (distances[row * cols + next_col] < 0 || distances[next_row * cols + col] < 0))) {
+                continue;  // blocked, or cutting across a blocked cell
+            }
+
+            float next_distance = distance + (corner ? diagonal : cell_size);
+            if (next_distance < distances[next]) {
+                distances[next] = next_distance;
+                steps[next] = step ^ 1;  // the offsets come in opposite pairs, so this steps back toward cell
+                frontier.push_back(std::make_pair(next_distance, static_cast<GLuint>(next)));
+                std::push_heap(frontier.begin(), frontier.end(), std::greater<std::pair<float, GLuint>>());
+            }
+        }
+    }
+
+    // a unit that can see the goal walks straight at it rather than along the cells
+    for (int cell = 0; cell < cols * rows; ++cell) {
+        if (distances[cell] < 0) {
+            distances[cell] = inf;
+        } else if (distances[cell] <= limit && (cell == goal_cell || !trees.segment_blocked(get_center(cell), goal))) {
+            steps[cell] = FLOW_STRAIGHT;
+        } else if (distances[cell] > limit) {
+            distances[cell] = inf;
+            steps[cell] = FLOW_NONE;
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   FlowField::get_distance
+//
+//  Purpose:    returns how far a position is from the goal on foot
+//
+//  Parameters: pos
+//
+//  Member/Global Variables: goal, distances, steps, FLOW_STRAIGHT
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the straight line distance to the goal if
+//                   it can be seen from pos's cell, otherwise the
+//                   distance of the cell (or, if pos's own cell is
+//                   blocked, its best neighbor) plus the way to its
+//                   center; returns infinity if the goal can't be walked
+//                   to from pos within the field's range
+//
+//  Calls:      get_cell, find_nearest, get_center, length
+//
+//******************************************************************
+float FlowField::get_distance(const vec2& pos) const {
+    int cell = get_cell(pos);
+    if (cell < 0) {
+        return std::numeric_limits<float>::infinity();
+    }
+    if (steps[cell] == FLOW_STRAIGHT) {
+        return length(goal - pos);
+    }
+
+    cell = find_nearest(pos, cell);
+    if (cell < 0) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return distances[cell] + length(get_center(cell) - pos);
+}
+
+//******************************************************************
+//
+//  Function:   FlowField::get_waypoint
+//
+//  Purpose:    returns where a unit should head next to reach the goal
+//
+//  Parameters: pos
+//
+//  Member/Global Variables: goal, steps, cols, FLOW_STRAIGHT,
+//                           FLOW_NEIGHBORS, FLOW_COLS, FLOW_ROWS
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the goal if it can be seen from pos's cell
+//                   (or pos is outside the field, or nowhere in reach
+//                   leads to it), otherwise the center of the next cell
+//                   on the way (from pos's cell, or the best neighbor
+//                   of it if it's blocked, heading to that neighbor
+//                   first)
+//
+//  Calls:      get_cell, find_nearest, get_center
+//
+//******************************************************************
+vec2 FlowField::get_waypoint(const vec2& pos) const {
+    int cell = get_cell(pos);
+    if (cell < 0 || steps[cell] == FLOW_STRAIGHT) {
+        return goal;
+    }
+
+    int nearest = find_nearest(pos, cell);
+    if (nearest < 0) {
+        return goal;
+    }
+    if (nearest != cell) {
+        return get_center(nearest);  // get out of the blocked cell first
+    }
+
+    unsigned char step = steps[cell];
+    return get_center(cell + FLOW_ROWS[step] * cols + FLOW_COLS[step]);
+}
+
+//******************************************************************
+//
+//  Function:   FlowField::get_cell
+//
+//  Purpose:    returns the cell holding a position
+//
+//  Parameters: pos
+//
+//  Member/Global Variables: origin, cell_size, cols, rows
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the index of the cell holding pos, or -1 if
+//                   pos is outside the field (or NaN)
+//
+//  Calls:      std::floor
+//
+//******************************************************************
+int FlowField::get_cell(const vec2& pos) const {
+    vec2 local = (pos - origin) / cell_size;
+    if (!(local.x >= 0 && local.y >= 0 && local.x < cols && local.y < rows)) {  // also catches NaN
+        return -1;
+    }
+    return static_cast<int>(std::floor(local.y)) * cols + static_cast<int>(std::floor(local.x));
+}
+
+//******************************************************************
+//
+//  Function:   FlowField::get_center
+//
+//  Purpose:    returns the world position of a cell's center
+//
+//  Parameters: cell
+//
+//  Member/Global Variables: origin, cell_size, cols, rows
+//
+//  Pre Conditions:  cell must be a valid cell of the field
+//
+//  Post Conditions: returns the center of the cell
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 FlowField::get_center(int cell) const {
+    return origin + cell_size * vec2(cell % cols + 0.5f, cell / cols + 0.5f);
+}
+
+//******************************************************************
+//
+//  Function:   FlowField::find_nearest
+//
+//  Purpose:    returns the cell a position should walk from
+//
+//  Parameters: pos, cell
+//
+//  Member/Global Variables: distances, cols, rows, FLOW_NEIGHBORS,
+//                           FLOW_COLS, FLOW_ROWS
+//
+//  Pre Conditions:  cell must be the cell holding pos
+//
+//  Post Conditions: returns cell if the wave reached it, otherwise
+//                   whichever reached neighbor of it is closest to the
+//                   goal counting the way from pos to its center, or -1
+//                   if none of them were reached (a unit standing a
+//                   little too close to a tree still finds its way)
+//
+//  Calls:      get_center, length
+//
+//******************************************************************
+int FlowField::find_nearest(const vec2& pos, int cell) const {
+    if (distances[cell] < std::numeric_limits<float>::infinity()) {
+        return cell;
+    }
+
+    int col = cell % cols;
+    int row = cell / cols;
+    int nearest = -1;
+    float best = std::numeric_limits<float>::infinity();
+    for (unsigned char step = 0; step < FLOW_NEIGHBORS; ++step) {
+        int next_col = col + FLOW_COLS[step];
+        int next_row = row + FLOW_ROWS[step];
+        if (next_col < 0 || next_row < 0 || next_col >= cols || next_row >= rows) {
+            continue;
+        }
+        int next = next_row * cols + next_col;
+        float distance = distances[next] + length(get_center(next) - pos);
+        if (distance < best) {
+            best = distance;
+            nearest = next;
+        }
+    }
+    return nearest;
+}
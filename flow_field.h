@@ -0,0 +1,103 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        flow_field.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides the walking distance to a food
+//                 drop, and the way to head to reach it, from every
+//                 small cell around the drop, found once by a wave
+//                 spreading out from the drop around the trees, so that
+//                 every unit going for the drop steers by looking up its
+//                 cell instead of searching for a path of its own.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+// C/C++ Standard libraries
+#include <utility>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "tree_grid.h"
+
+//******************************************************************
+//
+//  Class: FlowField
+//
+//  Purpose:  To cut the square around a goal into cells and find, by
+//            Dijkstra's algorithm over the cells trees don't block
+//            (moving to any of the 8 neighbors, but never across a
+//            blocked corner), how far each cell is from the goal and
+//            which neighbor is a step closer to it. Cells the goal can
+//            be seen from skip the walk and head straight for it.
+//
+//  Functions:
+//           Constructors
+//             FlowField() creates an empty field that reaches nothing
+//           getters
+//             get_goal to return the position the field leads to
+//           mutators
+//             build(trees, goal, range, low, high,
+//                   size)  finds the walk to goal from every cell of the
+//                          given size (or bigger, if there'd be too many)
+//                          within range of it, staying inside the box from
+//                          low to high
+//           helpers
+//             get_distance(pos) returns how far pos is from the goal on
+//                               foot
+//             get_waypoint(pos) returns where a unit at pos should head
+//                               next to reach the goal
+//           private helpers
+//             get_cell(pos) returns the cell holding pos, or -1 if it's
+//                           outside the field
+//             get_center(cell) returns the world position of a cell's
+//                              center
+//             find_nearest(pos, cell) returns the reached cell next to
+//                                     cell closest to the goal from pos
+//
+//******************************************************************
+
+class FlowField {
+ public:
+    FlowField() : origin(vec2()), goal(vec2()), cell_size(1), cols(0), rows(0), goal_cell(0) {}
+
+    // getters
+    vec2 get_goal() const;
+
+    // mutators
+    void build(const TreeGrid& trees, const vec2& g, float range, const vec2& low, const vec2& high, float size);
+
+    // helpers
+    float get_distance(const vec2& pos) const;
+    vec2 get_waypoint(const vec2& pos) const;
+ private:
+    vec2 origin;  // world position of the bottom left corner of the field
+    vec2 goal;  // position the field leads to
+    float cell_size;  // width and height of a cell
+    int cols;  // number of columns of cells
+    int rows;  // number of rows of cells
+    int goal_cell;  // cell holding the goal
+    std::vector<float> distances;  // distance of each cell's center from the goal on foot (infinite if unreached)
+    std::vector<unsigned char> steps;  // neighbor each cell heads to next (a FLOW_ step)
+    std::vector<std::pair<float, GLuint>> frontier;  // cells the wave has reached but not spread from, as a heap (kept to reuse memory)
+
+    // static member variables
+    static const GLuint MAX_CELLS = 262144;  // most cells a field may have, whatever its range
+
+    // private helpers
+    int get_cell(const vec2& pos) const;
+    vec2 get_center(int cell) const;
+    int find_nearest(const vec2& pos, int cell) const;
+};
+
+#endif
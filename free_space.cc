@@ -0,0 +1,260 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        free_space.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides the set of small cells of a map
+//                 that no tree overlaps, so that random positions units
+//                 can stand on are picked directly instead of by
+//                 guessing until one happens to be traversable.
+//
+//    Date:        10/11/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+
+// Source libraries
+#include "free_space.h"
+
+//******************************************************************
+//
+//  Function:   FreeSpace::get_num_free
+//
+//  Purpose:    returns the number of free cells
+//
+//  Parameters: none
+//
+//  Member/Global Variables: num_free
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the value of num_free
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint FreeSpace::get_num_free() const {
+    return num_free;
+}
+
+//******************************************************************
+//
+//  Function:   FreeSpace::build
+//
+//  Purpose:    finds the cells inside the given box that no tree
+//              overlaps
+//
+//  Parameters: trees, clearance, low, high, size
+//
+//  Member/Global Variables: origin, cell_size, cols, rows, num_free,
+//                           free_before, free_rows_before, blocked,
+//                           MAX_CELLS
+//
+//  Pre Conditions:  trees must hold the trees of the map, clearance must
+//                   be the clearance units keep from them, and size must
+//                   be greater than 0
+//
+//  Post Conditions: the box will be covered by whole cells (any part
+//                   left over at the top or right is left out), as many
+//                   times bigger than size as keeps them to MAX_CELLS,
+//                   and every cell will be known to be free or not
+//
+//  Calls:      CircleStore::get_position, CircleStore::get_radius,
+//              length, std::floor, std::ceil, std::max, std::min,
+//              std::sqrt
+//
+//******************************************************************
+void FreeSpace::build(const CircleStore& trees, float clearance, const vec2& low, const vec2& high, float size) {
+    // a box that would have too many cells is cut into bigger ones (counted in doubles, since
+    // a big enough box has more cells than an int can hold)
+    origin = low;
+    cell_size = size;
+    while (true) {
+        double num_cols = std::max(0.0, std::floor((high.x - low.x) / static_cast<double>(cell_size)));
+        double num_rows = std::max(0.0, std::floor((high.y - low.y) / static_cast<double>(cell_size)));
+        if (num_cols * num_rows <= MAX_CELLS) {
+            cols = static_cast<int>(num_cols);
+            rows = static_cast<int>(num_rows);
+            break;
+        }
+        cell_size *= 2;
+    }
+
+    // every point of a cell is within half a diagonal of its center, so a cell is free
+    // if its center is outside of every tree grown by that much; each tree marks the
+    // centers it covers, so only the cells around trees are ever tested
+    float grow = clearance + cell_size * std::sqrt(2.0f) / 2;
+    blocked.assign(static_cast<size_t>(cols) * rows, 0);
+    for (GLuint i = 0; i < trees.size(); ++i) {
+        vec2 tree = trees.get_position(i);
+        float radius = trees.get_radius(i) + grow;
+        if (radius <= 0 || cols == 0 || rows == 0) {
+            continue;  // shrunk away, or there are no cells to cover
+        }
+
+        // a cell or so of slack on each side, since the test below decides
+        vec2 near = (tree - vec2(radius) - origin) / cell_size - vec2(1);
+        vec2 far = (tree + vec2(radius) - origin) / cell_size + vec2(1);
+        int min_col = static_cast<int>(std::max(std::floor(near.x), 0.0f));
+        int min_row = static_cast<int>(std::max(std::floor(near.y), 0.0f));
+        int max_col = static_cast<int>(std::min(std::ceil(far.x), cols - 1.0f));
+        int max_row = static_cast<int>(std::min(std::ceil(far.y), rows - 1.0f));
+        for (int row = min_row; row <= max_row; ++row) {
+            for (int col = min_col; col <= max_col; ++col) {
+                vec2 center = origin + cell_size * vec2(col + 0.5, row + 0.5);
+                if (length(center - tree) < radius) {
+                    blocked[row * cols + col] = 1;
+                }
+            }
+        }
+    }
+
+    free_before.resize(static_cast<size_t>(cols + 1) * rows);
+    free_rows_before.resize(static_cast<size_t>(rows) + 1);
+    num_free = 0;
+    for (int row = 0; row < rows; ++row) {
+        GLuint* counts = &free_before[row * (cols + 1)];
+        const unsigned char* row_blocked = &blocked[row * cols];
+        counts[0] = 0;
+        for (int col = 0; col < cols; ++col) {
+            counts[col + 1] = counts[col] + (row_blocked[col] ? 0 : 1);
+        }
+        free_rows_before[row] = num_free;
+        num_free += counts[cols];
+    }
+    free_rows_before[rows] = num_free;
+}
+
+//******************************************************************
+//
+//  Function:   FreeSpace::sample
+//
+//  Purpose:    picks a random point in a random free cell
+//
+//  Parameters: random, pos
+//
+//  Member/Global Variables: cols, rows
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns false if there are no free cells, otherwise
+//                   pos will be set to a traversable point, every free
+//                   cell being equally likely
+//
+//  Calls:      sample_in
+//
+//******************************************************************
+bool FreeSpace::sample(RandomStream& random, vec2& pos) const {
+    return sample_in(random, 0, 0, cols - 1, rows - 1, pos);
+}
+
+//******************************************************************
+//
+//  Function:   FreeSpace::sample_near
+//
+//  Purpose:    picks a random point in a random free cell near center
+//
+//  Parameters: random, center, range, pos
+//
+//  Member/Global Variables: origin, cell_size, cols, rows
+//
+//  Pre Conditions:  range must not be negative
+//
+//  Post Conditions: returns false if no free cell overlaps the square of
+//                   half width range around center, otherwise pos will
+//                   be set to a traversable point in one of them (which
+//                   may be just outside the square), every one of them
+//                   being equally likely
+//
+//  Calls:      sample_in, std::floor, std::min, std::max
+//
+//******************************************************************
+bool FreeSpace::sample_near(RandomStream& random, const vec2& center, float range, vec2& pos) const {
+    vec2 low = (center - vec2(range) - origin) / cell_size;
+    vec2 high = (center + vec2(range) - origin) / cell_size;
+    if (!(high.x >= 0 && high.y >= 0 && low.x < cols && low.y < rows)) {  // also catches NaN
+        return false;
+    }
+
+    int min_col = std::max(static_cast<int>(std::floor(low.x)), 0);
+    int min_row = std::max(static_cast<int>(std::floor(low.y)), 0);
+    int max_col = std::min(static_cast<int>(std::floor(high.x)), cols - 1);
+    int max_row = std::min(static_cast<int>(std::floor(high.y)), rows - 1);
+    return sample_in(random, min_col, min_row, max_col, max_row, pos);
+}
+
+//******************************************************************
+//
+//  Function:   FreeSpace::sample_in
+//
+//  Purpose:    picks a random point in a random free cell of the given
+//              box of cells
+//
+//  Parameters: random, min_col, min_row, max_col, max_row, pos
+//
+//  Member/Global Variables: origin, cell_size, cols, free_before,
+//                           free_rows_before
+//
+//  Pre Conditions:  the box must be inside the cells (an empty box is
+//                   allowed)
+//
+//  Post Conditions: returns false if the box has no free cells,
+//                   otherwise pos will be set to a point in one of them
+//                   (found in time logarithmic in the number of cells
+//                   if the box spans every column, otherwise linear in
+//                   its rows)
+//
+//  Calls:      RandomStream::fill, std::upper_bound, std::min
+//
+//******************************************************************
+bool FreeSpace::sample_in(RandomStream& random, int min_col, int min_row, int max_col, int max_row,
+                          vec2& pos) const {
+    if (min_col > max_col || min_row > max_row) {
+        return false;
+    }
+
+    // count the free cells in the box (whole rows are counted already), a row at a time
+    bool whole_rows = min_col == 0 && max_col == cols - 1;
+    GLuint total = 0;
+    if (whole_rows) {
+        total = free_rows_before[max_row + 1] - free_rows_before[min_row];
+    } else {
+        for (int row = min_row; row <= max_row; ++row) {
+            const GLuint* counts = &free_before[row * (cols + 1)];
+            total += counts[max_col + 1] - counts[min_col];
+        }
+    }
+    if (total == 0) {
+        return false;
+    }
+
+    // pick one of them, then find the row and column it's in
+    float draws[3];  // which cell, then where in it
+    random.fill(draws, 3);
+    GLuint pick = std::min(static_cast<GLuint>(draws[0] * total), total - 1);
+    int row = min_row;
+    if (whole_rows) {
+        // the last row whose running count doesn't pass the pick is the picked cell's
+        GLuint target = free_rows_before[min_row] + pick;
+        row = std::upper_bound(free_rows_before.begin() + min_row, free_rows_before.begin() + max_row + 2, target)
+            - free_rows_before.begin() - 1;
+        pick = target - free_rows_before[row];
+    }
+    const GLuint* counts = &free_before[row * (cols + 1)];
+    while (pick >= counts[max_col + 1] - counts[min_col]) {
+        pick -= counts[max_col + 1] - counts[min_col];
+        row++;
+        counts = &free_before[row * (cols + 1)];
+    }
+    // the first column whose running count passes the pick is the one past the picked cell
+    int col = std::upper_bound(counts + min_col, counts + max_col + 2, counts[min_col] + pick) - counts - 1;
+
+    pos = origin + cell_size * vec2(col + draws[1], row + draws[2]);
+    return true;
+}
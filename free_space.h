@@ -0,0 +1,101 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        free_space.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides the set of small cells of a map
+//                 that no tree overlaps, so that random positions units
+//                 can stand on are picked directly instead of by
+//                 guessing until one happens to be traversable.
+//
+//    Date:        10/11/2019
+//
+//*******************************************************************
+
+#ifndef FREE_SPACE_H
+#define FREE_SPACE_H
+
+// C/C++ Standard libraries
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "circle_store.h"
+#include "random_stream.h"
+
+//******************************************************************
+//
+//  Class: FreeSpace
+//
+//  Purpose:  To cut the world into square cells and remember which of
+//            them are entirely outside of every tree (inflated by a
+//            clearance), so that any point of a free cell is traversable.
+//            Each row keeps a running count of its free cells, so a free
+//            cell can be picked uniformly from any box of cells by
+//            counting rather than by trying cells until one is free, and
+//            the rows keep a running count of their own, so a box as
+//            wide as the cells finds its row by a binary search. A box
+//            too big for MAX_CELLS cells of the given size is cut into
+//            bigger ones, so memory stays bounded on any map.
+//
+//  Functions:
+//           Constructors
+//             FreeSpace() creates an empty set with no free cells
+//           getters
+//             get_num_free to return the number of free cells
+//           mutators
+//             build(trees, clearance, low, high,
+//                   size)  finds the free cells of the given size inside
+//                          the box from low to high, for trees inflated
+//                          by clearance
+//           helpers
+//             sample(random, pos) sets pos to a random point in a random free
+//                                 cell, drawing from random
+//             sample_near(random, center,
+//                         range, pos)  sets pos to a random point in a random
+//                                      free cell overlapping the square of
+//                                      half width range around center
+//           private helpers
+//             sample_in(random, min_col, min_row,
+//                       max_col, max_row, pos)  sets pos to a random point in
+//                                               a random free cell of the
+//                                               given box
+//
+//******************************************************************
+
+class FreeSpace {
+ public:
+    FreeSpace() : origin(vec2()), cell_size(1), cols(0), rows(0), num_free(0) {}
+
+    // getters
+    GLuint get_num_free() const;
+
+    // mutators
+    void build(const CircleStore& trees, float clearance, const vec2& low, const vec2& high, float size);
+
+    // helpers
+    bool sample(RandomStream& random, vec2& pos) const;
+    bool sample_near(RandomStream& random, const vec2& center, float range, vec2& pos) const;
+ private:
+    vec2 origin;  // world position of the bottom left corner of the cells
+    float cell_size;  // width and height of a cell
+    int cols;  // number of columns of cells
+    int rows;  // number of rows of cells
+    GLuint num_free;  // number of free cells
+    static const GLuint MAX_CELLS = 1 << 22;  // most cells the set may have, whatever the size of its box
+
+    // number of free cells in each row before each column ((cols + 1) entries per row)
+    std::vector<GLuint> free_before;
+    std::vector<GLuint> free_rows_before;  // number of free cells in the rows before each row (rows + 1 entries)
+    std::vector<unsigned char> blocked;  // whether each cell is covered by a tree, only used while building (kept to reuse memory)
+
+    // private helpers
+    bool sample_in(RandomStream& random, int min_col, int min_row, int max_col, int max_row, vec2& pos) const;
+};
+
+#endif
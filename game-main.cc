@@ -9,6 +9,8 @@
 //    Description: This main file handles setting up the opengl context for
 //                 the food drop game, along with the game object and window.
 //                 It also sets up window, keyboard, and mouse callbacks.
+//                 The game is set up from a scenario given with --key=value
+//                 options (and --config=file), see scenario.h.
 //
 //    Date:        10/6/2019
 //
@@ -16,31 +18,32 @@
 
 // C/C++ Standard libraries
 #include <cstdlib>
+#include <ctime>
 #include <iostream>
+#include <vector>
 
 // Source libraries
 #include "game.h"
+#include "scenario.h"
 
 // Shader constants
 constexpr char const* VERTEX_SHADER_FILE = "vshader2d.glsl";
 constexpr char const* FRAGMENT_SHADER_FILE = "fshader2d.glsl";
 
 // Window constants
-const unsigned int INIT_WINDOW_WIDTH = 1200;  // window width in pixels
-const unsigned int INIT_WINDOW_HEIGHT = 600;  // window height in pixels
 constexpr char const* WINDOW_TITLE = "Food Drop Game | Loading...";  // window title
 
-// Game Options
-const unsigned int NUM_BAD_GUYS = 6;  // number of bad guys to create
-const unsigned int NUM_GOOD_GUYS = 10;  // number of good guys to create
-const unsigned int NUM_TREES = 40;  // number of trees to create
-const unsigned int MAX_DROPS = 8;  // number of food drops to allow the user to have
-
 // Global variables
 // Note: I normally wouldn't use global variables, but it seems like you can't pass any arguments to the display callback
 Game* game;  // Pointer to game object, will be created dynamically
 vec2 window_size;  // Variable that holds window size
 GLuint shader_id;  // Variable that holds opengl shader id
+Renderer renderer;  // Renderer shared by every game that is created
+MapFile map_file;  // Saved map the game is played on, if the scenario names one
+InputRecorder recorder;  // Log the game's inputs are recorded to, if the scenario names one
+PhaseTimers phase_timers;  // How long the game's updates, draws, and clicks have taken
+TraceRecorder trace_recorder;  // Trace the game's frames are written to, if the scenario names one (finished when it's destroyed at exit)
+WorkCounters work_counters;  // Work the game does, written to a file if the scenario names one (finished when it's destroyed at exit)
 
 //******************************************************************
 //
@@ -68,6 +71,50 @@ GLuint init_shader() {
     return program;
 }
 
+//******************************************************************
+//
+//  Function:   print_timings
+//
+//  Purpose:    prints how long each phase of the game has taken
+//
+//  Parameters: none
+//
+//  Member/Global Variables: phase_timers
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the timings of every phase will have been printed to
+//                   standard output
+//
+//  Calls:      PhaseTimers::dump
+//
+//******************************************************************
+void print_timings() {
+    phase_timers.dump(std::cout);
+}
+
+//******************************************************************
+//
+//  Function:   end_recording
+//
+//  Purpose:    finishes the input log with the state the game ended in
+//
+//  Parameters: none
+//
+//  Member/Global Variables: game
+//
+//  Pre Conditions:  game must point to a valid, initialized game object
+//
+//  Post Conditions: if the game is being recorded, the log will end
+//                   with a checkpoint at the last tick run
+//
+//  Calls:      Game::end_recording
+//
+//******************************************************************
+void end_recording() {
+    game->end_recording();
+}
+
 //******************************************************************
 //
 //  Function:   display
@@ -104,9 +151,9 @@ void display() {
 //
 //  Pre Conditions:  game must point to a valid, initialized game object
 //
-//  Post Conditions: the game state will be updated according to the
-//                   calculated delta time and a frame redraw will
-//                   scheduled
+//  Post Conditions: the game will have run the fixed-size updates that
+//                   fit in the calculated delta time and a frame redraw
+//                   will be scheduled
 //
 //  Calls:      glutGet, game::update, glutPostRedisplay
 //
@@ -154,30 +201,40 @@ void reshape(int width, int height) {
 //  Function:   keyboard_func
 //
 //  Purpose:    keyboard callback that handles resetting the game
-//              when the 'r' key is pressed
+//              when the 'r' key is pressed, saving it when the 's'
+//              key is pressed, going back to what was saved when the
+//              'l' key is pressed, and printing timings when the 't'
+//              key is pressed
 //
 //  Parameters: key, x, y
 //
-//  Member/Global Variables: game, window_size, NUM_BAD_GUYS, NUM_GOOD_GUYS,
-//                           NUM_TREES, MAX_DROPS, shader_id
+//  Member/Global Variables: game
 //
-//  Pre Conditions:  all of the above game constants must have valid values,
-//                   shader_id must refer to a valid, active opengl shader
-//                   program, and window_size must have a valid value
+//  Pre Conditions:  game must have been created and initialized
 //
-//  Post Conditions: if the r key is pressed, the game will be reinitialized
+//  Post Conditions: if the r key is pressed, the game will be reset; if
+//                   the s key is pressed, the game will be saved; if the
+//                   l key is pressed, the game will go back to the last
+//                   save; if the t key is pressed, the timings so far
+//                   will have been printed
 //
-//  Calls:      game::update_window_size, game::init, glutPostRedisplay
+//  Calls:      Game::reset, Game::quick_save, Game::quick_load,
+//              glutPostRedisplay, print_timings
 //
 //******************************************************************
 void keyboard_func(unsigned char key, int x, int y) {
     if (key == 'r') {
-        delete game;
-        game = new Game(NUM_BAD_GUYS, NUM_GOOD_GUYS, NUM_TREES, MAX_DROPS, shader_id);
-        game->set_window_size(window_size);
-        game->init();
+        game->reset();  // new map, without freeing and reallocating every object
+
+        glutPostRedisplay();
+    } else if (key == 's') {
+        game->quick_save();
+    } else if (key == 'l') {
+        game->quick_load();
 
         glutPostRedisplay();
+    } else if (key == 't') {
+        print_timings();
     }
 }
 
@@ -213,32 +270,65 @@ void mouse_func(int button, int state, int x, int y) {
 //  Purpose:    main function that handles initializing glut and glew, creates
 //              a window, sets up callbacks, and creates the game obejct
 //
-//  Parameters: argc, argv
+//  Parameters: argc, argv (glut options, then scenario options)
 //
-//  Member/Global Variables: game, window_size, NUM_BAD_GUYS, NUM_GOOD_GUYS,
-//                           NUM_TREES, MAX_DROPS, INIT_WINDOW_WIDTH,
-//                           INIT_WINDOW_HEIGHT
-//                           
+//  Member/Global Variables: game, window_size, shader_id, renderer,
+//                           map_file, recorder, phase_timers,
+//                           trace_recorder, work_counters
 //
-//  Pre Conditions:  all of the above constants must have valid values
+//  Pre Conditions:  none
 //
 //  Post Conditions: the opengl context and window will be created and
-//                   active, along with the shader and game object
-//
-//  Calls:      glutInit, glutInitDisplayMode, glutInitWindowPosition,
+//                   active, along with the shader and game object;
+//                   exits with failure if an option isn't valid, the
+//                   scenario's map can't be opened, or its input log,
+//                   trace, or counters can't be written
+//
+//  Calls:      glutInit, default_scenario, std::time,
+//              parse_scenario_args, MapFile::open, InputRecorder::open,
+//              TraceRecorder::open, WorkCounters::open,
+//              game::set_trace_recorder, game::set_work_counters,
+//              glutInitDisplayMode, glutInitWindowPosition,
 //              glutCreateWindow, glutDisplayFunc, glutReshapeFunc,
 //              glutKeyboardFunc, glutMouseFunc, glutIdleFunc, glewInit,
-//              init_shader, game::update_window_size, game::init,
+//              init_shader, Renderer::init, game::update_window_size,
+//              game::set_map, game::set_recorder,
+//              game::set_phase_timers, std::atexit, game::init,
 //              glutMainLoop
 //
 //******************************************************************
 
 int main(int argc, char** argv) {
-    // Standard GLUT initialization
+    // Standard GLUT initialization (glut takes its own options out of argv)
     glutInit(&argc, argv);
+
+    // set up the game from the options left
+    Scenario scenario = default_scenario();
+    scenario.seed = std::time(nullptr);  // a different map every time the game is started, unless given a seed
+    std::vector<char*> rest;
+    if (!parse_scenario_args(scenario, argc, argv, rest)) {
+        return EXIT_FAILURE;
+    }
+    if (!rest.empty()) {
+        std::cerr << "Unexpected argument " << rest[0] << ", options are --key=value or --config=file.\n";
+        return EXIT_FAILURE;
+    }
+    if (!scenario.map.empty() && !map_file.open(scenario.map)) {
+        return EXIT_FAILURE;
+    }
+    if (!scenario.record.empty() && !recorder.open(scenario.record, scenario, 1 / scenario.tick_rate)) {
+        return EXIT_FAILURE;
+    }
+    if (!scenario.trace.empty() && !trace_recorder.open(scenario.trace)) {
+        return EXIT_FAILURE;
+    }
+    if (!scenario.counters.empty() && !work_counters.open(scenario.counters)) {
+        return EXIT_FAILURE;
+    }
+
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA | GLUT_MULTISAMPLE);  // use double buffering, RGBA, and multisampling
-    glutInitWindowSize(INIT_WINDOW_WIDTH, INIT_WINDOW_HEIGHT);
-    window_size = vec2(INIT_WINDOW_WIDTH, INIT_WINDOW_HEIGHT);
+    glutInitWindowSize(scenario.window_size.x, scenario.window_size.y);
+    window_size = scenario.window_size;
     glutInitWindowPosition(0, 0);  // place window top left on display
     glutCreateWindow(WINDOW_TITLE);
 
@@ -251,10 +341,26 @@ int main(int argc, char** argv) {
     glewInit();  // initialize glew
 
     shader_id = init_shader();
+    renderer.init(shader_id);  // create the opengl data used to draw the game
 
     // initialize our game object
-    game = new Game(NUM_BAD_GUYS, NUM_GOOD_GUYS, NUM_TREES, MAX_DROPS, shader_id);  // create game with parameters
+    game = new Game(scenario, &renderer);  // create game with parameters
     game->set_window_size(window_size);
+    if (map_file.is_open()) {
+        game->set_map(&map_file);
+    }
+    if (recorder.is_open()) {
+        game->set_recorder(&recorder);
+    }
+    game->set_phase_timers(&phase_timers);
+    if (trace_recorder.is_open()) {
+        game->set_trace_recorder(&trace_recorder);
+    }
+    if (work_counters.is_open()) {
+        game->set_work_counters(&work_counters);
+    }
+    std::atexit(print_timings);  // glut exits from inside its loop when the window is closed
+    std::atexit(end_recording);  // so the log ends on the last tick run, not the last input
     game->init();  // initialize our game object (including opengl elements it uses)
 
     glutMainLoop();  // enter event loop
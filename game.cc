@@ -6,743 +6,602 @@
 //    Author:      Kirk Saunders
 //    Email:       ks825016@ohio.edu
 //
-//    Description: This class provides a data structure to store game
-//                 state and provides helper functions for updating
-//                 state based on delta time and handling mouse events.
+//    Description: This class connects the game simulation to OpenGL.
+//                 It draws the simulated world and translates mouse
+//                 events into simulation actions.
 //
 //    Date:        10/8/2019
 //
 //*******************************************************************
 
 // C/C++ Standard libraries
-#include <cmath>
-#include <cstdlib>
+#include <algorithm>
 #include <iomanip>
-#include <iostream>
 #include <sstream>
 
 // Source libraries
 #include "game.h"
-#include "utilities.h"
 
 //******************************************************************
 //
-//  Function:   Game::~Game
+//  Function:   Game::set_window_size
 //
-//  Purpose:    handles deallocating all dynamic memory for the game
-//              class upon destruction
+//  Purpose:    sets the window size variable of the game class
 //
-//  Parameters: none
+//  Parameters: size
 //
-//  Member/Global Variables: plane, food_drops, good_guys, bad_guys,
-//                           trees
+//  Member/Global Variables: window_size, world_follows_window, sim
 //
-//  Pre Conditions:  all of the above variables must be valid vectors,
-//                   and all of them must contain valid pointers to
-//                   valid memory locations
+//  Pre Conditions:  size must have a valid value
 //
-//  Post Conditions: all of the game's objects will have been cleared
-//                   and memory cleaned up
+//  Post Conditions: window_size will equal size, and the simulated
+//                   world will be resized to match if it follows the
+//                   window (otherwise the whole world is drawn scaled
+//                   to fit the window)
 //
-//  Calls:      none
+//  Calls:      handle_input, make_input
 //
 //******************************************************************
-Game::~Game() {
-    // delete plane
-    if (plane != nullptr) {
-        delete plane;
-    }
-
-    // delete food drops
-    for (GLuint i = 0; i < food_drops.size(); ++i) {
-        delete food_drops[i];
-    }
-
-    // delete good guys
-    for (GLuint i = 0; i < good_guys.size(); ++i) {
-        delete good_guys[i];
-    }
-
-    // delete bad guys
-    for (GLuint i = 0; i < bad_guys.size(); ++i) {
-        delete bad_guys[i];
-    }
-
-    // delete trees
-    for (GLuint i = 0; i < trees.size(); ++i) {
-        delete trees[i];
+void Game::set_window_size(const vec2& size) {
+    window_size = size;
+    if (world_follows_window) {
+        handle_input(make_input(INPUT_WORLD_SIZE, 0, size));
     }
 }
 
 //******************************************************************
 //
-//  Function:   Game::set_window_size
+//  Function:   Game::set_tick_rate
 //
-//  Purpose:    sets the window size variable of the game class
+//  Purpose:    sets how many times per second the simulation updates
 //
-//  Parameters: size
+//  Parameters: rate
 //
-//  Member/Global Variables: window_size
+//  Member/Global Variables: tick_time
 //
-//  Pre Conditions:  size must have a valid value
+//  Pre Conditions:  rate must be greater than 0
 //
-//  Post Conditions: window_size will equal size
+//  Post Conditions: every simulation update will step 1 / rate seconds
 //
 //  Calls:      none
 //
 //******************************************************************
-void Game::set_window_size(const vec2& size) {
-    window_size = size;
+void Game::set_tick_rate(float rate) {
+    tick_time = 1 / rate;
 }
 
 //******************************************************************
 //
-//  Function:   Game::update
+//  Function:   Game::set_seed
 //
-//  Purpose:    to update all of the game objets and state based on given
-//              delta time
+//  Purpose:    sets the seed the game's maps are made from
 //
-//  Parameters: dt
+//  Parameters: seed
 //
-//  Member/Global Variables: good_guys, drops_left, food_drops, plane_visible,
-//                           score, FOOD_PER_DROP
+//  Member/Global Variables: sim
 //
-//  Pre Conditions:  all of the above variables must have valid values
+//  Pre Conditions:  none
 //
-//  Post Conditions: the game state will have been updated based on dt
+//  Post Conditions: the next map (and every one after it) will be the
+//                   same as in any other game with the same seed
 //
-//  Calls:      update_plane, update_food, update_bad_guys, update_good_guys
+//  Calls:      Simulation::set_seed
 //
 //******************************************************************
-void Game::update(float dt) {
-    // check if game ended
-    if (good_guys.size() == 0 || (drops_left == 0 && food_drops.size() == 0 && !plane_visible)) {
-        // check if player gets extra points
-        if (drops_left > 0) {
-            score += drops_left * FOOD_PER_DROP;  // give left over drops to player as points
-            drops_left = 0;
-        }
-
-        return;
-    }
-
-    // call individual update functions
-    update_plane(dt);
-    update_food(dt);
-    update_bad_guys(dt);
-    update_good_guys(dt);
+void Game::set_seed(uint64_t seed) {
+    sim.set_seed(seed);
 }
 
 //******************************************************************
 //
-//  Function:   Game::init
+//  Function:   Game::set_map
 //
-//  Purpose:    initialized all of the game objects and data
+//  Purpose:    sets a saved map for every game to be played on
 //
-//  Parameters: none
+//  Parameters: file
 //
-//  Member/Global Variables: plane, num_trees, trees, num_bad_guys, bad_guys,
-//                           num_good_guys, good_guys, window_size_loc,
-//                           shader_id, BACKGROUND_COLOR, PLANE_SPEED, PLANE_COLOR,
-//                           PLANE_SIZE, TREE_MIN_SIZE, TREE_MAX_SIZE, TREE_COLOR,
-//                           window_size, BAD_SPEED, BAD_BOOST_FACTOR,
-//                           BAD_COLOR, BAD_SIZE, GOOD_MAX_FOOD, GOOD_SPPED,
-//                           GOOD_BOOST_FACTOR, GOOD_COLOR, GOOD_SIZE
+//  Member/Global Variables: map, world_follows_window
 //
-//  Pre Conditions:  all of the above variables must have valid values
+//  Pre Conditions:  file must be open, and stay open while the game is
+//                   (or be null)
 //
-//  Post Conditions: all of the game objects will have been created according
-//                   to the game constants
+//  Post Conditions: the next init (and every one after it) will load
+//                   the map, keeping the world the size it was saved
+//                   with, or make new maps again if file is null
 //
-//  Calls:      glClearColor, generate_random, glGetUniformLocation,
-//              exit, Unit::set_color, Unit::set_size, Unit::set_position,
-//              Unit::set_rotation, Unit::init, Circle::set_color, Circle::set_position,
-//              Circle::init, is_traversable
+//  Calls:      none
 //
 //******************************************************************
-void Game::init() {
-    glClearColor(BACKGROUND_COLOR.x, BACKGROUND_COLOR.y, BACKGROUND_COLOR.z, 1.0);  // set background color
-
-    // create drop plane
-    plane = new Unit(0, PLANE_SPEED, 1);
-    plane->set_color(PLANE_COLOR);
-    plane->set_size(vec2(PLANE_SIZE, PLANE_SIZE));
-    plane->init(shader_id);
-
-    for (GLuint i = 0; i < num_trees; ++i) {
-        Circle* c = new Circle(TREE_MIN_SIZE + (TREE_MAX_SIZE - TREE_MIN_SIZE) * generate_random(), 0, 0);
-        c->set_color(TREE_COLOR);
-        c->set_position(window_size * vec2((generate_random() - 0.5), (generate_random() - 0.5)));
-        c->init(shader_id);
-
-        trees.push_back(c);
-    }
-
-    for (GLuint i = 0; i < num_bad_guys; ++i) {
-        Unit* u = new Unit(0, BAD_SPEED, BAD_BOOST_FACTOR);
-        u->set_color(BAD_COLOR);
-        u->set_size(vec2(BAD_SIZE, BAD_SIZE));
-
-        vec2 pos;
-        do {
-            pos = window_size * vec2((generate_random() - 0.5), (generate_random() - 0.5));
-        } while(!is_traversable(pos));
-
-        u->set_position(pos);
-        u->set_rotation(generate_random() * 2 * E_PI);
-        u->init(shader_id);
-
-        bad_guys.push_back(u);
-    }
-
-    for (GLuint i = 0; i < num_good_guys; ++i) {
-        Unit* u = new Unit(GOOD_MAX_FOOD, GOOD_SPEED, GOOD_BOOST_FACTOR);
-        u->set_color(GOOD_COLOR);
-        u->set_size(vec2(GOOD_SIZE, GOOD_SIZE));
-
-        vec2 pos;
-        do {
-            pos = window_size * vec2((generate_random() - 0.5), (generate_random() - 0.5));
-        } while(!is_traversable(pos));
-
-        u->set_position(pos);
-        u->set_rotation(generate_random() * 2 * E_PI);
-        u->init(shader_id);
-
-        good_guys.push_back(u);
-    }
-
-    window_size_loc = glGetUniformLocation(shader_id, "windowSize");  // set window_size_loc to the location of the "windowSize" variable in our shader
-    if (window_size_loc == -1) {
-        // error if window_size_loc wasn't found
-        std::cerr << "Unable to find window_size_loc in shader.\n";
-        exit(EXIT_FAILURE);
+void Game::set_map(const MapFile* file) {
+    map = file;
+    if (map != nullptr) {
+        world_follows_window = false;
     }
 }
 
 //******************************************************************
 //
-//  Function:   Game::handle_click
+//  Function:   Game::set_recorder
 //
-//  Purpose:    to handle a user mouse click event
+//  Purpose:    sets where the inputs the game is given are recorded
 //
-//  Parameters: pos
+//  Parameters: rec
 //
-//  Member/Global Variables: BACKGROUND_COLOR, window_size, trees, food_drops,
-//                           good_guys, bad_guys, drops_left, plane_visible,
-//                           dropping_food, plane, SPEED_BOOST_DURATION
+//  Member/Global Variables: recorder
 //
-//  Pre Conditions:  all of the above variables must have valid values, and
-//                   an opengl context must be valid and active
+//  Pre Conditions:  rec must stay valid while the game is (or be null),
+//                   and must have been opened with the game's scenario
+//                   before init is called
 //
-//  Post Conditions: the game object will have handled a user click at pos
+//  Post Conditions: every input from now on will be recorded to rec,
+//                   along with a hash of the game's state every
+//                   CHECKPOINT_TICKS ticks, or nothing is recorded if
+//                   rec is null
 //
-//  Calls:      glClearColor, glClear, glReadBuffer, display, glFlush, glReadPixels,
-//              Object::is_select_color, Unit::give_boost, is_traversable,
-//              Unit::set_position, Unit::set_target_pos, generate_random
+//  Calls:      none
 //
 //******************************************************************
-void Game::handle_click(const vec2& pos) {
-    glClearColor(1.0, 1.0, 1.0, 1.0);  // white clear color
-    glClear(GL_COLOR_BUFFER_BIT);  // clear color buffer
-    glReadBuffer(GL_BACK);  // read from back buffer
-
-    display(true);  // draw our objects with selection rendering
-    glFlush();  // ensure our objects are done drawing
-    glClearColor(BACKGROUND_COLOR.x, BACKGROUND_COLOR.y, BACKGROUND_COLOR.z, 1.0);  // restore background color to original
-
-    unsigned char pixel_color[3];  // our color data
-    glReadPixels(pos.x, window_size.y - pos.y, 1, 1, GL_RGB, GL_UNSIGNED_BYTE, &pixel_color);  // read color
-
-    Object* clicked = nullptr;
-    for (unsigned int i = 0; i < trees.size(); ++i) {
-        if (trees[i]->is_select_color(pixel_color)) {
-            // user clicked this tree, will block drop from happening
-            clicked = trees[i];
-            break;  // no need to check other trees, we found the one that was clicked
-        }
-    }
-
-    if (clicked == nullptr) {
-        for (unsigned int i = 0; i < food_drops.size(); ++i) {
-            if (food_drops[i]->is_select_color(pixel_color)) {
-                // user clicked this food_drop, will block drop from happening (can't drop on top of a drop)
-                clicked = food_drops[i];
-                break;  // no need to check other food_drops, we found the one that was clicked
-            }
-        }
-    }
-
-    if (clicked == nullptr) {
-        for (unsigned int i = 0; i < good_guys.size(); ++i) {
-            if (good_guys[i]->is_select_color(pixel_color)) {
-                // user clicked this good guy, make it zoom!
-                good_guys[i]->give_boost(SPEED_BOOST_DURATION);  // give boost
-                clicked = good_guys[i];
-                break;  // no need to check other guys, we found the one that was clicked
-            }
-        }
-    }
-
-    if (clicked == nullptr) {
-        for (unsigned int i = 0; i < bad_guys.size(); ++i) {
-            if (bad_guys[i]->is_select_color(pixel_color)) {
-                // user clicked this bad guy, make it slow
-                bad_guys[i]->give_boost(SPEED_BOOST_DURATION);  // give boost (it's boost factor is less than one, so it slows down)
-                clicked = bad_guys[i];
-                break;  // no need to check other guys, we found the one that was clicked
-            }
-        }
-    }
-
-
-    if (clicked == nullptr && drops_left > 0) {  // if our mouse click wasn't blocked and we have drops left, do one
-        if (!plane_visible) {  // ensure plane isn't already doing a drop          
-            vec2 scaled_pos = vec2(pos.x, window_size.y - pos.y) - window_size / 2;  // mouse position scaled into world coordinates
-            if (!is_traversable(scaled_pos)) {  // one last check to make sure the clicked position is traversable
-                return;
-            }
-
-            // schedule a food drop
-            plane_visible = true;
-            dropping_food = true;
-            // set plane to random position off screen and make it target drop position
-            plane->set_position(vec2(-window_size.x / 2 - PLANE_SIZE, window_size.y * (generate_random() - 0.5)));
-            plane->set_target_pos(scaled_pos);
-
-            drops_left--;  // we used one drop, so decrement
-        }
-    }
+void Game::set_recorder(InputRecorder* rec) {
+    recorder = rec;
 }
 
 //******************************************************************
 //
-//  Function:   Game::display
+//  Function:   Game::set_phase_timers
 //
-//  Purpose:    to draw the game state
+//  Purpose:    sets where the game's updates, draws, and clicks are
+//              timed
 //
-//  Parameters: selection_draw
+//  Parameters: t
 //
-//  Member/Global Variables: window_size_loc, window_size, trees, food_drops,
-//                           good_guys, bad_guys, plane_visible, plane
+//  Member/Global Variables: timers, sim
 //
-//  Pre Conditions:  all of the above variables must have valid values, and
-//                   an opengl context must be valid and active
+//  Pre Conditions:  t must stay valid while the game is (or be null)
 //
-//  Post Conditions: all of the game objects will have been drawn to the
-//                   frame buffer
+//  Post Conditions: every simulation update and its phases, frame drawn,
+//                   and click handled from now on will be timed in t,
+//                   or nothing is timed if t is null
 //
-//  Calls:      glUniform2f, Circle::display, Unit::display, update_window_title
+//  Calls:      Simulation::set_phase_timers
 //
 //******************************************************************
-void Game::display(bool selection_draw) {
-    glUniform2f(window_size_loc, window_size.x, window_size.y);  // send window size to shader
-
-    // draw trees
-    for (GLuint i = 0; i < trees.size(); ++i) {
-        trees[i]->display(selection_draw);
-    }
-
-    // draw food drops
-    for (GLuint i = 0; i < food_drops.size(); ++i) {
-        food_drops[i]->display(selection_draw);
-    }
-
-    // draw good guys
-    for (GLuint i = 0; i < good_guys.size(); ++i) {
-        good_guys[i]->display(selection_draw);
-    }
-
-    // draw bad guys
-    for (GLuint i = 0; i < bad_guys.size(); ++i) {
-        bad_guys[i]->display(selection_draw);
-    }
-
-    // draw plane if it should be visible
-    if (plane_visible) {
-        plane->display(selection_draw);
-    }
-
-    update_window_title();
+void Game::set_phase_timers(PhaseTimers* t) {
+    timers = t;
+    sim.set_phase_timers(t);
 }
 
 //******************************************************************
 //
-//  Function:   Game::display
+//  Function:   Game::set_trace_recorder
 //
-//  Purpose:    to update all of the game objects and state based on given
-//              delta time
+//  Purpose:    sets where the game's frames, updates, draws, and clicks
+//              are traced
 //
-//  Parameters: dt
+//  Parameters: t
 //
-//  Member/Global Variables: good_guys, drops_left, food_drops, plane_visible,
-//                           score, FOOD_PER_DROP
+//  Member/Global Variables: trace, sim
 //
-//  Pre Conditions:  all of the above variables must have valid values
+//  Pre Conditions:  t must stay valid while the game is (or be null)
 //
-//  Post Conditions: the game state will have been updated based on dt
+//  Post Conditions: every frame from now on will be traced in t while
+//                   it's open, down to the simulation's phases, draw
+//                   passes, and food and units coming and going, and
+//                   written out once the frame's updates are done
 //
-//  Calls:      update_plane, update_food, update_bad_guys, update_good_guys
+//  Calls:      Simulation::set_trace_recorder
 //
 //******************************************************************
-void Game::target_food(Unit* unit, Circle* food, float range) {
-    if (can_reach(unit->get_position(), food->get_position(), range)) {
-        // see if unit has a target already or not
-        if (unit->get_target_food() == nullptr) {
-            unit->set_target_food(food);  // target food
-        } else if (unit->get_target_food() != nullptr && unit->get_target_food() != food) {
-            // unit already has a target, but see if this food is closer
-            float new_length = length(food->get_position() - unit->get_position());
-            float old_length = length(unit->get_target_food()->get_position() - unit->get_position());
-            if (new_length < old_length) {
-                unit->set_target_food(food);  // target food
-            }
-        }
-    }
+void Game::set_trace_recorder(TraceRecorder* t) {
+    trace = t;
+    sim.set_trace_recorder(t);
 }
 
 //******************************************************************
 //
-//  Function:   Game::update_food
+//  Function:   Game::set_work_counters
 //
-//  Purpose:    to update all of the food drops based on given delta time
+//  Purpose:    sets where the work the game's updates and draws do is
+//              counted
 //
-//  Parameters: dt
+//  Parameters: c
 //
-//  Member/Global Variables: food_drop, bad_guys, good_guys, BAD_RANGE
-//                           BAD_FOOD_RATE, GOOD_RANGE, GOOD_FOOD_RATE
-//
-//  Pre Conditions:  all of the above variables must have valid values
-//
-//  Post Conditions: the food drops in the game will have been updated based
-//                   on dt
-//
-//  Calls:      Circle::is_gone, Unit::get_target_food, Unit::set_target_food,
-//              target_food, Circle::take_amount, Circle::give_amount,
-//              Unit::give_food, Circle::update, std::swap
-//
-//******************************************************************
-void Game::update_food(float dt) {
-    for (GLuint i = 0; i < food_drops.size(); ++i) {
-        if (food_drops[i]->is_gone()) {  // food ran out, need to handle deleting it
-            Circle* food = food_drops[i];  // get pointer to food
-            // order doesn't need to preserved, so we can pop out in constant time
-            std::swap(food_drops[i], food_drops[food_drops.size() - 1]);
-            food_drops.pop_back();
-
-            // tell bad guys that were targeting it that it ran out
-            for (GLuint j = 0; j < bad_guys.size(); ++j) {
-                if (bad_guys[j]->get_target_food() == food) {
-                    bad_guys[j]->set_target_food(nullptr);
-                }
-            }
-            // tell good guys that were targeting it that it ran out
-            for (GLuint j = 0; j < good_guys.size(); ++j) {
-                if (good_guys[j]->get_target_food() == food) {
-                    good_guys[j]->set_target_food(nullptr);
-                }
-            }
-
-            delete food;  // clear up resources
-
-            i--;  // we put a different element at index i, so next loop iteration needs to be at i again
-        } else {  // food it not gone
-            // update food for bad guys
-            for (GLuint j = 0; j < bad_guys.size(); ++j) {
-                // make bad guy target food if possible
-                target_food(bad_guys[j], food_drops[i], BAD_RANGE);
-
-                // if bad guy is targeting food and is already there, make it take the food
-                if (bad_guys[j]->get_target_food() == food_drops[i] && bad_guys[j]->is_at_target()) {
-                    float avail = food_drops[i]->take_amount(BAD_FOOD_RATE * dt);  // take food from drop
-                    score -= avail;  // decrement score by avail
-                }
-            }
-
-            // update food for good guys
-            for (GLuint j = 0; j < good_guys.size(); ++j) {
-                // make good guy target food if possible
-                target_food(good_guys[j], food_drops[i], GOOD_RANGE);
-
-                // if good guy is targeting food and is already there, make it take the food
-                if (good_guys[j]->get_target_food() == food_drops[i] && good_guys[j]->is_at_target()) {
-                    float amnt = GOOD_FOOD_RATE * dt;  // amount of food the guy will take
-                    float avail = food_drops[i]->take_amount(amnt);  // take food from drop
-                    avail -= good_guys[j]->give_food(avail);  // give food to unit;
-                    score += amnt - avail;  // increment score by avail
-                    if (avail >= 1e-3) {  // if avail is greater than 0
-                        food_drops[i]->give_amount(avail);  // unit couldn't take all of the food, give back to drop
-                    }
-                }
-            }
-
-            food_drops[i]->update(dt);  // update food_drop size, etc.
-        }
-    }
+//  Member/Global Variables: sim, renderer
+//
+//  Pre Conditions:  c must stay valid while the game is (or be null)
+//
+//  Post Conditions: the work of every simulation update, and the draw
+//                   calls and uniforms of every frame drawn, will be
+//                   counted in c from now on (a frame's draws land in
+//                   the tick the next update ends), or nothing is
+//                   counted if c is null
+//
+//  Calls:      Simulation::set_work_counters, Renderer::set_work_counters
+//
+//******************************************************************
+void Game::set_work_counters(WorkCounters* c) {
+    sim.set_work_counters(c);
+    renderer->set_work_counters(c);
 }
 
 //******************************************************************
 //
-//  Function:   Game::update_bad_guys
+//  Function:   Game::update
 //
-//  Purpose:    to update all of the bad guys based on given delta time
+//  Purpose:    to update the simulation in fixed steps, based on given
+//              delta time
 //
 //  Parameters: dt
 //
-//  Member/Global Variables: bad_guys, BAD_RANGE
+//  Member/Global Variables: sim, tick_time, accumulator, alpha,
+//                           ticks_run, recorder, trace,
+//                           MAX_CATCH_UP_TICKS, CHECKPOINT_TICKS
 //
-//  Pre Conditions:  all of the above variables must have valid values
+//  Pre Conditions:  sim must have been initialized
 //
-//  Post Conditions: the bad guys in the game will have been updated based
-//                   on given delta time (dt)
+//  Post Conditions: the simulation will have been updated once for every
+//                   whole tick_time that has passed (up to
+//                   MAX_CATCH_UP_TICKS), and alpha will say how far
+//                   into the next tick the leftover time is; if the game
+//                   is recorded, the state hash will have been recorded
+//                   every CHECKPOINT_TICKS ticks; if it's traced, the
+//                   start of the frame and the updates will have been
+//                   traced, and everything traced so far written out
 //
-//  Calls:      Unit::get_target_food, Unit::is_at_target, Unit::get_position,
-//              generate_random, can_reach, Unit::set_target_pos, Unit::update
+//  Calls:      TraceRecorder::add_instant, ScopedTrace,
+//              Simulation::update, make_input,
+//              Simulation::get_state_hash, InputRecorder::record,
+//              TraceRecorder::flush
 //
 //******************************************************************
-void Game::update_bad_guys(float dt) {
-    for (GLuint i = 0; i < bad_guys.size(); ++i) {
-        // if bad guy doesn't have a target, give it a random position target
-        if (bad_guys[i]->get_target_food() == nullptr && bad_guys[i]->is_at_target()) {
-            // keep generating random positions within the bad guy's range until one is traversable
-            // this is a naive approach, but it works
-            vec2 pos;
-            do {
-                pos = bad_guys[i]->get_position() + BAD_RANGE * vec2((generate_random() - 0.5) * 2, (generate_random() - 0.5) * 2);
-            } while(!can_reach(bad_guys[i]->get_position(), pos, BAD_RANGE));
+void Game::update(float dt) {
+    if (trace != nullptr) {
+        trace->add_instant(TRACE_FRAME, "frame", "ticks", ticks_run);
+    }
+    ScopedTrace span(trace, TRACE_FRAME, "update");
+
+    accumulator += dt;
+
+    GLuint ticks = 0;
+    while (accumulator >= tick_time) {
+        if (ticks == MAX_CATCH_UP_TICKS) {
+            // too far behind (after a hitch), so drop the time we can't catch up on
+            // instead of making the next frame even slower
+            accumulator = 0;
+            break;
+        }
 
-            bad_guys[i]->set_target_pos(pos);  // set target position
+        sim.update(tick_time);
+        accumulator -= tick_time;
+        ticks++;
+        ticks_run++;
+
+        if (recorder != nullptr && ticks_run % CHECKPOINT_TICKS == 0) {
+            InputEvent checkpoint = make_input(INPUT_CHECKPOINT);
+            checkpoint.tick = ticks_run;
+            checkpoint.hash = sim.get_state_hash();
+            recorder->record(checkpoint);
         }
+    }
 
-        bad_guys[i]->update(dt);  // update position and rotation, etc.
+    alpha = accumulator / tick_time;
+
+    // once per frame, the rings are emptied between updates so no thread is recording
+    if (trace != nullptr) {
+        trace->flush();
     }
 }
 
 //******************************************************************
 //
-//  Function:   Game::update_good_guys
+//  Function:   Game::init
 //
-//  Purpose:    to update all of the good guys based on given delta time
+//  Purpose:    initializes the simulation and opengl state of the game
 //
-//  Parameters: dt
+//  Parameters: none
 //
-//  Member/Global Variables: good_guys, score, GOOD_RANGE, GOOD_MAX_FOOD
+//  Member/Global Variables: sim, map, BACKGROUND_COLOR
 //
-//  Pre Conditions:  all of the above variables must have valid values
+//  Pre Conditions:  an opengl context must be valid and active, and
+//                   the window size must have been set
 //
-//  Post Conditions: the good guys in the game will have been updated based
-//                   on given delta time (dt)
+//  Post Conditions: all of the game objects will have been created, or
+//                   loaded from the map if there is one
 //
-//  Calls:      Unit::is_full, Unit::get_target_food, Unit::is_at_target,
-//              Unit::get_position, generate_random, can_reach, Unit::set_target_pos,
-//              Unit::update, std::swap
+//  Calls:      glClearColor, Simulation::init, MapFile::get_view
 //
 //******************************************************************
-void Game::update_good_guys(float dt) {
-    for (GLuint i = 0; i < good_guys.size(); ++i) {
-        if (good_guys[i]->is_full()) {  // if good guy is full
-            // need to remove from game
-            Unit* u = good_guys[i];  // get pointer of good guy
-            // order doesn't need to preserved, so we can pop out in constant time
-            std::swap(good_guys[i], good_guys[good_guys.size() - 1]);
-            good_guys.pop_back();
-
-            delete u;  // clear up resources
-
-            score += GOOD_MAX_FOOD * 2;  // increment score by double the amount of food the good guy got
+void Game::init() {
+    glClearColor(BACKGROUND_COLOR.x, BACKGROUND_COLOR.y, BACKGROUND_COLOR.z, 1.0);  // set background color
 
-            i--;  // we put a different element at index i, so next loop iteration needs to be at i again
-        } else {
-            // if good guy doesn't have a target, give it a random position target
-            if (good_guys[i]->get_target_food() == nullptr && good_guys[i]->is_at_target()) {
-                // keep generating random positions within the good guy's range until one is traversable
-                // this is a naive approach, but it works
-                vec2 pos;
-                do {
-                    pos = good_guys[i]->get_position() + GOOD_RANGE * vec2((generate_random() - 0.5) * 2, (generate_random() - 0.5) * 2);
-                } while(!can_reach(good_guys[i]->get_position(), pos, GOOD_RANGE));
-                
-                good_guys[i]->set_target_pos(pos);  // set target position
-            }
-
-            good_guys[i]->update(dt);  // update position, rotation, etc.
-        }
+    if (map != nullptr) {
+        sim.init(map->get_view());
+    } else {
+        sim.init();
     }
 }
 
 //******************************************************************
 //
-//  Function:   Game::update_plane
+//  Function:   Game::reset
 //
-//  Purpose:    to update the plane based on given delta time
+//  Purpose:    starts a new game on a new map, reusing the memory of
+//              the current one
 //
-//  Parameters: dt
+//  Parameters: none
 //
-//  Member/Global Variables: plane, plane_visible, dropping_food, FOOD_SIZE,
-//                           FOOD_PER_DROP, FOOD_ROT_SPEED, FOOD_COLOR,
-//                           shader_id, window_size, PLANE_SIZE
+//  Member/Global Variables: none
 //
-//  Pre Conditions:  all of the above variables must have valid values
+//  Pre Conditions:  init must have been called
 //
-//  Post Conditions: the plane in the game will have been updated based
-//                   on given delta time (dt)
+//  Post Conditions: the game will be back at its starting state with
+//                   newly generated game objects (or the map again, if
+//                   it's played on one)
 //
-//  Calls:      Unit::is_at_target, Unit::get_position, Circle::set_color,
-//              Circle::set_position, Circle::init, Unit::set_target_pos,
-//              generate_random, Unit::update
+//  Calls:      handle_input, make_input
 //
 //******************************************************************
-void Game::update_plane(float dt) {
-    if (plane_visible && plane->is_at_target()) {  // if plane has finished one of two stages
-        if (dropping_food) {  // plane reached drop position
-            // create food drop at location
-            Circle* c = new Circle(FOOD_SIZE, FOOD_PER_DROP, FOOD_ROT_SPEED);
-            c->set_color(FOOD_COLOR);
-            c->set_position(plane->get_position());
-            c->init(shader_id);
-            food_drops.push_back(c);
-
-            // make plane target somewhere random off-screen to the right
-            plane->set_target_pos(vec2(window_size.x / 2 + PLANE_SIZE, window_size.y * (generate_random() - 0.5)));
+void Game::reset() {
+    handle_input(make_input(INPUT_RESET));
+}
 
-            dropping_food = false;
-        } else {  // plane finished drop and left screen
-            plane_visible = false;
-        }
-    }
+//******************************************************************
+//
+//  Function:   Game::quick_save
+//
+//  Purpose:    saves the game as it is
+//
+//  Parameters: none
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  init must have been called
+//
+//  Post Conditions: the game's state will have replaced the last quick
+//                   save (without allocating, once it has the room)
+//
+//  Calls:      handle_input, make_input
+//
+//******************************************************************
+void Game::quick_save() {
+    handle_input(make_input(INPUT_SAVE));
+}
 
-    if (plane_visible) {
-        plane->update(dt);  // update position, rotation, etc.
-    }
+//******************************************************************
+//
+//  Function:   Game::quick_load
+//
+//  Purpose:    puts the game back to the last quick save
+//
+//  Parameters: none
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  init must have been called
+//
+//  Post Conditions: if the game has been quick saved, it will be exactly
+//                   as it was then
+//
+//  Calls:      handle_input, make_input
+//
+//******************************************************************
+void Game::quick_load() {
+    handle_input(make_input(INPUT_LOAD));
 }
 
 //******************************************************************
 //
-//  Function:   Game::is_within_bounds
+//  Function:   Game::end_recording
 //
-//  Purpose:    to determine whether the given position is within game
-//              view bounds or not
+//  Purpose:    finishes the input log with the state the game ended in
 //
-//  Parameters: pos
+//  Parameters: none
 //
-//  Member/Global Variables: window_size
+//  Member/Global Variables: recorder, sim, ticks_run
 //
-//  Pre Conditions:  window_size and pos must have valid values
+//  Pre Conditions:  init must have been called
 //
-//  Post Conditions: will return true if pos is within the window view bounds
+//  Post Conditions: if inputs are being recorded, the log will end with
+//                   a checkpoint at the last tick run, so a replay runs
+//                   up to it, and nothing more is recorded
 //
-//  Calls:      none
+//  Calls:      InputRecorder::close, Simulation::get_state_hash
 //
 //******************************************************************
-bool Game::is_within_bounds(const vec2& pos) const {
-    vec2 half_window_size = window_size / 2;
-    if (pos.x < -half_window_size.x || pos.x > half_window_size.x) {  // x component out of window range
-        return false;
+void Game::end_recording() {
+    if (recorder != nullptr) {
+        recorder->close(ticks_run, sim.get_state_hash());
+        recorder = nullptr;
     }
-    if (pos.y < -half_window_size.y || pos.y > half_window_size.y) {  // y component out of window range
-        return false;
-    }
-
-    return true;
 }
 
 //******************************************************************
 //
-//  Function:   Game::is_traversable
+//  Function:   Game::handle_click
 //
-//  Purpose:    to determine whether the given position is traversable
-//              for the units or not
+//  Purpose:    to handle a user mouse click event
 //
 //  Parameters: pos
 //
-//  Member/Global Variables: trees, BAD_SIZE, GOOD_SIZE
+//  Member/Global Variables: BACKGROUND_COLOR, window_size, sim, timers,
+//                           trace
 //
-//  Pre Conditions:  the above variables must have valid values
+//  Pre Conditions:  all of the above variables must have valid values, and
+//                   an opengl context must be valid and active
 //
-//  Post Conditions: will return true if pos is traversable by units
+//  Post Conditions: the game object will have handled a user click at pos,
+//                   and the time it took timed if there are timers and
+//                   traced (selection pass, flush, and read back each on
+//                   their own) if there's a trace
 //
-//  Calls:      is_within_bounds, length, Circle::get_position, Circle::get_radius,
-//              std::max
+//  Calls:      ScopedTimer, ScopedTrace, glClearColor, glClear,
+//              glReadBuffer, display, glFlush, glReadPixels,
+//              handle_input, make_input, get_view_scale
 //
 //******************************************************************
-bool Game::is_traversable(const vec2& pos) const {
-    if (!is_within_bounds(pos)) {
-        return false;
+void Game::handle_click(const vec2& pos) {
+    ScopedTimer timer(timers, PHASE_CLICK);  // includes the selection draw and reading its pixel back
+    ScopedTrace span(trace, TRACE_INPUT, PHASE_NAMES[PHASE_CLICK]);
+
+    glClearColor(1.0, 1.0, 1.0, 1.0);  // white clear color
+    glClear(GL_COLOR_BUFFER_BIT);  // clear color buffer
+    glReadBuffer(GL_BACK);  // read from back buffer
+
+    display(true);  // draw our objects with selection rendering
+    {
+        ScopedTrace flush_span(trace, TRACE_INPUT, "glFlush");
+        glFlush();  // ensure our objects are done drawing
     }
+    glClearColor(BACKGROUND_COLOR.x, BACKGROUND_COLOR.y, BACKGROUND_COLOR.z, 1.0);  // restore background color to original
 
-    for (GLuint i = 0; i < trees.size(); ++i) {
-        // if position is within the tree's radius, it is not traversable
-        if (length(pos - trees[i]->get_position()) < (trees[i]->get_radius() + std::max(BAD_SIZE, GOOD_SIZE) / 2)) {
-            return false;
+    unsigned char pixel_color[3];  // our color data
+    {
+        ScopedTrace read_span(trace, TRACE_INPUT, "glReadPixels");
+        glReadPixels(pos.x, window_size.y - pos.y, 1, 1, GL_RGB, GL_UNSIGNED_BYTE, &pixel_color);  // read color
+    }
+
+    // white is the clear color, so it means nothing was clicked
+    GLuint selected = pixel_color[0] | (pixel_color[1] << 8) | (pixel_color[2] << 16);
+    bool clicked = selected != 0xFFFFFF;
+    if (clicked) {
+        GLuint kind = selected >> SELECT_KIND_SHIFT;
+        GLuint index = selected & SELECT_INDEX_MASK;
+        if (kind == SELECT_GOOD && index < sim.get_good_guys().size()) {
+            // user clicked this good guy, make it zoom!
+            handle_input(make_input(INPUT_BOOST_GOOD, index));  // give boost
+        } else if (kind == SELECT_BAD && index < sim.get_bad_guys().size()) {
+            // user clicked this bad guy, make it slow
+            handle_input(make_input(INPUT_BOOST_BAD, index));  // give boost (it's boost factor is less than one, so it slows down)
         }
+        // trees and food drops just block the drop from happening (can't drop on top of them)
     }
 
-    return true;
+    if (!clicked) {  // if our mouse click wasn't blocked, try to do a drop
+        vec2 scaled_pos = (vec2(pos.x, window_size.y - pos.y) - window_size / 2) * get_view_scale();  // mouse position scaled into world coordinates
+        handle_input(make_input(INPUT_DROP, 0, scaled_pos));
+    }
 }
 
 //******************************************************************
 //
-//  Function:   Game::can_reach
+//  Function:   Game::display
 //
-//  Purpose:    to determine whether given position a is reachable by
-//              given position b within range
+//  Purpose:    to draw the game state
 //
-//  Parameters: a, b, range
+//  Parameters: selection_draw
 //
-//  Member/Global Variables: trees, BAD_SIZE, GOOD_SIZE
+//  Member/Global Variables: renderer, window_size, sim, alpha, timers,
+//                           trace, TREE_COLOR, FOOD_COLOR, GOOD_COLOR,
+//                           BAD_COLOR, PLANE_COLOR
 //
-//  Pre Conditions:  the above variables must have valid values
+//  Pre Conditions:  all of the above variables must have valid values, and
+//                   an opengl context must be valid and active
 //
-//  Post Conditions: will return true if a is reachable by b within range
+//  Post Conditions: all of the game objects will have been drawn to the
+//                   frame buffer, and the time it took timed if there are
+//                   timers (selection draws are timed as part of the click),
+//                   and each pass traced if there's a trace
 //
-//  Calls:      is_within_bounds, length, Circle::get_position, Circle::get_radius,
-//              std::max, dot
+//  Calls:      ScopedTimer, ScopedTrace, Renderer::set_window_size,
+//              get_view_scale,
+//              get_select_color, Renderer::draw_circle,
+//              Renderer::draw_unit, update_window_title
 //
 //******************************************************************
-bool Game::can_reach(const vec2& a, const vec2& b, float range) const {
-    if (!is_within_bounds(b)) {
-        // if a isn't in bounds either, let it slide
-        // this exception prevents crashing, but as a result
-        // some units may be lost outside the bounds of the window
-        // forever if you resize the window and they are cut off
-        if (is_within_bounds(a)) {
-            return false;
+void Game::display(bool selection_draw) {
+    ScopedTimer timer(selection_draw ? nullptr : timers, PHASE_DISPLAY);
+    ScopedTrace span(trace, selection_draw ? TRACE_INPUT : TRACE_DRAW,
+                     selection_draw ? "selection draw" : PHASE_NAMES[PHASE_DISPLAY]);
+
+    renderer->set_window_size(window_size * get_view_scale());  // send the part of the world the window shows to shader
+
+    // draw trees
+    {
+        ScopedTrace pass(trace, TRACE_DRAW, "trees");
+        const CircleStore& trees = sim.get_trees();
+        for (GLuint i = 0; i < trees.size(); ++i) {
+            vec3 color = selection_draw ? get_select_color(SELECT_TREE, i) : TREE_COLOR;
+            renderer->draw_circle(trees.get_position(i), trees.get_radius(i), color, selection_draw);
         }
     }
 
-    vec2 dir = b - a;  // get displacement vector from b to a
-    float dist = length(dir);  // we need the length to normalize anyways, so we can't avoid this square root
-
-    if (dist > range) {
-        return false;
+    // draw food drops
+    {
+        ScopedTrace pass(trace, TRACE_DRAW, "food drops");
+        const CircleStore& food_drops = sim.get_food_drops();
+        for (GLuint i = 0; i < food_drops.size(); ++i) {
+            vec3 color = selection_draw ? get_select_color(SELECT_FOOD, i) : FOOD_COLOR;
+            renderer->draw_circle(food_drops.get_position(i), food_drops.get_radius(i), color, selection_draw);
+        }
     }
 
-    for (GLuint i = 0; i < trees.size(); ++i) {
-        vec2 dir2 = trees[i]->get_position() - a;
-        float scalar_proj = dot(dir, dir2) / dist;  // scalar projection of dir2 onto dir
-        float min_radius = (trees[i]->get_radius() + std::max(BAD_SIZE, GOOD_SIZE) / 2);  // minimum radius for outside of tree
-        min_radius *= min_radius;  // square minimum radius
-
-        if (scalar_proj > 0 && scalar_proj < dist) {  // check whether projection is actually on line segement defined by b and a
-            vec2 projection = a + (dir / dist) * scalar_proj;  // vector projection of dir2 onto dir
-
-            vec2 radius_vec = trees[i]->get_position() - projection;  // displacement vector from tree center to projection point
-            // check whether length of radius_vec squared falls within minimum radius
-            // (doing this to avoid expensive square root calls)
-            if (dot(radius_vec, radius_vec) < min_radius) {
-                return false;
-            }
+    // draw good guys
+    {
+        ScopedTrace pass(trace, TRACE_DRAW, "good guys");
+        const UnitStore& good_guys = sim.get_good_guys();
+        for (GLuint i = 0; i < good_guys.size(); ++i) {
+            vec3 color = selection_draw ? get_select_color(SELECT_GOOD, i) : GOOD_COLOR;
+            renderer->draw_unit(good_guys.get_drawn_position(i, alpha), good_guys.get_size(i),
+                                good_guys.get_drawn_rotation(i, alpha), color, selection_draw);
         }
+    }
 
-        vec2 radius_vec = trees[i]->get_position() - b;
-        // finally, check if the final point falls within the tree's radius
-        // (again, doing this to avoid expensive square root calls)
-        if (dot(radius_vec, radius_vec) < min_radius) {
-            return false;
+    // draw bad guys
+    {
+        ScopedTrace pass(trace, TRACE_DRAW, "bad guys");
+        const UnitStore& bad_guys = sim.get_bad_guys();
+        for (GLuint i = 0; i < bad_guys.size(); ++i) {
+            vec3 color = selection_draw ? get_select_color(SELECT_BAD, i) : BAD_COLOR;
+            renderer->draw_unit(bad_guys.get_drawn_position(i, alpha), bad_guys.get_size(i),
+                                bad_guys.get_drawn_rotation(i, alpha), color, selection_draw);
         }
     }
 
-    return true;
+    // draw plane if it should be visible (clicking it selects nothing, so it's white when selecting)
+    if (sim.is_plane_visible()) {
+        ScopedTrace pass(trace, TRACE_DRAW, "plane");
+        const UnitStore& plane = sim.get_plane();
+        vec3 color = selection_draw ? vec3(1, 1, 1) : PLANE_COLOR;
+        renderer->draw_unit(plane.get_drawn_position(0, alpha), plane.get_size(0),
+                            plane.get_drawn_rotation(0, alpha), color, selection_draw);
+    }
+
+    update_window_title();
+}
+
+//******************************************************************
+//
+//  Function:   Game::handle_input
+//
+//  Purpose:    records an input the player gave and applies it to the
+//              simulation
+//
+//  Parameters: input
+//
+//  Member/Global Variables: sim, map, recorder, saved_game, ticks_run,
+//                           accumulator, alpha
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the input will have been recorded, stamped with the
+//                   number of ticks run, if the game is recorded, and
+//                   applied exactly as a replay of it will be
+//
+//  Calls:      InputRecorder::record, apply_input
+//
+//******************************************************************
+void Game::handle_input(InputEvent input) {
+    input.tick = ticks_run;
+    if (recorder != nullptr) {
+        recorder->record(input);
+    }
+
+    apply_input(sim, input, map, saved_game);
+
+    if (input.kind == INPUT_RESET || input.kind == INPUT_LOAD) {
+        // time passed before a new map or a load doesn't carry over to it
+        accumulator = 0;
+        alpha = 1;
+    }
 }
 
 //******************************************************************
@@ -753,14 +612,15 @@ bool Game::can_reach(const vec2& a, const vec2& b, float range) const {
 //
 //  Parameters: none
 //
-//  Member/Global Variables: good_guys, drops_left, food_drops, plane_visible,
-//                           score, GAME_TITLE
+//  Member/Global Variables: sim, GAME_TITLE
 //
 //  Pre Conditions:  the above variables must have valid values
 //
 //  Post Conditions: the window title will be updated with game information
 //
-//  Calls:      glutSetWindowTitle
+//  Calls:      Simulation::is_game_over, Simulation::get_good_guys,
+//              Simulation::get_score, Simulation::get_drops_left,
+//              glutSetWindowTitle
 //
 //******************************************************************
 void Game::update_window_title() const {
@@ -769,19 +629,70 @@ void Game::update_window_title() const {
     sstream.precision(1);
     sstream << GAME_TITLE;
 
-    if (good_guys.size() == 0 || (drops_left == 0 && food_drops.size() == 0 && !plane_visible)) {
+    if (sim.is_game_over()) {
         // game ended
         sstream << " | GAME OVER! ";
-        if (good_guys.size() == 0) {
+        if (sim.get_good_guys().size() == 0) {
             sstream << "YOU WIN! ";
         } else {
             sstream << "YOU LOSE! ";
         }
-        sstream << "Final Score: " << std::fixed << score;
+        sstream << "Final Score: " << std::fixed << sim.get_score();
     } else {
-        sstream << " | Score: " << std::fixed << score << ", Drops left: " << drops_left;
+        sstream << " | Score: " << std::fixed << sim.get_score() << ", Drops left: " << sim.get_drops_left();
     }
 
     // convert string stream to c-type string and set it as window title
     glutSetWindowTitle(sstream.str().c_str());
 }
+
+//******************************************************************
+//
+//  Function:   Game::get_view_scale
+//
+//  Purpose:    to return how many world units a pixel of the window
+//              covers
+//
+//  Parameters: none
+//
+//  Member/Global Variables: window_size, sim
+//
+//  Pre Conditions:  the window size must have been set
+//
+//  Post Conditions: returns the smallest scale that fits the whole
+//                   world in the window without stretching it (1 when
+//                   the world follows the window)
+//
+//  Calls:      Simulation::get_world_size, std::max
+//
+//******************************************************************
+float Game::get_view_scale() const {
+    vec2 world = sim.get_world_size();
+    return std::max(world.x / window_size.x, world.y / window_size.y);
+}
+
+//******************************************************************
+//
+//  Function:   Game::get_select_color
+//
+//  Purpose:    to return the color an object is drawn with during
+//              selection rendering
+//
+//  Parameters: kind, index
+//
+//  Member/Global Variables: SELECT_KIND_SHIFT, SELECT_INDEX_MASK
+//
+//  Pre Conditions:  kind must be one of the SELECT_ constants and index
+//                   must fit in SELECT_INDEX_MASK
+//
+//  Post Conditions: returns a color whose red, green, and blue bytes
+//                   hold the low, middle, and high bytes of the packed
+//                   kind and index
+//
+//  Calls:      none
+//
+//******************************************************************
+vec3 Game::get_select_color(GLuint kind, GLuint index) {
+    GLuint id = (kind << SELECT_KIND_SHIFT) | (index & SELECT_INDEX_MASK);
+    return vec3((id & 0xFF) / 255.0, ((id >> 8) & 0xFF) / 255.0, ((id >> 16) & 0xFF) / 255.0);
+}
@@ -6,9 +6,9 @@
 //    Author:      Kirk Saunders
 //    Email:       ks825016@ohio.edu
 //
-//    Description: This class provides a data structure to store game
-//                 state and provides helper functions for updating
-//                 state based on delta time and handling mouse events.
+//    Description: This class connects the game simulation to OpenGL.
+//                 It draws the simulated world and translates mouse
+//                 events into simulation actions.
 //
 //    Date:        10/6/2019
 //
@@ -24,8 +24,14 @@
 #include <Angel.h>
 
 // Source libraries
-#include "circle.h"
-#include "unit.h"
+#include "input_log.h"
+#include "map_file.h"
+#include "phase_timer.h"
+#include "renderer.h"
+#include "scenario.h"
+#include "simulation.h"
+#include "trace_recorder.h"
+#include "work_counters.h"
 
 // Game visual constants
 constexpr char const* GAME_TITLE = "Food Drop Game";  // name of game to display in window title
@@ -34,127 +40,129 @@ const vec3 GOOD_COLOR = vec3(0, 0, 0.75);
 const vec3 FOOD_COLOR = vec3(1, 0.75, 0);
 const vec3 TREE_COLOR = vec3(0, 0.75, 0);
 const vec3 PLANE_COLOR = vec3(0.1, 0.1, 0.1);
-const float BAD_SIZE = 30;
-const float GOOD_SIZE = 30;
-const float FOOD_SIZE = 20;
-const float TREE_MIN_SIZE = 25;
-const float TREE_MAX_SIZE = 55;
-const float PLANE_SIZE = 65;
 const vec3 BACKGROUND_COLOR = vec3(225/255.0, 191/255.0, 146/255.0);  // background color of window
 
-// Gameplay constants
-const float FOOD_PER_DROP = 1000;  // amount of food in a drop
-const float FOOD_ROT_SPEED = 50;  // amount of food that rots every second
-const float GOOD_MAX_FOOD = 350;  // amount of food that a good guy needs to be full
-const float BAD_FOOD_RATE = 250;  // how much food bad guys take per second
-const float GOOD_FOOD_RATE = 150;  // how much food good guys take per second
-const float BAD_SPEED = 40;  // how far bad guys can move per second
-const float GOOD_SPEED = 30;  // how far good guys can move per second
-const float BAD_RANGE = 200;  // how far bad guys can see food from
-const float GOOD_RANGE = 150;  // how far good guys can see food from
-const float GOOD_BOOST_FACTOR = 4;  // speed boost factor for good guys
-const float BAD_BOOST_FACTOR = 0.25;  // speed boost factor for bad guys
-const float SPEED_BOOST_DURATION = 5;  // how long do speed boosts last for
-const float PLANE_SPEED = 600;  // speed of drop plane
+// Timing constants
+const GLuint MAX_CATCH_UP_TICKS = 5;  // most simulation updates to run in one frame when behind
+
+// Selection constants (a selection color packs an object kind and index into 24 bits)
+const GLuint SELECT_TREE = 0;  // kind of selected trees
+const GLuint SELECT_FOOD = 1;  // kind of selected food drops
+const GLuint SELECT_GOOD = 2;  // kind of selected good guys
+const GLuint SELECT_BAD = 3;  // kind of selected bad guys
+const GLuint SELECT_KIND_SHIFT = 22;  // bit position of the kind in a selection color
+const GLuint SELECT_INDEX_MASK = (1 << SELECT_KIND_SHIFT) - 1;  // bits of the index in a selection color
 
 //******************************************************************
 //
 //  Class: Game
 //
-//  Purpose:  To provide a data structure that handles game state, drawing,
-//            and updating based on delta time.
+//  Purpose:  To provide a data structure that draws the simulated game
+//            world and handles user input. All of the game state and
+//            updating lives in the Simulation class.
 //
 //  Functions:
 //           Constructors
 //             Game() = delete
-//             Game(num_b_guys, num_g_guys,
-//                  num_ts, drops, shader)  create game with given number good and
-//                                          bad guys, number trees, drops, and
-//                                          shader id
+//             Game(scenario, rend)  create game set up as given by scenario,
+//                                   drawn with given renderer
 //           setters
-//             set_window_size to set the game's window size variable
+//             set_window_size to set the game's window size variable (and
+//                             the world size, if the world follows the window)
+//             set_tick_rate to set how many times per second the simulation
+//                           updates
+//             set_seed to set the seed the game's maps are made from
+//             set_map to set a saved map to play instead of making maps
+//             set_recorder to set where the inputs the game is given are
+//                          recorded
+//             set_phase_timers to set where the game's updates, draws, and
+//                              clicks are timed
+//             set_trace_recorder to set where the game's frames, updates,
+//                                draws, and clicks are traced
+//             set_work_counters to set where the work the game's updates
+//                               and draws do is counted
 //           mutators
-//             update(dt) to update the game objects' positions and such
-//                        based on given delta time
-//             init() to initialize game objects and opengl data and such
+//             update(dt) to run as many fixed simulation updates as fit in
+//                        the time passed, including given delta time
+//             init() to initialize the simulation and opengl state
+//             reset() to start a new game, reusing the current one's memory
+//             quick_save() to save the game as it is
+//             quick_load() to put the game back to the last quick save
+//             end_recording() to finish the input log with where the game
+//                             ended up, and stop recording
 //           helpers
 //             handle_click(pos) to handle a mouse click at pos
 //             display(selection_draw) to draw the game elements to
 //                                     the frame buffer
 //           private helpers
-//             target_food(unit, food, range) makes unit target food
-//                                            if in range and can reach
-//             update_food(dt) updates all of the food drops based on
-//                             given delta time
-//             update_bad_guys(dt) updates all of the bad guys based on
-//                             given delta time
-//             update_good_guys(dt) updates all of the good guys based on
-//                             given delta time
-//             update_plane(dt) updates the plane based on given delta
-//                              time
-//             is_within_bounds(pos) determines whether the given position
-//                                   is within the window bounds
-//             is_traversable(pos) determines whether the given position
-//                                 is traversable by a unit or not
-//             can_reach(a, b, range) determines whether position b is
-//                                    reachable by position a within range
+//             handle_input(input) records an input and applies it to the
+//                                 simulation
 //             update_window_title() handles updating the window title with
 //                                   game information
+//             get_view_scale() returns how many world units a pixel covers
+//             get_select_color(kind, index) returns the selection color of
+//                                           the object of kind at index
 //  
 //******************************************************************
 
 class Game {
  public:
     Game() = delete;  // no default constructor
-    Game(GLuint num_b_guys, GLuint num_g_guys, GLuint num_ts, GLuint drops, GLuint shader)
-        : score(0), drops_left(drops), num_bad_guys(num_b_guys), num_good_guys(num_g_guys),
-          num_trees(num_ts), shader_id(shader), plane(nullptr), plane_visible(false),
-          dropping_food(false), window_size(vec2()) {}
+    Game(const Scenario& scenario, Renderer* rend)
+        : sim(scenario.bad_guys, scenario.good_guys, scenario.trees, scenario.drops, scenario.threads),
+          renderer(rend), map(nullptr), recorder(nullptr), timers(nullptr), trace(nullptr), window_size(scenario.window_size),
+          world_follows_window(!has_world_size(scenario)),
+          tick_time(1 / scenario.tick_rate), accumulator(0), alpha(1), ticks_run(0) {
+        sim.set_world_size(get_world_size(scenario));
+        sim.set_tuning(scenario.tuning);
+        sim.set_seed(scenario.seed);
+    }
     Game(const Game&) = delete;  // no copy constructor
     Game operator=(const Game&) = delete;  // no copy assignment operator
-    ~Game();
 
     // setters
     void set_window_size(const vec2& size);
+    void set_tick_rate(float rate);
+    void set_seed(uint64_t seed);
+    void set_map(const MapFile* file);
+    void set_recorder(InputRecorder* rec);
+    void set_phase_timers(PhaseTimers* t);
+    void set_trace_recorder(TraceRecorder* t);
+    void set_work_counters(WorkCounters* c);
 
     // mutators
     void update(float dt);
     void init();
+    void reset();
+    void quick_save();
+    void quick_load();
+    void end_recording();
 
     // helpers
     void handle_click(const vec2& pos);
     void display(bool selection_draw = false);
  private:
-    float score;  // user score
-    GLuint drops_left;  // drops left for the player
-
-    GLuint num_bad_guys;  // max number of bad guys
-    GLuint num_good_guys;  // max number of good guys
-    GLuint num_trees;  // max number of trees
-    GLuint shader_id;  // opengl shader proram id
-    GLint window_size_loc;  // opengl window size shader uniform variable
-
-    std::vector<Unit*> bad_guys;  // vector containing bad guys
-    std::vector<Unit*> good_guys;  // vector containing good guys
-    std::vector<Circle*> trees;  // vector containing trees
-    std::vector<Circle*> food_drops;  // vector containing food drops
-
-    Unit* plane;  // plane that makes the food drops
-    bool plane_visible;  // whether or not the plane is visible
-    bool dropping_food;  // whether or not the plane is dropping food
+    Simulation sim;  // the simulated game world
+    Renderer* renderer;  // renderer used to draw the world (not owned)
+    const MapFile* map;  // saved map every game is played on, or null to make maps (not owned)
+    InputRecorder* recorder;  // where inputs are recorded, or null to not record them (not owned)
+    PhaseTimers* timers;  // where phases are timed, or null to not time them (not owned)
+    TraceRecorder* trace;  // where frames are traced, or null to not trace them (not owned)
+    std::vector<unsigned char> saved_game;  // snapshot of the last quick save (empty if there's none)
 
     vec2 window_size;  // window size variable
+    bool world_follows_window;  // whether the world is resized along with the window
+
+    float tick_time;  // delta time of every simulation update
+    float accumulator;  // time passed that hasn't been simulated yet
+    float alpha;  // how far between the last two simulation updates to draw (0 to 1)
+    uint64_t ticks_run;  // simulation updates run since the game started, over every map
 
     // private helpers
-    void target_food(Unit* unit, Circle* food, float range);
-    void update_food(float dt);
-    void update_bad_guys(float dt);
-    void update_good_guys(float dt);
-    void update_plane(float dt);
-    bool is_within_bounds(const vec2& pos) const;
-    bool is_traversable(const vec2& pos) const;
-    bool can_reach(const vec2& a, const vec2& b, float range) const;
+    void handle_input(InputEvent input);
     void update_window_title() const;
+    float get_view_scale() const;
+    static vec3 get_select_color(GLuint kind, GLuint index);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,404 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        input_log.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These classes record the inputs a game is given, each
+//                 stamped with the tick it was applied before, to a
+//                 compact binary file, and read them back so the game can
+//                 be replayed without a window, checking the state of the
+//                 game against hashes recorded along the way.
+//
+//    Date:        10/16/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <cstring>
+#include <iostream>
+
+// Source libraries
+#include "input_log.h"
+
+// inputs and headers are written as they sit in memory, so they can't have padding
+static_assert(sizeof(InputEvent) == 40, "InputEvent must have no padding");
+static_assert(sizeof(InputLogHeader) == 112, "InputLogHeader must have no padding");
+
+//******************************************************************
+//
+//  Function:   make_input
+//
+//  Purpose:    returns an input of a kind
+//
+//  Parameters: kind, index, pos
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the input, with its tick, time, and hash 0
+//
+//  Calls:      none
+//
+//******************************************************************
+InputEvent make_input(uint32_t kind, GLuint index, const vec2& pos) {
+    InputEvent input;
+    input.tick = 0;
+    input.hash = 0;
+    input.time = 0;
+    input.kind = kind;
+    input.index = index;
+    input.x = pos.x;
+    input.y = pos.y;
+    return input;
+}
+
+//******************************************************************
+//
+//  Function:   apply_input
+//
+//  Purpose:    applies an input to a simulation, as the game does when
+//              it's given one
+//
+//  Parameters: sim, input, map, saved
+//
+//  Member/Global Variables: INPUT_ kinds
+//
+//  Pre Conditions:  sim must have been initialized, and map must be the
+//                   map the game is played on (or null if it makes maps)
+//
+//  Post Conditions: the input will have been applied (a reset starts the
+//                   next map, and saving and loading use saved); returns
+//                   false if the input is a checkpoint whose hash the
+//                   game doesn't match
+//
+//  Calls:      Simulation::request_drop, Simulation::boost_good_guy,
+//              Simulation::boost_bad_guy, Simulation::reset,
+//              Simulation::init, MapFile::get_view,
+//              Simulation::save_snapshot, Simulation::restore_snapshot,
+//              Simulation::set_world_size, Simulation::get_state_hash
+//
+//******************************************************************
+bool apply_input(Simulation& sim, const InputEvent& input, const MapFile* map, std::vector<unsigned char>& saved) {
+    switch (input.kind) {
+        case INPUT_DROP:
+            sim.request_drop(vec2(input.x, input.y));
+            break;
+        case INPUT_BOOST_GOOD:
+            if (input.index < sim.get_good_guys().size()) {
+                sim.boost_good_guy(input.index);
+            }
+            break;
+        case INPUT_BOOST_BAD:
+            if (input.index < sim.get_bad_guys().size()) {
+                sim.boost_bad_guy(input.index);
+            }
+            break;
+        case INPUT_RESET:
+            sim.reset();
+            if (map != nullptr) {
+                sim.init(map->get_view());
+            } else {
+                sim.init();
+            }
+            break;
+        case INPUT_SAVE:
+            sim.save_snapshot(saved);
+            break;
+        case INPUT_LOAD:
+            if (!saved.empty()) {
+                sim.restore_snapshot(saved);
+            }
+            break;
+        case INPUT_WORLD_SIZE:
+            sim.set_world_size(vec2(input.x, input.y));
+            break;
+        case INPUT_CHECKPOINT:
+            return sim.get_state_hash() == input.hash;
+    }
+
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   InputRecorder::open
+//
+//  Purpose:    starts a log of a game's inputs
+//
+//  Parameters: path, scenario, tick_time
+//
+//  Member/Global Variables: file, start, INPUT_LOG_MAGIC,
+//                           INPUT_LOG_VERSION, CHECKPOINT_TICKS
+//
+//  Pre Conditions:  scenario must be the one the game was set up from,
+//                   with the seed it really uses, tick_time must be the
+//                   delta time it updates with, and the game mustn't
+//                   have been initialized yet
+//
+//  Post Conditions: the file at path will hold the log's header, and
+//                   inputs recorded from now on are added to it; returns
+//                   false, after printing why to standard error, if it
+//                   couldn't be written
+//
+//  Calls:      std::ofstream::close, get_world_size, std::memcpy,
+//              std::ofstream::write, std::chrono::steady_clock::now
+//
+//******************************************************************
+bool InputRecorder::open(const std::string& path, const Scenario& scenario, float tick_time) {
+    if (file.is_open()) {
+        file.close();  // a log still being written is left as it is, without an end
+    }
+
+    InputLogHeader header;
+    std::memcpy(header.magic, INPUT_LOG_MAGIC, sizeof(header.magic));
+    header.version = INPUT_LOG_VERSION;
+    header.seed = scenario.seed;
+    header.bad_guys = scenario.bad_guys;
+    header.good_guys = scenario.good_guys;
+    header.trees = scenario.trees;
+    header.drops = scenario.drops;
+    vec2 world_size = get_world_size(scenario);
+    header.world_width = world_size.x;
+    header.world_height = world_size.y;
+    header.tick_time = tick_time;
+    header.map_length = scenario.map.size();
+    header.tuning = scenario.tuning;
+    header.checkpoint_ticks = CHECKPOINT_TICKS;
+    header.reserved = 0;
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(scenario.map.data(), scenario.map.size());
+    if (!file) {
+        file.close();
+        std::cerr << "Unable to write input log " << path << ".\n";
+        return false;
+    }
+
+    start = std::chrono::steady_clock::now();
+    last_tick = 0;
+    last_checkpoint = false;
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   InputRecorder::record
+//
+//  Purpose:    adds an input to the log
+//
+//  Parameters: input
+//
+//  Member/Global Variables: file, start, last_tick, last_checkpoint
+//
+//  Pre Conditions:  input's tick must be the number of ticks the game
+//                   has run, and no less than the last input's
+//
+//  Post Conditions: if a log is open, the input will have been written
+//                   to it, stamped with the seconds since it was opened,
+//                   and remembered as the last input
+//
+//  Calls:      is_open, std::chrono::steady_clock::now,
+//              std::ofstream::write
+//
+//******************************************************************
+void InputRecorder::record(InputEvent input) {
+    if (!is_open()) {
+        return;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    input.time = elapsed.count();
+    file.write(reinterpret_cast<const char*>(&input), sizeof(input));
+    last_tick = input.tick;
+    last_checkpoint = input.kind == INPUT_CHECKPOINT;
+}
+
+//******************************************************************
+//
+//  Function:   InputRecorder::close
+//
+//  Purpose:    finishes the log with the state the game ended in
+//
+//  Parameters: tick, hash
+//
+//  Member/Global Variables: file, last_tick, last_checkpoint
+//
+//  Pre Conditions:  tick must be the number of ticks the game has run,
+//                   and hash its state hash now
+//
+//  Post Conditions: if a log is open, it will end with a checkpoint at
+//                   tick (unless the last input recorded already was
+//                   one), every input recorded will have been written
+//                   out, and nothing more is recorded
+//
+//  Calls:      is_open, make_input, record, std::ofstream::close
+//
+//******************************************************************
+void InputRecorder::close(uint64_t tick, uint64_t hash) {
+    if (!is_open()) {
+        return;
+    }
+
+    // without it, a replay would stop at the last input, short of the ticks run after it
+    if (!last_checkpoint || last_tick != tick) {
+        InputEvent end = make_input(INPUT_CHECKPOINT);
+        end.tick = tick;
+        end.hash = hash;
+        record(end);
+    }
+    file.close();
+}
+
+//******************************************************************
+//
+//  Function:   InputRecorder::is_open
+//
+//  Purpose:    returns whether a log is being written
+//
+//  Parameters: none
+//
+//  Member/Global Variables: file
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if inputs recorded are written to a log
+//
+//  Calls:      std::ofstream::is_open
+//
+//******************************************************************
+bool InputRecorder::is_open() const {
+    return file.is_open();
+}
+
+//******************************************************************
+//
+//  Function:   InputLog::get_scenario
+//
+//  Purpose:    returns the scenario the game was set up from
+//
+//  Parameters: none
+//
+//  Member/Global Variables: scenario
+//
+//  Pre Conditions:  a log must have been loaded
+//
+//  Post Conditions: returns the scenario, with the world size the game
+//                   started on (so the replay doesn't need a window)
+//
+//  Calls:      none
+//
+//******************************************************************
+const Scenario& InputLog::get_scenario() const {
+    return scenario;
+}
+
+//******************************************************************
+//
+//  Function:   InputLog::get_tick_time
+//
+//  Purpose:    returns the delta time of every tick
+//
+//  Parameters: none
+//
+//  Member/Global Variables: tick_time
+//
+//  Pre Conditions:  a log must have been loaded
+//
+//  Post Conditions: returns the exact delta time the game was updated
+//                   with
+//
+//  Calls:      none
+//
+//******************************************************************
+float InputLog::get_tick_time() const {
+    return tick_time;
+}
+
+//******************************************************************
+//
+//  Function:   InputLog::get_inputs
+//
+//  Purpose:    returns every input of the log
+//
+//  Parameters: none
+//
+//  Member/Global Variables: inputs
+//
+//  Pre Conditions:  a log must have been loaded
+//
+//  Post Conditions: returns the inputs, in the order they were applied
+//
+//  Calls:      none
+//
+//******************************************************************
+const std::vector<InputEvent>& InputLog::get_inputs() const {
+    return inputs;
+}
+
+//******************************************************************
+//
+//  Function:   InputLog::load
+//
+//  Purpose:    reads an input log
+//
+//  Parameters: path
+//
+//  Member/Global Variables: scenario, tick_time, inputs, INPUT_LOG_MAGIC,
+//                           INPUT_LOG_VERSION
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: if the file is an input log of this version, the
+//                   scenario and inputs will be read from it (an input
+//                   cut short, by a game that didn't exit cleanly, is
+//                   left off); otherwise returns false, after printing
+//                   why to standard error
+//
+//  Calls:      std::ifstream::read, std::memcmp, default_scenario
+//
+//******************************************************************
+bool InputLog::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Unable to open input log " << path << ".\n";
+        return false;
+    }
+    uint64_t length = file.tellg();
+    file.seekg(0);
+
+    InputLogHeader header;
+    bool valid = length >= sizeof(header) && file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+                 std::memcmp(header.magic, INPUT_LOG_MAGIC, sizeof(header.magic)) == 0 &&
+                 header.version == INPUT_LOG_VERSION && header.map_length <= length - sizeof(header);
+    if (!valid) {
+        std::cerr << path << " is not a version " << INPUT_LOG_VERSION << " input log.\n";
+        return false;
+    }
+
+    scenario = default_scenario();
+    scenario.seed = header.seed;
+    scenario.bad_guys = header.bad_guys;
+    scenario.good_guys = header.good_guys;
+    scenario.trees = header.trees;
+    scenario.drops = header.drops;
+    scenario.world_size = vec2(header.world_width, header.world_height);
+    scenario.tick_rate = 1 / header.tick_time;
+    tick_time = header.tick_time;
+    scenario.tuning = header.tuning;
+    scenario.map.resize(header.map_length);
+    file.read(&scenario.map[0], header.map_length);
+
+    // the rest is whole inputs, unless the game was killed partway through writing one
+    inputs.resize((length - sizeof(header) - header.map_length) / sizeof(InputEvent));
+    file.read(reinterpret_cast<char*>(inputs.data()), inputs.size() * sizeof(InputEvent));
+    if (!file) {
+        std::cerr << "Unable to read input log " << path << ".\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,168 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        input_log.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These classes record the inputs a game is given, each
+//                 stamped with the tick it was applied before, to a
+//                 compact binary file, and read them back so the game can
+//                 be replayed without a window, checking the state of the
+//                 game against hashes recorded along the way.
+//
+//    Date:        10/16/2019
+//
+//*******************************************************************
+
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+// C/C++ Standard libraries
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "map_file.h"
+#include "scenario.h"
+#include "simulation.h"
+
+// Input log format constants
+const char INPUT_LOG_MAGIC[4] = { 'F', 'D', 'I', 'L' };  // first bytes of every input log
+const uint32_t INPUT_LOG_VERSION = 2;  // version of the layout written (logs of other versions are refused)
+const GLuint CHECKPOINT_TICKS = 600;  // ticks between the state hashes recorded
+
+// Kinds of input (what the player resolved a click or key to, not the raw event)
+const uint32_t INPUT_DROP = 0;  // food dropped at a world position
+const uint32_t INPUT_BOOST_GOOD = 1;  // good guy boosted, by index
+const uint32_t INPUT_BOOST_BAD = 2;  // bad guy slowed, by index
+const uint32_t INPUT_RESET = 3;  // new map started
+const uint32_t INPUT_SAVE = 4;  // game saved to the quick save
+const uint32_t INPUT_LOAD = 5;  // game put back to the quick save
+const uint32_t INPUT_WORLD_SIZE = 6;  // world resized (along with the window)
+const uint32_t INPUT_CHECKPOINT = 7;  // not an input, but the state hash the game had at this tick
+
+// One input, applied after tick ticks of the session were run
+struct InputEvent {
+    uint64_t tick;  // number of ticks run before the input, counting every map of the session
+    uint64_t hash;  // state hash of the game (checkpoints only)
+    double time;  // seconds since the recording started
+    uint32_t kind;  // INPUT_ kind of the input
+    uint32_t index;  // index of the unit boosted
+    float x;  // world position of the drop, or width of the world
+    float y;  // world position of the drop, or height of the world
+};
+
+// The start of an input log: the path of the map played (map_length bytes) follows
+// it, then every input in the order it was applied, all little endian
+struct InputLogHeader {
+    char magic[4];  // INPUT_LOG_MAGIC
+    uint32_t version;  // INPUT_LOG_VERSION
+    uint64_t seed;  // seed the maps were made from
+    uint32_t bad_guys;  // number of bad guys the game was made with
+    uint32_t good_guys;  // number of good guys the game was made with
+    uint32_t trees;  // number of trees the game was made with
+    uint32_t drops;  // number of drops the game was made with
+    float world_width;  // width of the world the game started on
+    float world_height;  // height of the world the game started on
+    float tick_time;  // delta time of every tick
+    uint32_t map_length;  // length of the map file path (0 if maps were made)
+    Tuning tuning;  // gameplay values
+    uint32_t checkpoint_ticks;  // ticks between checkpoints
+    uint32_t reserved;  // always 0 (keeps the header free of padding)
+};
+
+// Function to make an input of a kind, with the tick, time, and hash left for the game to fill in
+InputEvent make_input(uint32_t kind, GLuint index = 0, const vec2& pos = vec2());
+
+// Function to apply an input to a simulation, returning false if it's a checkpoint the game doesn't match
+bool apply_input(Simulation& sim, const InputEvent& input, const MapFile* map, std::vector<unsigned char>& saved);
+
+//******************************************************************
+//
+//  Class: InputRecorder
+//
+//  Purpose:  To write the inputs of a game to an input log as they're
+//            given, so that a log is usable up to the last input even if
+//            the game never exits cleanly.
+//
+//  Functions:
+//           Constructors
+//             InputRecorder() creates a recorder that isn't recording
+//           mutators
+//             open(path, scenario, tick_time)  starts a log at path of a
+//                                              game set up from scenario,
+//                                              ticking tick_time at a time
+//             record(input) stamps an input with the time and writes it
+//             close(tick, hash) finishes the log with a checkpoint of the
+//                               tick the game ended on, so a replay runs
+//                               every tick and checks where it ended up
+//           helpers
+//             is_open() returns true if a log is being written
+//
+//******************************************************************
+
+class InputRecorder {
+ public:
+    InputRecorder() : last_tick(0), last_checkpoint(false) {}
+    InputRecorder(const InputRecorder&) = delete;  // no copy constructor
+    InputRecorder operator=(const InputRecorder&) = delete;  // no copy assignment operator
+
+    // mutators
+    bool open(const std::string& path, const Scenario& scenario, float tick_time);
+    void record(InputEvent input);
+    void close(uint64_t tick, uint64_t hash);
+
+    // helpers
+    bool is_open() const;
+ private:
+    std::ofstream file;  // log being written
+    std::chrono::steady_clock::time_point start;  // when the recording started
+    uint64_t last_tick;  // tick of the last input recorded
+    bool last_checkpoint;  // whether the last input recorded was a checkpoint
+};
+
+//******************************************************************
+//
+//  Class: InputLog
+//
+//  Purpose:  To hold a recorded input log: the scenario the game was
+//            set up from and every input it was given, in order.
+//
+//  Functions:
+//           Constructors
+//             InputLog() creates an empty log
+//           getters
+//             get_scenario to return the scenario the game was set up from
+//             get_tick_time to return the delta time of every tick
+//             get_inputs to return every input, in the order applied
+//           mutators
+//             load(path) reads the log at path
+//
+//******************************************************************
+
+class InputLog {
+ public:
+    InputLog() : scenario(default_scenario()), tick_time(1 / DEFAULT_TICK_RATE) {}
+
+    // getters
+    const Scenario& get_scenario() const;
+    float get_tick_time() const;
+    const std::vector<InputEvent>& get_inputs() const;
+
+    // mutators
+    bool load(const std::string& path);
+ private:
+    Scenario scenario;  // scenario the game was set up from
+    float tick_time;  // delta time of every tick
+    std::vector<InputEvent> inputs;  // every input, in the order applied
+};
+
+#endif
@@ -0,0 +1,351 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        map_file.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class reads maps saved in the game's binary map
+//                 format by mapping the file into memory, so that a map
+//                 of any size can be loaded without parsing it, along
+//                 with the function that writes them.
+//
+//    Date:        10/15/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Source libraries
+#include "map_file.h"
+
+// sections are copied straight into vec2 arrays, so a vec2 has to be exactly two floats
+static_assert(sizeof(vec2) == 2 * sizeof(float), "vec2 must be two packed floats to be mapped from a file");
+static_assert(sizeof(MapHeader) % MAP_ALIGNMENT == 0, "the first section must start aligned");
+
+// Number of sections following the header
+const GLuint MAP_SECTIONS = 6;
+
+//******************************************************************
+//
+//  Function:   pad
+//
+//  Purpose:    rounds a section size up to a whole number of alignments
+//
+//  Parameters: bytes
+//
+//  Member/Global Variables: MAP_ALIGNMENT
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the smallest multiple of MAP_ALIGNMENT that
+//                   is at least bytes
+//
+//  Calls:      none
+//
+//******************************************************************
+static uint64_t pad(uint64_t bytes) {
+    return (bytes + MAP_ALIGNMENT - 1) / MAP_ALIGNMENT * MAP_ALIGNMENT;
+}
+
+//******************************************************************
+//
+//  Function:   lay_out
+//
+//  Purpose:    works out where each section of a map file starts
+//
+//  Parameters: trees, bad_guys, good_guys, offsets
+//
+//  Member/Global Variables: MAP_SECTIONS
+//
+//  Pre Conditions:  offsets must hold MAP_SECTIONS + 1 values
+//
+//  Post Conditions: offsets will hold the byte offset of each section,
+//                   in file order, followed by the size of the file
+//
+//  Calls:      pad
+//
+//******************************************************************
+static void lay_out(uint64_t trees, uint64_t bad_guys, uint64_t good_guys, uint64_t* offsets) {
+    uint64_t sizes[MAP_SECTIONS] = {
+        trees * sizeof(vec2), trees * sizeof(float),
+        bad_guys * sizeof(vec2), bad_guys * sizeof(float),
+        good_guys * sizeof(vec2), good_guys * sizeof(float)
+    };
+    offsets[0] = sizeof(MapHeader);
+    for (GLuint i = 0; i < MAP_SECTIONS; ++i) {
+        offsets[i + 1] = offsets[i] + pad(sizes[i]);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   write_map
+//
+//  Purpose:    writes a map to a file in the binary map format
+//
+//  Parameters: path, map
+//
+//  Member/Global Variables: MAP_MAGIC, MAP_VERSION, MAP_SECTIONS
+//
+//  Pre Conditions:  every array of map must hold as many values as its
+//                   count says
+//
+//  Post Conditions: the file at path will hold the map; returns false,
+//                   after printing why to standard error, if it
+//                   couldn't be written
+//
+//  Calls:      lay_out, std::memcpy, std::ofstream::write
+//
+//******************************************************************
+bool write_map(const std::string& path, const MapView& map) {
+    uint64_t offsets[MAP_SECTIONS + 1];
+    lay_out(map.num_trees, map.num_bad_guys, map.num_good_guys, offsets);
+
+    MapHeader header;
+    std::memcpy(header.magic, MAP_MAGIC, sizeof(header.magic));
+    header.version = MAP_VERSION;
+    header.seed = map.seed;
+    header.map_index = map.map_index;
+    header.world_width = map.world_size.x;
+    header.world_height = map.world_size.y;
+    header.drops = map.drops;
+    header.num_trees = map.num_trees;
+    header.num_bad_guys = map.num_bad_guys;
+    header.num_good_guys = map.num_good_guys;
+    header.file_size = offsets[MAP_SECTIONS];
+
+    const void* sections[MAP_SECTIONS] = {
+        map.tree_positions, map.tree_radii,
+        map.bad_positions, map.bad_rotations,
+        map.good_positions, map.good_rotations
+    };
+    uint64_t sizes[MAP_SECTIONS] = {
+        map.num_trees * sizeof(vec2), map.num_trees * sizeof(float),
+        map.num_bad_guys * sizeof(vec2), map.num_bad_guys * sizeof(float),
+        map.num_good_guys * sizeof(vec2), map.num_good_guys * sizeof(float)
+    };
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const char padding[MAP_ALIGNMENT] = {};
+    for (GLuint i = 0; i < MAP_SECTIONS; ++i) {
+        file.write(static_cast<const char*>(sections[i]), sizes[i]);
+        file.write(padding, offsets[i + 1] - offsets[i] - sizes[i]);
+    }
+
+    if (!file) {
+        std::cerr << "Unable to write map file " << path << ".\n";
+        return false;
+    }
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   MapFile::~MapFile
+//
+//  Purpose:    closes the map file
+//
+//  Parameters: none
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the file will have been unmapped
+//
+//  Calls:      close
+//
+//******************************************************************
+MapFile::~MapFile() {
+    close();
+}
+
+//******************************************************************
+//
+//  Function:   MapFile::get_view
+//
+//  Purpose:    returns the objects of the open map
+//
+//  Parameters: none
+//
+//  Member/Global Variables: view
+//
+//  Pre Conditions:  a map must be open
+//
+//  Post Conditions: returns the map's objects, whose arrays stay valid
+//                   until the file is closed
+//
+//  Calls:      none
+//
+//******************************************************************
+const MapView& MapFile::get_view() const {
+    return view;
+}
+
+//******************************************************************
+//
+//  Function:   MapFile::open
+//
+//  Purpose:    maps a map file into memory and checks that it's whole
+//
+//  Parameters: path
+//
+//  Member/Global Variables: data, length, view, buffer, MAP_MAGIC,
+//                           MAP_VERSION, MAP_SECTIONS, MAX_WORLD_SIZE
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: if the file is a map of this version whose size
+//                   matches its header, and whose world is above 0 and
+//                   no bigger than MAX_WORLD_SIZE each way, it will be
+//                   open and its view will point into it; otherwise
+//                   returns false, after printing why to standard
+//                   error, with nothing open
+//
+//  Calls:      close, mmap, std::memcmp, lay_out
+//
+//******************************************************************
+bool MapFile::open(const std::string& path) {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        std::cerr << "Unable to open map file " << path << ".\n";
+        return false;
+    }
+    length = info.st_size;
+    void* mapped = length > 0 ? mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    ::close(fd);  // the mapping keeps the file open
+    if (mapped == MAP_FAILED) {
+        length = 0;
+        std::cerr << "Unable to map map file " << path << " into memory.\n";
+        return false;
+    }
+    data = static_cast<const unsigned char*>(mapped);
+#else
+    // no mmap here, so the file is read into memory in one go instead
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Unable to open map file " << path << ".\n";
+        return false;
+    }
+    buffer.resize(file.tellg());
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+    data = buffer.data();
+    length = buffer.size();
+#endif
+
+    // only the header is read: its counts say exactly where every section is
+    MapHeader header;
+    if (length >= sizeof(header)) {
+        std::memcpy(&header, data, sizeof(header));
+    }
+    uint64_t offsets[MAP_SECTIONS + 1];
+    bool valid = length >= sizeof(header) && std::memcmp(header.magic, MAP_MAGIC, sizeof(header.magic)) == 0 &&
+                 header.version == MAP_VERSION;
+    if (valid) {
+        lay_out(header.num_trees, header.num_bad_guys, header.num_good_guys, offsets);
+        valid = header.file_size == length && offsets[MAP_SECTIONS] == length;
+    }
+    if (!valid) {
+        close();
+        std::cerr << path << " is not a version " << MAP_VERSION << " map file.\n";
+        return false;
+    }
+
+    // the world is sized from the header alone, so it's held to the same bounds as a scenario's
+    // (written this way round so NaN fails too)
+    if (!(header.world_width > 0 && header.world_width <= MAX_WORLD_SIZE &&
+          header.world_height > 0 && header.world_height <= MAX_WORLD_SIZE)) {
+        close();
+        std::cerr << path << " has a world size of " << header.world_width << " by " << header.world_height
+                  << ", which isn't above 0 and at most " << MAX_WORLD_SIZE << ".\n";
+        return false;
+    }
+
+    view.seed = header.seed;
+    view.map_index = header.map_index;
+    view.world_size = vec2(header.world_width, header.world_height);
+    view.drops = header.drops;
+    view.num_trees = header.num_trees;
+    view.tree_positions = reinterpret_cast<const vec2*>(data + offsets[0]);
+    view.tree_radii = reinterpret_cast<const float*>(data + offsets[1]);
+    view.num_bad_guys = header.num_bad_guys;
+    view.bad_positions = reinterpret_cast<const vec2*>(data + offsets[2]);
+    view.bad_rotations = reinterpret_cast<const float*>(data + offsets[3]);
+    view.num_good_guys = header.num_good_guys;
+    view.good_positions = reinterpret_cast<const vec2*>(data + offsets[4]);
+    view.good_rotations = reinterpret_cast<const float*>(data + offsets[5]);
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   MapFile::close
+//
+//  Purpose:    unmaps the open map file
+//
+//  Parameters: none
+//
+//  Member/Global Variables: data, length, view, buffer
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: no map will be open, and views of it are no longer
+//                   valid
+//
+//  Calls:      munmap
+//
+//******************************************************************
+void MapFile::close() {
+#ifndef _WIN32
+    if (data != nullptr) {
+        munmap(const_cast<unsigned char*>(data), length);
+    }
+#else
+    buffer.clear();
+#endif
+    data = nullptr;
+    length = 0;
+    view = MapView();
+}
+
+//******************************************************************
+//
+//  Function:   MapFile::is_open
+//
+//  Purpose:    returns whether a map is open
+//
+//  Parameters: none
+//
+//  Member/Global Variables: data
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if a map file is mapped
+//
+//  Calls:      none
+//
+//******************************************************************
+bool MapFile::is_open() const {
+    return data != nullptr;
+}
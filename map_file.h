@@ -0,0 +1,122 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        map_file.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class reads maps saved in the game's binary map
+//                 format by mapping the file into memory, so that a map
+//                 of any size can be loaded without parsing it, along
+//                 with the function that writes them.
+//
+//    Date:        10/15/2019
+//
+//*******************************************************************
+
+#ifndef MAP_FILE_H
+#define MAP_FILE_H
+
+// C/C++ Standard libraries
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Map format constants
+const char MAP_MAGIC[4] = { 'F', 'D', 'M', 'P' };  // first bytes of every map file
+const uint32_t MAP_VERSION = 1;  // version of the layout written (files of other versions are refused)
+const size_t MAP_ALIGNMENT = 8;  // every section starts on a multiple of this many bytes
+
+// Widest and tallest a world can be, whether it comes from a map or a scenario (the grids
+// laid over a world grow with it, so bigger ones are refused up front)
+const float MAX_WORLD_SIZE = 100000;
+
+// The start of a map file: every section follows it in the order listed, each padded to
+// MAP_ALIGNMENT bytes (tree positions, tree radii, bad guy positions, bad guy rotations,
+// good guy positions, good guy rotations), all little endian
+struct MapHeader {
+    char magic[4];  // MAP_MAGIC
+    uint32_t version;  // MAP_VERSION
+    uint64_t seed;  // seed the map was made from
+    uint64_t map_index;  // number of maps made from the seed before this one
+    float world_width;  // width of the world the map covers
+    float world_height;  // height of the world the map covers
+    uint32_t drops;  // drops the player has left
+    uint32_t num_trees;  // number of trees
+    uint32_t num_bad_guys;  // number of bad guys
+    uint32_t num_good_guys;  // number of good guys
+    uint64_t file_size;  // size of the whole file in bytes
+};
+
+// A map's objects, as arrays owned by whatever the view was made from
+struct MapView {
+    uint64_t seed;  // seed the map was made from
+    uint64_t map_index;  // number of maps made from the seed before this one
+    vec2 world_size;  // size of the world the map covers
+    GLuint drops;  // drops the player has left
+    GLuint num_trees;  // number of trees
+    const vec2* tree_positions;  // position of each tree
+    const float* tree_radii;  // radius of each tree
+    GLuint num_bad_guys;  // number of bad guys
+    const vec2* bad_positions;  // position of each bad guy
+    const float* bad_rotations;  // rotation of each bad guy
+    GLuint num_good_guys;  // number of good guys
+    const vec2* good_positions;  // position of each good guy
+    const float* good_rotations;  // rotation of each good guy
+};
+
+// Function to write a map to a file in the binary map format, returning false if it couldn't be
+bool write_map(const std::string& path, const MapView& map);
+
+//******************************************************************
+//
+//  Class: MapFile
+//
+//  Purpose:  To hold an open map file, mapped into memory, and give a
+//            view of its objects that points straight into the mapping.
+//            Opening one only checks the header and section sizes, so it
+//            takes the same time for a map of any size.
+//
+//  Functions:
+//           Constructors
+//             MapFile() creates a map file that isn't open
+//             ~MapFile() closes the file
+//           getters
+//             get_view to return the objects of the open map
+//           mutators
+//             open(path) maps the file at path into memory and checks it
+//             close() unmaps the file
+//           helpers
+//             is_open() returns true if a map is open
+//
+//******************************************************************
+
+class MapFile {
+ public:
+    MapFile() : data(nullptr), length(0), view() {}
+    ~MapFile();
+    MapFile(const MapFile&) = delete;  // no copy constructor
+    MapFile operator=(const MapFile&) = delete;  // no copy assignment operator
+
+    // getters
+    const MapView& get_view() const;
+
+    // mutators
+    bool open(const std::string& path);
+    void close();
+
+    // helpers
+    bool is_open() const;
+ private:
+    const unsigned char* data;  // start of the mapped file
+    size_t length;  // number of bytes mapped
+    MapView view;  // objects of the map, pointing into data
+    std::vector<unsigned char> buffer;  // the file's bytes, where files can't be mapped into memory
+};
+
+#endif
@@ -0,0 +1,350 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        phase_timer.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These classes time the phases of a tick and of a frame
+//                 (the plane, food, and units updates, drawing, and
+//                 clicks) into latency histograms that keep every
+//                 duration to within a few percent, so the median, tail,
+//                 and worst case of each phase can be printed at any
+//                 time without storing every sample.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+// Source libraries
+#include "phase_timer.h"
+
+//******************************************************************
+//
+//  Function:   LatencyHistogram::get_count
+//
+//  Purpose:    returns the number of durations counted
+//
+//  Parameters: none
+//
+//  Member/Global Variables: count
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the number of durations counted since the
+//                   histogram was made or cleared
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t LatencyHistogram::get_count() const {
+    return count;
+}
+
+//******************************************************************
+//
+//  Function:   LatencyHistogram::get_max
+//
+//  Purpose:    returns the longest duration counted
+//
+//  Parameters: none
+//
+//  Member/Global Variables: max
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the longest duration counted in nanoseconds
+//                   (exactly, not its bucket), or 0 if there are none
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t LatencyHistogram::get_max() const {
+    return max;
+}
+
+//******************************************************************
+//
+//  Function:   LatencyHistogram::get_mean
+//
+//  Purpose:    returns the average duration counted
+//
+//  Parameters: none
+//
+//  Member/Global Variables: count, total
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the average duration counted in nanoseconds,
+//                   or 0 if there are none
+//
+//  Calls:      none
+//
+//******************************************************************
+double LatencyHistogram::get_mean() const {
+    return count > 0 ? total / count : 0;
+}
+
+//******************************************************************
+//
+//  Function:   LatencyHistogram::record
+//
+//  Purpose:    counts a duration
+//
+//  Parameters: ns
+//
+//  Member/Global Variables: buckets, count, max, total
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the duration will have been counted in its bucket
+//                   (without allocating)
+//
+//  Calls:      get_bucket, std::max
+//
+//******************************************************************
+void LatencyHistogram::record(uint64_t ns) {
+    buckets[get_bucket(ns)]++;
+    count++;
+    max = std::max(max, ns);
+    total += ns;
+}
+
+//******************************************************************
+//
+//  Function:   LatencyHistogram::clear
+//
+//  Purpose:    forgets every duration counted
+//
+//  Parameters: none
+//
+//  Member/Global Variables: buckets, count, max, total
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the histogram will be empty
+//
+//  Calls:      std::fill
+//
+//******************************************************************
+void LatencyHistogram::clear() {
+    std::fill(buckets.begin(), buckets.end(), 0);
+    count = 0;
+    max = 0;
+    total = 0;
+}
+
+//******************************************************************
+//
+//  Function:   LatencyHistogram::get_percentile
+//
+//  Purpose:    returns the duration that a percent of the durations
+//              counted are no longer than
+//
+//  Parameters: percent
+//
+//  Member/Global Variables: buckets, count, max
+//
+//  Pre Conditions:  percent must be from 0 to 100
+//
+//  Post Conditions: returns the longest duration of the bucket holding
+//                   the percentile (so it's never under the true one,
+//                   and over it by about 3% at most), or 0 if there are
+//                   no durations
+//
+//  Calls:      std::ceil, std::max, std::min, get_bucket_high
+//
+//******************************************************************
+uint64_t LatencyHistogram::get_percentile(double percent) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    // the percentile is the duration of the rank'th shortest one
+    uint64_t rank = std::max<uint64_t>(std::ceil(percent / 100 * count), 1);
+    uint64_t seen = 0;
+    for (GLuint bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            return std::min(get_bucket_high(bucket), max);
+        }
+    }
+    return max;
+}
+
+//******************************************************************
+//
+//  Function:   LatencyHistogram::get_bucket
+//
+//  Purpose:    returns the bucket a duration is counted in
+//
+//  Parameters: ns
+//
+//  Member/Global Variables: SUB_BUCKET_BITS, SUB_BUCKETS
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the duration itself if it's below
+//                   SUB_BUCKETS, otherwise one of SUB_BUCKETS buckets
+//                   splitting the power of two it's in
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint LatencyHistogram::get_bucket(uint64_t ns) {
+    if (ns < SUB_BUCKETS) {
+        return ns;
+    }
+
+    // find the highest set bit, then keep the SUB_BUCKET_BITS below it
+    GLuint high_bit = SUB_BUCKET_BITS;
+    while (high_bit < 63 && (ns >> (high_bit + 1)) != 0) {
+        high_bit++;
+    }
+    GLuint shift = high_bit - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((ns >> shift) - SUB_BUCKETS);
+}
+
+//******************************************************************
+//
+//  Function:   LatencyHistogram::get_bucket_high
+//
+//  Purpose:    returns the longest duration counted in a bucket
+//
+//  Parameters: bucket
+//
+//  Member/Global Variables: SUB_BUCKETS
+//
+//  Pre Conditions:  bucket must be below HISTOGRAM_BUCKETS
+//
+//  Post Conditions: returns the longest duration get_bucket puts in the
+//                   bucket
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t LatencyHistogram::get_bucket_high(GLuint bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+
+    GLuint shift = bucket / SUB_BUCKETS - 1;
+    uint64_t low = static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return low + ((static_cast<uint64_t>(1) << shift) - 1);
+}
+
+//******************************************************************
+//
+//  Function:   PhaseTimers::get_histogram
+//
+//  Purpose:    returns the histogram of a phase
+//
+//  Parameters: phase
+//
+//  Member/Global Variables: histograms
+//
+//  Pre Conditions:  phase must be below NUM_PHASES
+//
+//  Post Conditions: returns the histogram of every duration counted for
+//                   the phase
+//
+//  Calls:      none
+//
+//******************************************************************
+const LatencyHistogram& PhaseTimers::get_histogram(GLuint phase) const {
+    return histograms[phase];
+}
+
+//******************************************************************
+//
+//  Function:   PhaseTimers::record
+//
+//  Purpose:    counts a duration of a phase
+//
+//  Parameters: phase, ns
+//
+//  Member/Global Variables: histograms
+//
+//  Pre Conditions:  phase must be below NUM_PHASES
+//
+//  Post Conditions: the duration will have been counted in the phase's
+//                   histogram
+//
+//  Calls:      LatencyHistogram::record
+//
+//******************************************************************
+void PhaseTimers::record(GLuint phase, uint64_t ns) {
+    histograms[phase].record(ns);
+}
+
+//******************************************************************
+//
+//  Function:   PhaseTimers::clear
+//
+//  Purpose:    forgets every duration counted
+//
+//  Parameters: none
+//
+//  Member/Global Variables: histograms
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every phase's histogram will be empty
+//
+//  Calls:      LatencyHistogram::clear
+//
+//******************************************************************
+void PhaseTimers::clear() {
+    for (LatencyHistogram& histogram : histograms) {
+        histogram.clear();
+    }
+}
+
+//******************************************************************
+//
+//  Function:   PhaseTimers::dump
+//
+//  Purpose:    prints how long every phase took
+//
+//  Parameters: out
+//
+//  Member/Global Variables: histograms, PHASE_NAMES, NUM_PHASES
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: a table of the count, mean, median, 99th percentile,
+//                   and longest duration of every phase that was timed,
+//                   in microseconds, will have been printed to out
+//
+//  Calls:      LatencyHistogram::get_count, LatencyHistogram::get_mean,
+//              LatencyHistogram::get_percentile, LatencyHistogram::get_max,
+//              std::setw
+//
+//******************************************************************
+void PhaseTimers::dump(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+
+    out << std::left << std::setw(12) << "phase" << std::right << std::setw(10) << "count" << std::setw(12) << "mean us"
+        << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::setw(12) << "max us" << "\n";
+    for (GLuint phase = 0; phase < NUM_PHASES; ++phase) {
+        const LatencyHistogram& histogram = histograms[phase];
+        if (histogram.get_count() == 0) {
+            continue;
+        }
+        out << std::left << std::setw(12) << PHASE_NAMES[phase] << std::right << std::setw(10) << histogram.get_count()
+            << std::setw(12) << histogram.get_mean() / 1000 << std::setw(12) << histogram.get_percentile(50) / 1000.0
+            << std::setw(12) << histogram.get_percentile(99) / 1000.0 << std::setw(12) << histogram.get_max() / 1000.0
+            << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,185 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        phase_timer.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These classes time the phases of a tick and of a frame
+//                 (the plane, food, and units updates, drawing, and
+//                 clicks) into latency histograms that keep every
+//                 duration to within a few percent, so the median, tail,
+//                 and worst case of each phase can be printed at any
+//                 time without storing every sample.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+// C/C++ Standard libraries
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Histogram constants (durations below 2^SUB_BUCKET_BITS nanoseconds are exact, longer
+// ones share a bucket with those within 1 / 2^SUB_BUCKET_BITS of them)
+const GLuint SUB_BUCKET_BITS = 5;  // bits of each duration kept below its highest set bit
+const GLuint SUB_BUCKETS = 1 << SUB_BUCKET_BITS;  // buckets per power of two
+const GLuint HISTOGRAM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;  // buckets covering every 64 bit duration
+
+// Phases that are timed
+const GLuint PHASE_TICK = 0;  // one whole simulation update
+const GLuint PHASE_PLANE = 1;  // moving the plane and dropping food
+const GLuint PHASE_FOOD = 2;  // rotting and removing food drops
+const GLuint PHASE_BAD_GUYS = 3;  // targeting, moving, and feeding the bad guys
+const GLuint PHASE_GOOD_GUYS = 4;  // targeting, moving, and feeding the good guys
+const GLuint PHASE_DISPLAY = 5;  // drawing a frame
+const GLuint PHASE_CLICK = 6;  // handling a click, selection drawing included
+const GLuint NUM_PHASES = 7;  // number of phases timed
+
+// Names phases are printed with, by phase
+constexpr char const* PHASE_NAMES[NUM_PHASES] = {
+    "tick", "plane", "food", "bad guys", "good guys", "display", "click"
+};
+
+//******************************************************************
+//
+//  Class: LatencyHistogram
+//
+//  Purpose:  To count durations in buckets that grow with the duration
+//            (32 per power of two), so that any percentile is known to
+//            within about 3% in fixed memory, however many are counted.
+//
+//  Functions:
+//           Constructors
+//             LatencyHistogram() creates an empty histogram
+//           getters
+//             get_count to return the number of durations counted
+//             get_max to return the longest duration counted
+//             get_mean to return the average duration counted
+//           mutators
+//             record(ns) counts a duration of ns nanoseconds
+//             clear() forgets every duration counted
+//           helpers
+//             get_percentile(percent) returns the duration that percent
+//                                     of the durations are no longer than
+//           private helpers
+//             get_bucket(ns) returns the bucket a duration is counted in
+//             get_bucket_high(bucket) returns the longest duration
+//                                     counted in a bucket
+//
+//******************************************************************
+
+class LatencyHistogram {
+ public:
+    LatencyHistogram() : buckets(HISTOGRAM_BUCKETS, 0), count(0), max(0), total(0) {}
+
+    // getters
+    uint64_t get_count() const;
+    uint64_t get_max() const;
+    double get_mean() const;
+
+    // mutators
+    void record(uint64_t ns);
+    void clear();
+
+    // helpers
+    uint64_t get_percentile(double percent) const;
+ private:
+    std::vector<uint64_t> buckets;  // number of durations counted in each bucket
+    uint64_t count;  // number of durations counted
+    uint64_t max;  // longest duration counted
+    double total;  // sum of every duration counted
+
+    // private helpers
+    static GLuint get_bucket(uint64_t ns);
+    static uint64_t get_bucket_high(GLuint bucket);
+};
+
+//******************************************************************
+//
+//  Class: PhaseTimers
+//
+//  Purpose:  To keep a latency histogram for every phase, and print
+//            them all as one table.
+//
+//  Functions:
+//           Constructors
+//             PhaseTimers() creates timers that have counted nothing
+//           getters
+//             get_histogram(phase) returns the histogram of a phase
+//           mutators
+//             record(phase, ns) counts a duration of a phase
+//             clear() forgets every duration counted
+//           helpers
+//             dump(out) prints the count, median, 99th percentile, and
+//                       longest duration of every phase to out
+//
+//******************************************************************
+
+class PhaseTimers {
+ public:
+    PhaseTimers() : histograms(NUM_PHASES) {}
+
+    // getters
+    const LatencyHistogram& get_histogram(GLuint phase) const;
+
+    // mutators
+    void record(GLuint phase, uint64_t ns);
+    void clear();
+
+    // helpers
+    void dump(std::ostream& out) const;
+ private:
+    std::vector<LatencyHistogram> histograms;  // histogram of every phase
+};
+
+//******************************************************************
+//
+//  Class: ScopedTimer
+//
+//  Purpose:  To time the scope it lives in as one duration of a phase.
+//            It does nothing (not even read the clock) if it's given no
+//            timers, so timing can be left in everywhere.
+//
+//  Functions:
+//           Constructors
+//             ScopedTimer() = delete
+//             ScopedTimer(timers, phase) starts timing a phase, counted in
+//                                        timers (which may be null)
+//           Destructor
+//             ~ScopedTimer() counts the time since it was made
+//
+//******************************************************************
+
+class ScopedTimer {
+ public:
+    ScopedTimer() = delete;  // no default constructor
+    ScopedTimer(PhaseTimers* timers, GLuint phase) : timers(timers), phase(phase) {
+        if (timers != nullptr) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+    ScopedTimer(const ScopedTimer&) = delete;  // no copy constructor
+    ScopedTimer operator=(const ScopedTimer&) = delete;  // no copy assignment operator
+    ~ScopedTimer() {
+        if (timers != nullptr) {
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+            timers->record(phase, elapsed.count());
+        }
+    }
+ private:
+    PhaseTimers* timers;  // where the time is counted, or null to not time it (not owned)
+    GLuint phase;  // phase the time is counted as
+    std::chrono::steady_clock::time_point start;  // when timing started
+};
+
+#endif
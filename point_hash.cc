@@ -0,0 +1,170 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        point_hash.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a spatial hash of points (food
+//                 drops, or units) that is rebuilt whenever they change,
+//                 so that only the points near a position need to be
+//                 considered.
+//
+//    Date:        10/8/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+
+// Source libraries
+#include "point_hash.h"
+
+//******************************************************************
+//
+//  Function:   PointHash::build
+//
+//  Purpose:    rebuilds the hash from the given positions
+//
+//  Parameters: positions, size
+//
+//  Member/Global Variables: cell_size, mask, bucket_start, bucket_fill,
+//                           entries, entry_cols, entry_rows
+//
+//  Pre Conditions:  size must be greater than 0
+//
+//  Post Conditions: every point will be stored in the bucket of the
+//                   cell containing its position
+//
+//  Calls:      cell_coord, bucket_of
+//
+//******************************************************************
+void PointHash::build(const std::vector<vec2>& positions, float size) {
+    cell_size = size;
+
+    // use a power of two number of buckets, at least twice the number of points
+    GLuint buckets = 1;
+    while (buckets < positions.size() * 2) {
+        buckets <<= 1;
+    }
+    mask = buckets - 1;
+
+    // count how many points land in each bucket (offset by one for the prefix sum)
+    bucket_start.assign(buckets + 1, 0);
+    for (GLuint i = 0; i < positions.size(); ++i) {
+        vec2 pos = positions[i];
+        bucket_start[bucket_of(cell_coord(pos.x), cell_coord(pos.y)) + 1]++;
+    }
+
+    // turn counts into starting indices
+    for (GLuint i = 0; i < buckets; ++i) {
+        bucket_start[i + 1] += bucket_start[i];
+    }
+
+    // fill in each bucket's points, in ascending order
+    entries.resize(positions.size());
+    entry_cols.resize(positions.size());
+    entry_rows.resize(positions.size());
+    bucket_fill.assign(bucket_start.begin(), bucket_start.end() - 1);  // next free slot of each bucket
+    for (GLuint i = 0; i < positions.size(); ++i) {
+        vec2 pos = positions[i];
+        int col = cell_coord(pos.x);
+        int row = cell_coord(pos.y);
+        GLuint slot = bucket_fill[bucket_of(col, row)]++;
+        entries[slot] = i;
+        entry_cols[slot] = col;
+        entry_rows[slot] = row;
+    }
+}
+
+//******************************************************************
+//
+//  Function:   PointHash::query
+//
+//  Purpose:    finds the points in the cells within radius of pos
+//
+//  Parameters: pos, radius, result
+//
+//  Member/Global Variables: bucket_start, entries, entry_cols, entry_rows
+//
+//  Pre Conditions:  the hash must have been built
+//
+//  Post Conditions: result will contain the index of every point whose
+//                   cell overlaps the square of half width radius
+//                   around pos (a superset of the points within radius),
+//                   each once and in ascending order
+//
+//  Calls:      cell_coord, bucket_of, std::sort
+//
+//******************************************************************
+void PointHash::query(const vec2& pos, float radius, std::vector<GLuint>& result) const {
+    result.clear();
+    if (entries.size() == 0) {
+        return;
+    }
+
+    int min_col = cell_coord(pos.x - radius);
+    int max_col = cell_coord(pos.x + radius);
+    int min_row = cell_coord(pos.y - radius);
+    int max_row = cell_coord(pos.y + radius);
+    for (int row = min_row; row <= max_row; ++row) {
+        for (int col = min_col; col <= max_col; ++col) {
+            GLuint bucket = bucket_of(col, row);
+            for (GLuint i = bucket_start[bucket]; i < bucket_start[bucket + 1]; ++i) {
+                // other cells can share this bucket, so only take this cell's points
+                if (entry_cols[i] == col && entry_rows[i] == row) {
+                    result.push_back(entries[i]);
+                }
+            }
+        }
+    }
+
+    // callers rely on points being visited in the same order as a full scan
+    std::sort(result.begin(), result.end());
+}
+
+//******************************************************************
+//
+//  Function:   PointHash::cell_coord
+//
+//  Purpose:    returns the cell coordinate of a position component
+//
+//  Parameters: value
+//
+//  Member/Global Variables: cell_size
+//
+//  Pre Conditions:  cell_size must be greater than 0
+//
+//  Post Conditions: returns floor(value / cell_size)
+//
+//  Calls:      std::floor
+//
+//******************************************************************
+int PointHash::cell_coord(float value) const {
+    return static_cast<int>(std::floor(value / cell_size));
+}
+
+//******************************************************************
+//
+//  Function:   PointHash::bucket_of
+//
+//  Purpose:    returns the table bucket of a cell
+//
+//  Parameters: col, row
+//
+//  Member/Global Variables: mask
+//
+//  Pre Conditions:  the hash must have been built
+//
+//  Post Conditions: returns a bucket index in the range [0, mask]
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint PointHash::bucket_of(int col, int row) const {
+    // large primes spread neighbouring cells across the table
+    GLuint hash = static_cast<GLuint>(col) * 73856093u ^ static_cast<GLuint>(row) * 19349663u;
+    return hash & mask;
+}
@@ -0,0 +1,78 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        point_hash.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a spatial hash of points (food
+//                 drops, or units) that is rebuilt whenever they change,
+//                 so that only the points near a position need to be
+//                 considered.
+//
+//    Date:        10/8/2019
+//
+//*******************************************************************
+
+#ifndef POINT_HASH_H
+#define POINT_HASH_H
+
+// C/C++ Standard libraries
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+//******************************************************************
+//
+//  Class: PointHash
+//
+//  Purpose:  To bucket points by the square cell they fall in, so that
+//            the points within a radius of a position can be found
+//            without scanning every point. Cells are hashed into a table
+//            sized to the number of points, so the world can be any size.
+//
+//  Functions:
+//           Constructors
+//             PointHash() creates an empty hash
+//           mutators
+//             build(positions, size) rebuilds the hash from the given
+//                                    positions, with cells of the
+//                                    given size
+//           helpers
+//             query(pos, radius, result) fills result with the indices of
+//                                        the points in the cells within
+//                                        radius of pos, in ascending order
+//           private helpers
+//             cell_coord(value) returns the cell coordinate of a position
+//                               component
+//             bucket_of(col, row) returns the table bucket of a cell
+//
+//******************************************************************
+
+class PointHash {
+ public:
+    PointHash() : cell_size(1), mask(0) {}
+
+    // mutators
+    void build(const std::vector<vec2>& positions, float size);
+
+    // helpers
+    void query(const vec2& pos, float radius, std::vector<GLuint>& result) const;
+ private:
+    float cell_size;  // width and height of a cell
+    GLuint mask;  // number of buckets minus one (bucket count is a power of two)
+
+    std::vector<GLuint> bucket_start;  // index into entries where each bucket's points begin
+    std::vector<GLuint> bucket_fill;  // next free slot of each bucket while building (kept to reuse memory)
+    std::vector<GLuint> entries;  // point indices, grouped by bucket
+    std::vector<int> entry_cols;  // cell column of each entry
+    std::vector<int> entry_rows;  // cell row of each entry
+
+    // private helpers
+    int cell_coord(float value) const;
+    GLuint bucket_of(int col, int row) const;
+};
+
+#endif
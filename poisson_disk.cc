@@ -0,0 +1,260 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        poisson_disk.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class scatters circles of random sizes over a box
+//                 so that no two of them come closer than a clearance
+//                 and all of them are spread evenly, using Bridson's
+//                 Poisson-disk sampling over a background grid, so maps
+//                 are made in time linear in the number of trees.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Source libraries
+#include "poisson_disk.h"
+#include "utilities.h"
+
+//******************************************************************
+//
+//  Function:   PoissonDisk::size
+//
+//  Purpose:    returns the number of circles placed
+//
+//  Parameters: none
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the number of circles the last scatter
+//                   placed
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint PoissonDisk::size() const {
+    return positions.size();
+}
+
+//******************************************************************
+//
+//  Function:   PoissonDisk::get_position
+//
+//  Purpose:    returns the center of a circle
+//
+//  Parameters: i
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  i must be below size()
+//
+//  Post Conditions: returns the center of circle i
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 PoissonDisk::get_position(GLuint i) const {
+    return positions[i];
+}
+
+//******************************************************************
+//
+//  Function:   PoissonDisk::get_radius
+//
+//  Purpose:    returns the radius of a circle
+//
+//  Parameters: i
+//
+//  Member/Global Variables: radii
+//
+//  Pre Conditions:  i must be below size()
+//
+//  Post Conditions: returns the radius of circle i
+//
+//  Calls:      none
+//
+//******************************************************************
+float PoissonDisk::get_radius(GLuint i) const {
+    return radii[i];
+}
+
+//******************************************************************
+//
+//  Function:   PoissonDisk::scatter
+//
+//  Purpose:    places circles of random sizes evenly over a box
+//
+//  Parameters: random, count, min_radius, max_radius, clear, low, high
+//
+//  Member/Global Variables: positions, radii, grid, active, origin,
+//                           cell_size, cols, rows, reach, spacing,
+//                           clearance, CANDIDATES, SPREAD, NUDGE
+//
+//  Pre Conditions:  min_radius must not be negative or above max_radius,
+//                   and clear must not be negative
+//
+//  Post Conditions: up to count circles will have been placed (fewer if
+//                   no more fit), in random order, centered inside the
+//                   box, with the edges of every two at least clear
+//                   apart; the same random numbers always place the
+//                   same circles
+//
+//  Calls:      RandomStream::next, RandomStream::fill, fits, add,
+//              std::sqrt, std::ceil, std::cos, std::sin, std::max,
+//              std::min, std::swap
+//
+//******************************************************************
+void PoissonDisk::scatter(RandomStream& random, GLuint count, float min_radius, float max_radius, float clear,
+                          const vec2& low, const vec2& high) {
+    positions.clear();
+    radii.clear();
+    active.clear();
+    vec2 extent = high - low;
+    if (count == 0 || !(extent.x > 0 && extent.y > 0)) {
+        return;  // nothing to place, or nowhere to place it
+    }
+
+    // centers at least spacing apart leave a maximal sample with somewhat more circles than
+    // count, so the ones kept can be spread over the whole box; bigger circles push further
+    clearance = clear;
+    spacing = SPREAD * std::sqrt(extent.x * extent.y / count);
+    float min_distance = std::max(spacing, 2 * min_radius + clearance);
+    float max_distance = std::max(spacing, 2 * max_radius + clearance);
+
+    // a cell's diagonal is the least distance between two centers, so no cell holds two
+    origin = low;
+    cell_size = min_distance / std::sqrt(2.0f);
+    cols = static_cast<int>(std::ceil(extent.x / cell_size));
+    rows = static_cast<int>(std::ceil(extent.y / cell_size));
+    reach = static_cast<int>(std::ceil(max_distance / cell_size));
+    grid.assign(cols * rows, NO_ID);
+
+    // start from one random circle, then grow out from the circles that still have room around them
+    float draws[3];  // radius, then where in the box
+    random.fill(draws, 3);
+    add(low + extent * vec2(draws[1], draws[2]), min_radius + (max_radius - min_radius) * draws[0]);
+    vec2 turn(std::cos(2 * E_PI / CANDIDATES), std::sin(2 * E_PI / CANDIDATES));  // rotation between spots
+    while (!active.empty()) {
+        GLuint pick = std::min(static_cast<GLuint>(random.next() * active.size()),
+                               static_cast<GLuint>(active.size() - 1));
+        GLuint from = active[pick];
+
+        // try spots evenly around the circle, starting from a random direction
+        float angle = random.next() * 2 * E_PI;
+        vec2 dir(std::cos(angle), std::sin(angle));
+        bool placed = false;
+        for (GLuint attempt = 0; attempt < CANDIDATES && !placed; ++attempt) {
+            float radius = min_radius + (max_radius - min_radius) * random.next();
+            float distance = std::max(spacing, radii[from] + radius + clearance) * NUDGE;
+            vec2 pos = positions[from] + distance * dir;
+            if (pos.x >= low.x && pos.y >= low.y && pos.x < high.x && pos.y < high.y && fits(pos, radius)) {
+                add(pos, radius);
+                placed = true;
+            }
+            dir = vec2(dir.x * turn.x - dir.y * turn.y, dir.x * turn.y + dir.y * turn.x);
+        }
+
+        if (!placed) {
+            // order doesn't matter, so the circle is popped out in constant time
+            active[pick] = active.back();
+            active.pop_back();
+        }
+    }
+
+    // keep a random count of them (a partial shuffle), so what's left is still spread evenly
+    GLuint kept = std::min(count, static_cast<GLuint>(positions.size()));
+    for (GLuint i = 0; i < kept; ++i) {
+        GLuint j = i + std::min(static_cast<GLuint>(random.next() * (positions.size() - i)),
+                                static_cast<GLuint>(positions.size() - i - 1));
+        std::swap(positions[i], positions[j]);
+        std::swap(radii[i], radii[j]);
+    }
+    positions.resize(kept);
+    radii.resize(kept);
+}
+
+//******************************************************************
+//
+//  Function:   PoissonDisk::fits
+//
+//  Purpose:    determines whether a circle can be placed somewhere
+//
+//  Parameters: pos, radius
+//
+//  Member/Global Variables: positions, radii, grid, origin, cell_size,
+//                           cols, rows, reach, spacing, clearance
+//
+//  Pre Conditions:  pos must be inside the grid
+//
+//  Post Conditions: returns true if the circle's center is at least
+//                   spacing from every center placed, and its edge at
+//                   least clearance from every edge; only the cells
+//                   within reach of its own are checked
+//
+//  Calls:      std::max, std::min, dot
+//
+//******************************************************************
+bool PoissonDisk::fits(const vec2& pos, float radius) const {
+    int col = std::min(static_cast<int>((pos.x - origin.x) / cell_size), cols - 1);
+    int row = std::min(static_cast<int>((pos.y - origin.y) / cell_size), rows - 1);
+    int min_col = std::max(col - reach, 0);
+    int min_row = std::max(row - reach, 0);
+    int max_col = std::min(col + reach, cols - 1);
+    int max_row = std::min(row + reach, rows - 1);
+
+    for (int r = min_row; r <= max_row; ++r) {
+        for (int c = min_col; c <= max_col; ++c) {
+            GLuint other = grid[r * cols + c];
+            if (other == NO_ID) {
+                continue;
+            }
+            vec2 offset = positions[other] - pos;
+            float distance = std::max(spacing, radius + radii[other] + clearance);
+            if (dot(offset, offset) < distance * distance) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   PoissonDisk::add
+//
+//  Purpose:    places a circle
+//
+//  Parameters: pos, radius
+//
+//  Member/Global Variables: positions, radii, grid, active, origin,
+//                           cell_size, cols, rows
+//
+//  Pre Conditions:  pos must be inside the grid, in a cell that holds
+//                   no circle
+//
+//  Post Conditions: the circle will have been placed, its cell marked,
+//                   and new circles may be grown around it
+//
+//  Calls:      std::min
+//
+//******************************************************************
+void PoissonDisk::add(const vec2& pos, float radius) {
+    int col = std::min(static_cast<int>((pos.x - origin.x) / cell_size), cols - 1);
+    int row = std::min(static_cast<int>((pos.y - origin.y) / cell_size), rows - 1);
+    grid[row * cols + col] = positions.size();
+    active.push_back(positions.size());
+    positions.push_back(pos);
+    radii.push_back(radius);
+}
@@ -0,0 +1,100 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        poisson_disk.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class scatters circles of random sizes over a box
+//                 so that no two of them come closer than a clearance
+//                 and all of them are spread evenly, using Bridson's
+//                 Poisson-disk sampling over a background grid, so maps
+//                 are made in time linear in the number of trees.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+#ifndef POISSON_DISK_H
+#define POISSON_DISK_H
+
+// C/C++ Standard libraries
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "random_stream.h"
+
+//******************************************************************
+//
+//  Class: PoissonDisk
+//
+//  Purpose:  To pick positions and radii for a number of circles in a
+//            box, keeping the edges of every two at least a clearance
+//            apart and their centers at least a spacing apart (found
+//            from how many circles share the box, so they spread over
+//            all of it). Circles grow outward from placed ones (trying
+//            spots evenly around each at just past the least distance,
+//            which packs them tighter with fewer tries than Bridson's
+//            random ring), and a grid with at most one center per cell
+//            means each spot is only tested against the few around it.
+//
+//  Functions:
+//           Constructors
+//             PoissonDisk() creates an empty sample
+//           getters
+//             size to return the number of circles placed
+//             get_position(i) to return the center of circle i
+//             get_radius(i) to return the radius of circle i
+//           mutators
+//             scatter(random, count, min_radius, max_radius, clearance,
+//                     low, high)  places up to count circles with radii from
+//                                 min_radius to max_radius, centered inside
+//                                 the box from low to high, drawing from
+//                                 random
+//           private helpers
+//             fits(pos, radius) returns true if a circle there is far
+//                               enough from every circle placed
+//             add(pos, radius) places a circle and marks its cell
+//
+//******************************************************************
+
+class PoissonDisk {
+ public:
+    PoissonDisk() : origin(vec2()), cell_size(1), cols(0), rows(0), reach(0), spacing(0), clearance(0) {}
+
+    // getters
+    GLuint size() const;
+    vec2 get_position(GLuint i) const;
+    float get_radius(GLuint i) const;
+
+    // mutators
+    void scatter(RandomStream& random, GLuint count, float min_radius, float max_radius, float clear,
+                 const vec2& low, const vec2& high);
+ private:
+    std::vector<vec2> positions;  // center of each circle placed
+    std::vector<float> radii;  // radius of each circle placed
+    std::vector<GLuint> grid;  // circle whose center is in each cell, or NO_ID (kept to reuse memory)
+    std::vector<GLuint> active;  // circles that new ones may still be placed around (kept to reuse memory)
+    vec2 origin;  // world position of the bottom left corner of the grid
+    float cell_size;  // width and height of a cell
+    int cols;  // number of columns of cells
+    int rows;  // number of rows of cells
+    int reach;  // number of cells around a cell that can hold a circle too close to one in it
+    float spacing;  // least distance between two centers
+    float clearance;  // least distance between the edges of two circles
+
+    // static member variables
+    static const GLuint CANDIDATES = 12;  // number of spots tried around a circle before it's given up on
+    static constexpr float SPREAD = 0.8;  // spacing, as a fraction of the average distance between circles if they tiled the box
+    static constexpr float NUDGE = 1.0001;  // how far past the least distance spots are tried, so rounding can't reject them
+
+    // private helpers
+    bool fits(const vec2& pos, float radius) const;
+    void add(const vec2& pos, float radius);
+};
+
+#endif
@@ -0,0 +1,285 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        random_stream.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a seedable, counter-based random
+//                 number generator (Philox4x32-10), so that every game
+//                 can be replayed from its seed and independent streams
+//                 can be handed to different parts of the game or to
+//                 different threads.
+//
+//    Date:        10/12/2019
+//
+//*******************************************************************
+
+// Source libraries
+#include "random_stream.h"
+
+// Philox4x32 constants (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+const uint32_t PHILOX_M0 = 0xD2511F53;  // multiplier of the first counter word
+const uint32_t PHILOX_M1 = 0xCD9E8D57;  // multiplier of the third counter word
+const uint32_t PHILOX_W0 = 0x9E3779B9;  // key schedule increment of the first key word (golden ratio)
+const uint32_t PHILOX_W1 = 0xBB67AE85;  // key schedule increment of the second key word (sqrt(3) - 1)
+const GLuint PHILOX_ROUNDS = 10;  // number of rounds (the recommended, crush resistant, count)
+
+//******************************************************************
+//
+//  Function:   RandomStream::get_seed
+//
+//  Purpose:    returns the seed of the stream
+//
+//  Parameters: none
+//
+//  Member/Global Variables: seed
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the value of seed
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t RandomStream::get_seed() const {
+    return seed;
+}
+
+//******************************************************************
+//
+//  Function:   RandomStream::get_stream
+//
+//  Purpose:    returns the stream number
+//
+//  Parameters: none
+//
+//  Member/Global Variables: stream
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the value of stream
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t RandomStream::get_stream() const {
+    return stream;
+}
+
+//******************************************************************
+//
+//  Function:   RandomStream::next
+//
+//  Purpose:    returns the next random number of the stream
+//
+//  Parameters: none
+//
+//  Member/Global Variables: seed, stream, block, buffer, used,
+//                           BLOCK_SIZE
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns a uniformly distributed number in the range
+//                   [0, 1), and the stream will have moved past it
+//
+//  Calls:      generate_block, to_float
+//
+//******************************************************************
+float RandomStream::next() {
+    if (used == BLOCK_SIZE) {
+        generate_block(seed, stream, block++, buffer);
+        used = 0;
+    }
+    return to_float(buffer[used++]);
+}
+
+//******************************************************************
+//
+//  Function:   RandomStream::fill
+//
+//  Purpose:    fills an array with the next random numbers of the
+//              stream
+//
+//  Parameters: values, count
+//
+//  Member/Global Variables: seed, stream, block, buffer, used,
+//                           BLOCK_SIZE
+//
+//  Pre Conditions:  values must have room for count numbers
+//
+//  Post Conditions: values will hold exactly the numbers count calls to
+//                   next would have returned, and the stream will have
+//                   moved past them
+//
+//  Calls:      next, generate_block, to_float
+//
+//******************************************************************
+void RandomStream::fill(float* values, GLuint count) {
+    GLuint i = 0;
+
+    // use up what's left of the current block first
+    while (i < count && used < BLOCK_SIZE) {
+        values[i++] = next();
+    }
+
+    // then go a whole block at a time, straight into the output
+    uint32_t bits[BLOCK_SIZE];
+    while (count - i >= BLOCK_SIZE) {
+        generate_block(seed, stream, block++, bits);
+        for (GLuint k = 0; k < BLOCK_SIZE; ++k) {
+            values[i + k] = to_float(bits[k]);
+        }
+        i += BLOCK_SIZE;
+    }
+
+    // and start a new block for the rest
+    while (i < count) {
+        values[i++] = next();
+    }
+}
+
+//******************************************************************
+//
+//  Function:   RandomStream::save
+//
+//  Purpose:    writes where the stream is up to to a snapshot
+//
+//  Parameters: out
+//
+//  Member/Global Variables: seed, stream, block, buffer, used
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every member will have been appended to out, one at
+//                   a time (so no padding bytes end up in the snapshot)
+//
+//  Calls:      SnapshotWriter::write
+//
+//******************************************************************
+void RandomStream::save(SnapshotWriter& out) const {
+    out.write(seed);
+    out.write(stream);
+    out.write(block);
+    out.write(buffer);
+    out.write(used);
+}
+
+//******************************************************************
+//
+//  Function:   RandomStream::restore
+//
+//  Purpose:    puts the stream back where a snapshot says it was
+//
+//  Parameters: in
+//
+//  Member/Global Variables: seed, stream, block, buffer, used
+//
+//  Pre Conditions:  the next thing in the snapshot must be a stream
+//                   written by save
+//
+//  Post Conditions: the stream will give the same numbers it would
+//                   have when it was saved; returns false if the
+//                   snapshot ended
+//
+//  Calls:      SnapshotReader::read
+//
+//******************************************************************
+bool RandomStream::restore(SnapshotReader& in) {
+    in.read(seed);
+    in.read(stream);
+    in.read(block);
+    in.read(buffer);
+    return in.read(used);
+}
+
+//******************************************************************
+//
+//  Function:   RandomStream::split
+//
+//  Purpose:    returns another stream of the same seed
+//
+//  Parameters: strm
+//
+//  Member/Global Variables: seed
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns stream strm of this stream's seed, starting
+//                   from its beginning
+//
+//  Calls:      RandomStream::RandomStream
+//
+//******************************************************************
+RandomStream RandomStream::split(uint64_t strm) const {
+    return RandomStream(seed, strm);
+}
+
+//******************************************************************
+//
+//  Function:   RandomStream::generate_block
+//
+//  Purpose:    computes the four raw values of one block of a stream
+//
+//  Parameters: seed, stream, block, out
+//
+//  Member/Global Variables: PHILOX_M0, PHILOX_M1, PHILOX_W0, PHILOX_W1,
+//                           PHILOX_ROUNDS
+//
+//  Pre Conditions:  out must have room for four values
+//
+//  Post Conditions: out will hold Philox4x32-10 of the counter
+//                   (block, stream) under the key seed
+//
+//  Calls:      none
+//
+//******************************************************************
+void RandomStream::generate_block(uint64_t seed, uint64_t stream, uint64_t block, uint32_t out[4]) {
+    uint32_t ctr[4] = {
+        static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32),
+        static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)
+    };
+    uint32_t key[2] = { static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) };
+
+    for (GLuint round = 0; round < PHILOX_ROUNDS; ++round) {
+        uint64_t product0 = static_cast<uint64_t>(PHILOX_M0) * ctr[0];
+        uint64_t product1 = static_cast<uint64_t>(PHILOX_M1) * ctr[2];
+        uint32_t next[4] = {
+            static_cast<uint32_t>(product1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(product1),
+            static_cast<uint32_t>(product0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(product0)
+        };
+        for (GLuint k = 0; k < 4; ++k) {
+            ctr[k] = next[k];
+        }
+
+        key[0] += PHILOX_W0;
+        key[1] += PHILOX_W1;
+    }
+
+    for (GLuint k = 0; k < 4; ++k) {
+        out[k] = ctr[k];
+    }
+}
+
+//******************************************************************
+//
+//  Function:   RandomStream::to_float
+//
+//  Purpose:    turns random bits into a number in the range [0, 1)
+//
+//  Parameters: bits
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the top 24 bits of bits (all a float can
+//                   hold exactly) divided by 2^24
+//
+//  Calls:      none
+//
+//******************************************************************
+float RandomStream::to_float(uint32_t bits) {
+    return (bits >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,100 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        random_stream.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a seedable, counter-based random
+//                 number generator (Philox4x32-10), so that every game
+//                 can be replayed from its seed and independent streams
+//                 can be handed to different parts of the game or to
+//                 different threads.
+//
+//    Date:        10/12/2019
+//
+//*******************************************************************
+
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+// C/C++ Standard libraries
+#include <cstdint>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "snapshot.h"
+
+//******************************************************************
+//
+//  Class: RandomStream
+//
+//  Purpose:  To generate random numbers as a pure function of a seed,
+//            a stream number, and a counter: value block n of stream s
+//            is Philox4x32-10 of the counter (n, s) under the seed as
+//            its key. Streams with different numbers never overlap, so
+//            a stream per entity, task, or thread can be made without
+//            any of them sharing state, and a stream can be copied and
+//            used from any thread without locking.
+//
+//  Functions:
+//           Constructors
+//             RandomStream() creates stream 0 of seed 0
+//             RandomStream(seed, stream) creates the given stream of the
+//                                        given seed
+//           getters
+//             get_seed to return the seed of the stream
+//             get_stream to return the stream number
+//           mutators
+//             next() returns the next random number in the range [0, 1)
+//             fill(values, count) fills values with the next count random
+//                                 numbers
+//             save(out) writes where the stream is up to to a snapshot
+//             restore(in) puts the stream back where a snapshot says it was
+//           helpers
+//             split(stream) returns another stream of the same seed
+//             generate_block(seed, stream, block, out) computes the four
+//                                                      raw values of a block
+//                                                      (static)
+//           private helpers
+//             to_float(bits) turns random bits into a number in [0, 1)
+//                            (static)
+//
+//******************************************************************
+
+class RandomStream {
+ public:
+    RandomStream() : RandomStream(0, 0) {}
+    RandomStream(uint64_t s, uint64_t strm) : seed(s), stream(strm), block(0), used(BLOCK_SIZE) {}
+
+    // getters
+    uint64_t get_seed() const;
+    uint64_t get_stream() const;
+
+    // mutators
+    float next();
+    void fill(float* values, GLuint count);
+    void save(SnapshotWriter& out) const;
+    bool restore(SnapshotReader& in);
+
+    // helpers
+    RandomStream split(uint64_t strm) const;
+    static void generate_block(uint64_t seed, uint64_t stream, uint64_t block, uint32_t out[4]);
+ private:
+    uint64_t seed;  // key of the generator
+    uint64_t stream;  // high half of the counter
+    uint64_t block;  // low half of the counter, for the next block to generate
+    uint32_t buffer[4];  // raw values of the last block generated
+    GLuint used;  // number of values in buffer already returned
+
+    // static member variables
+    static const GLuint BLOCK_SIZE = 4;  // number of values each counter gives
+
+    // private helpers
+    static float to_float(uint32_t bits);
+};
+
+#endif
@@ -0,0 +1,342 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        reach_kernel.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These functions test line segments against packed
+//                 arrays of circles (center x, center y, and radius
+//                 squared), several circles at a time using SIMD
+//                 instructions when the processor has them.
+//
+//    Date:        10/11/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <cmath>
+
+// Source libraries
+#include "reach_kernel.h"
+
+// SIMD versions are only built for x86 compilers that let single functions
+// target newer instruction sets than the rest of the program
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define REACH_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+// Signature shared by every version of the kernel
+typedef bool (*ReachKernel)(const float* xs, const float* ys, const float* r2s, GLuint count,
+                            const vec2& a, const vec2& b, const vec2& dir, float dist);
+
+//******************************************************************
+//
+//  Function:   segment_hits_circles_scalar
+//
+//  Purpose:    determines whether any of the given circles blocks the
+//              segment from a to b, one circle at a time
+//
+//  Parameters: xs, ys, r2s, count, a, b, dir, dist
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  xs, ys, and r2s must each hold count values, dir
+//                   must be b - a, and dist must be the length of dir
+//
+//  Post Conditions: returns true if the segment passes within the
+//                   radius of a circle, or b is inside of one
+//
+//  Calls:      dot
+//
+//******************************************************************
+bool segment_hits_circles_scalar(const float* xs, const float* ys, const float* r2s, GLuint count,
+                                 const vec2& a, const vec2& b, const vec2& dir, float dist) {
+    vec2 unit_dir = dir / dist;
+    for (GLuint i = 0; i < count; ++i) {
+        vec2 center = vec2(xs[i], ys[i]);
+        vec2 dir2 = center - a;
+        float scalar_proj = dot(dir, dir2) / dist;  // scalar projection of dir2 onto dir
+
+        if (scalar_proj > 0 && scalar_proj < dist) {  // check whether projection is actually on line segement defined by b and a
+            vec2 projection = a + unit_dir * scalar_proj;  // vector projection of dir2 onto dir
+
+            vec2 radius_vec = center - projection;  // displacement vector from tree center to projection point
+            // check whether length of radius_vec squared falls within minimum radius
+            // (doing this to avoid expensive square root calls)
+            if (dot(radius_vec, radius_vec) < r2s[i]) {
+                return true;
+            }
+        }
+
+        vec2 radius_vec = center - b;
+        // finally, check if the final point falls within the circle's radius
+        // (again, doing this to avoid expensive square root calls)
+        if (dot(radius_vec, radius_vec) < r2s[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#ifdef REACH_KERNEL_X86
+//******************************************************************
+//
+//  Function:   segment_hits_circles_sse2
+//
+//  Purpose:    determines whether any of the given circles blocks the
+//              segment from a to b, four circles at a time
+//
+//  Parameters: xs, ys, r2s, count, a, b, dir, dist
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  same as segment_hits_circles_scalar, and the
+//                   processor must support SSE2
+//
+//  Post Conditions: returns exactly what segment_hits_circles_scalar
+//                   would (every lane does the same operations in the
+//                   same order)
+//
+//  Calls:      SSE intrinsics, segment_hits_circles_scalar
+//
+//******************************************************************
+__attribute__((target("sse2")))
+static bool segment_hits_circles_sse2(const float* xs, const float* ys, const float* r2s, GLuint count,
+                                      const vec2& a, const vec2& b, const vec2& dir, float dist) {
+    vec2 unit_dir = dir / dist;
+    __m128 ax = _mm_set1_ps(a.x);
+    __m128 ay = _mm_set1_ps(a.y);
+    __m128 bx = _mm_set1_ps(b.x);
+    __m128 by = _mm_set1_ps(b.y);
+    __m128 dx = _mm_set1_ps(dir.x);
+    __m128 dy = _mm_set1_ps(dir.y);
+    __m128 ux = _mm_set1_ps(unit_dir.x);
+    __m128 uy = _mm_set1_ps(unit_dir.y);
+    __m128 len = _mm_set1_ps(dist);
+    __m128 zero = _mm_setzero_ps();
+
+    GLuint i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 cx = _mm_loadu_ps(xs + i);
+        __m128 cy = _mm_loadu_ps(ys + i);
+        __m128 r2 = _mm_loadu_ps(r2s + i);
+
+        // scalar projection of the center onto the segment, and whether it lands on it
+        __m128 proj = _mm_div_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_sub_ps(cx, ax)), _mm_mul_ps(dy, _mm_sub_ps(cy, ay))), len);
+        __m128 on_segment = _mm_and_ps(_mm_cmpgt_ps(proj, zero), _mm_cmplt_ps(proj, len));
+
+        // squared distance from the center to its projection
+        __m128 rx = _mm_sub_ps(cx, _mm_add_ps(ax, _mm_mul_ps(ux, proj)));
+        __m128 ry = _mm_sub_ps(cy, _mm_add_ps(ay, _mm_mul_ps(uy, proj)));
+        __m128 near_line = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), r2);
+
+        // squared distance from the center to b
+        __m128 ex = _mm_sub_ps(cx, bx);
+        __m128 ey = _mm_sub_ps(cy, by);
+        __m128 near_end = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)), r2);
+
+        if (_mm_movemask_ps(_mm_or_ps(_mm_and_ps(on_segment, near_line), near_end)) != 0) {
+            return true;
+        }
+    }
+
+    // circles left over from the last full group of four
+    return segment_hits_circles_scalar(xs + i, ys + i, r2s + i, count - i, a, b, dir, dist);
+}
+
+//******************************************************************
+//
+//  Function:   segment_hits_circles_avx
+//
+//  Purpose:    determines whether any of the given circles blocks the
+//              segment from a to b, eight circles at a time
+//
+//  Parameters: xs, ys, r2s, count, a, b, dir, dist
+//
+//  Member/Global Variables: REACH_KERNEL_WIDTH
+//
+//  Pre Conditions:  same as segment_hits_circles_scalar, and the
+//                   processor must support AVX
+//
+//  Post Conditions: returns exactly what segment_hits_circles_scalar
+//                   would (every lane does the same operations in the
+//                   same order)
+//
+//  Calls:      AVX intrinsics, segment_hits_circles_scalar
+//
+//******************************************************************
+__attribute__((target("avx")))
+static bool segment_hits_circles_avx(const float* xs, const float* ys, const float* r2s, GLuint count,
+                                     const vec2& a, const vec2& b, const vec2& dir, float dist) {
+    vec2 unit_dir = dir / dist;
+    __m256 ax = _mm256_set1_ps(a.x);
+    __m256 ay = _mm256_set1_ps(a.y);
+    __m256 bx = _mm256_set1_ps(b.x);
+    __m256 by = _mm256_set1_ps(b.y);
+    __m256 dx = _mm256_set1_ps(dir.x);
+    __m256 dy = _mm256_set1_ps(dir.y);
+    __m256 ux = _mm256_set1_ps(unit_dir.x);
+    __m256 uy = _mm256_set1_ps(unit_dir.y);
+    __m256 len = _mm256_set1_ps(dist);
+    __m256 zero = _mm256_setzero_ps();
+
+    GLuint i = 0;
+    for (; i + REACH_KERNEL_WIDTH <= count; i += REACH_KERNEL_WIDTH) {
+        __m256 cx = _mm256_loadu_ps(xs + i);
+        __m256 cy = _mm256_loadu_ps(ys + i);
+        __m256 r2 = _mm256_loadu_ps(r2s + i);
+
+        // scalar projection of the center onto the segment, and whether it lands on it
+        __m256 proj = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(dx, _mm256_sub_ps(cx, ax)),
+                                                  _mm256_mul_ps(dy, _mm256_sub_ps(cy, ay))), len);
+        __m256 on_segment = _mm256_and_ps(_mm256_cmp_ps(proj, zero, _CMP_GT_OQ), _mm256_cmp_ps(proj, len, _CMP_LT_OQ));
+
+        // squared distance from the center to its projection
+        __m256 rx = _mm256_sub_ps(cx, _mm256_add_ps(ax, _mm256_mul_ps(ux, proj)));
+        __m256 ry = _mm256_sub_ps(cy, _mm256_add_ps(ay, _mm256_mul_ps(uy, proj)));
+        __m256 near_line = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(rx, rx), _mm256_mul_ps(ry, ry)), r2, _CMP_LT_OQ);
+
+        // squared distance from the center to b
+        __m256 ex = _mm256_sub_ps(cx, bx);
+        __m256 ey = _mm256_sub_ps(cy, by);
+        __m256 near_end = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey)), r2, _CMP_LT_OQ);
+
+        if (_mm256_movemask_ps(_mm256_or_ps(_mm256_and_ps(on_segment, near_line), near_end)) != 0) {
+            return true;
+        }
+    }
+
+    // circles left over from the last full group of eight
+    return segment_hits_circles_scalar(xs + i, ys + i, r2s + i, count - i, a, b, dir, dist);
+}
+#endif
+
+//******************************************************************
+//
+//  Function:   choose_kernel
+//
+//  Purpose:    picks the widest version of the kernel that the
+//              processor supports
+//
+//  Parameters: name
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the kernel to use, and sets name to the
+//                   name of its instruction set
+//
+//  Calls:      __builtin_cpu_supports
+//
+//******************************************************************
+static ReachKernel choose_kernel(const char*& name) {
+#ifdef REACH_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) {
+        name = "avx";
+        return segment_hits_circles_avx;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        name = "sse2";
+        return segment_hits_circles_sse2;
+    }
+#endif
+    name = "scalar";
+    return segment_hits_circles_scalar;
+}
+
+// Kernel chosen for this processor (picked before main runs, so no thread can see it unset)
+static const char* kernel_name = nullptr;
+static const ReachKernel kernel = choose_kernel(kernel_name);
+
+//******************************************************************
+//
+//  Function:   segment_hits_circles
+//
+//  Purpose:    determines whether any of the given circles blocks the
+//              segment from a to b
+//
+//  Parameters: xs, ys, r2s, count, a, b, dir, dist
+//
+//  Member/Global Variables: kernel
+//
+//  Pre Conditions:  xs, ys, and r2s must each hold count values, dir
+//                   must be b - a, and dist must be the length of dir
+//
+//  Post Conditions: returns true if the segment passes within the
+//                   radius of a circle, or b is inside of one (the
+//                   answer doesn't depend on the instruction set used)
+//
+//  Calls:      kernel
+//
+//******************************************************************
+bool segment_hits_circles(const float* xs, const float* ys, const float* r2s, GLuint count,
+                          const vec2& a, const vec2& b, const vec2& dir, float dist) {
+    return kernel(xs, ys, r2s, count, a, b, dir, dist);
+}
+
+//******************************************************************
+//
+//  Function:   segments_hit_circles
+//
+//  Purpose:    determines, for each of a batch of segments, whether
+//              any of the given circles blocks it
+//
+//  Parameters: xs, ys, r2s, count, as, bs, num_segments, hits
+//
+//  Member/Global Variables: kernel, REACH_KERNEL_WIDTH
+//
+//  Pre Conditions:  xs, ys, and r2s must each hold count values, and
+//                   as, bs, and hits must each hold num_segments values
+//
+//  Post Conditions: hits[i] will be true if the segment from as[i] to
+//                   bs[i] is blocked by a circle
+//
+//  Calls:      length, kernel
+//
+//******************************************************************
+void segments_hit_circles(const float* xs, const float* ys, const float* r2s, GLuint count,
+                          const vec2* as, const vec2* bs, GLuint num_segments, bool* hits) {
+    for (GLuint i = 0; i < num_segments; ++i) {
+        hits[i] = false;
+    }
+
+    // walk the circles in blocks small enough to stay in cache, testing every segment
+    // that isn't already blocked against each block before moving on to the next
+    const GLuint block = REACH_KERNEL_WIDTH * 32;
+    for (GLuint start = 0; start < count; start += block) {
+        GLuint block_count = (count - start < block) ? count - start : block;
+        for (GLuint i = 0; i < num_segments; ++i) {
+            if (!hits[i]) {
+                vec2 dir = bs[i] - as[i];
+                hits[i] = kernel(xs + start, ys + start, r2s + start, block_count, as[i], bs[i], dir, length(dir));
+            }
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   reach_kernel_name
+//
+//  Purpose:    returns the name of the instruction set the kernel uses
+//
+//  Parameters: none
+//
+//  Member/Global Variables: kernel_name
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns "avx", "sse2", or "scalar"
+//
+//  Calls:      none
+//
+//******************************************************************
+const char* reach_kernel_name() {
+    return kernel_name;
+}
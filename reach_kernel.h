@@ -0,0 +1,47 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        reach_kernel.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These functions test line segments against packed
+//                 arrays of circles (center x, center y, and radius
+//                 squared), several circles at a time using SIMD
+//                 instructions when the processor has them.
+//
+//    Date:        10/11/2019
+//
+//*******************************************************************
+
+#ifndef REACH_KERNEL_H
+#define REACH_KERNEL_H
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Number of circles the kernel tests at once (packed arrays padded to a multiple
+// of this never fall back to testing circles one by one)
+const GLuint REACH_KERNEL_WIDTH = 8;
+
+// Radius squared of padding circles, which can never block a segment
+const float REACH_KERNEL_PAD_R2 = 0;
+
+// Function to determine whether any of count circles blocks the segment from a to b
+// (dir must be b - a, and dist its length)
+bool segment_hits_circles(const float* xs, const float* ys, const float* r2s, GLuint count,
+                          const vec2& a, const vec2& b, const vec2& dir, float dist);
+
+// Function to determine, for each of a batch of segments, whether any of count circles blocks it
+void segments_hit_circles(const float* xs, const float* ys, const float* r2s, GLuint count,
+                          const vec2* as, const vec2* bs, GLuint num_segments, bool* hits);
+
+// Function doing the same test as segment_hits_circles, one circle at a time
+bool segment_hits_circles_scalar(const float* xs, const float* ys, const float* r2s, GLuint count,
+                                 const vec2& a, const vec2& b, const vec2& dir, float dist);
+
+// Function to get the name of the instruction set the kernel uses on this processor
+const char* reach_kernel_name();
+
+#endif
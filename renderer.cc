@@ -0,0 +1,355 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        renderer.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class owns all of the OpenGL state used to draw
+//                 simulated objects (vertex data and shader uniform
+//                 locations), so that the objects themselves can be
+//                 simulated without an OpenGL context.
+//
+//    Date:        10/3/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Source libraries
+#include "renderer.h"
+#include "utilities.h"
+
+//******************************************************************
+//
+//  Function:   Renderer::set_window_size
+//
+//  Purpose:    sends the window size to the shader
+//
+//  Parameters: size
+//
+//  Member/Global Variables: window_size_loc, counters
+//
+//  Pre Conditions:  init must have been called, and an opengl context
+//                   must be valid and active
+//
+//  Post Conditions: the shader's window size uniform will equal size
+//                   (and be counted, if there are counters)
+//
+//  Calls:      glUniform2f, WorkCounters::add
+//
+//******************************************************************
+void Renderer::set_window_size(const vec2& size) {
+    glUniform2f(window_size_loc, size.x, size.y);  // send window size to shader
+    if (counters != nullptr) {
+        counters->add(COUNTER_UNIFORM_UPLOADS);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Renderer::set_work_counters
+//
+//  Purpose:    sets where draw calls and uniforms sent are counted
+//
+//  Parameters: c
+//
+//  Member/Global Variables: counters
+//
+//  Pre Conditions:  c must outlive the renderer, or be unset first
+//
+//  Post Conditions: every draw call made and uniform sent from now on
+//                   will be counted in c (none if c is null)
+//
+//  Calls:      none
+//
+//******************************************************************
+void Renderer::set_work_counters(WorkCounters* c) {
+    counters = c;
+}
+
+//******************************************************************
+//
+//  Function:   Renderer::init
+//
+//  Purpose:    initializes shader variable locations and the opengl
+//              vertex data for circles and units
+//
+//  Parameters: shader
+//
+//  Member/Global Variables: shader_id, pos_loc, size_loc, rot_loc,
+//                           col_loc, df_loc, window_size_loc
+//
+//  Pre Conditions:  shader must correspond to a valid, active
+//                   shader program
+//
+//  Post Conditions: all shader variable locations will be set, and
+//                   the circle and unit vertex data will be created
+//
+//  Calls:      get_uniform, generate_circle_data, generate_unit_data
+//
+//******************************************************************
+void Renderer::init(GLuint shader) {
+    shader_id = shader;
+
+    pos_loc = get_uniform("position");
+    size_loc = get_uniform("size");
+    rot_loc = get_uniform("rotation");
+    col_loc = get_uniform("color");
+    df_loc = get_uniform("darkening_factor");
+    window_size_loc = get_uniform("windowSize");
+
+    generate_circle_data();
+    generate_unit_data();
+}
+
+//******************************************************************
+//
+//  Function:   Renderer::draw_circle
+//
+//  Purpose:    draws a circle to the frame buffer
+//
+//  Parameters: pos, radius, color, selection_draw
+//
+//  Member/Global Variables: circle_vao, CIRCLE_TRIANGLES, counters
+//
+//  Pre Conditions:  init must have been called, and an opengl context
+//                   must be valid and active
+//
+//  Post Conditions: draws a circle of radius centered on pos to the
+//                   frame buffer (counting the draw call, if there are
+//                   counters)
+//
+//  Calls:      glBindVertexArray, prepare_display, glDrawArrays,
+//              WorkCounters::add
+//
+//******************************************************************
+void Renderer::draw_circle(const vec2& pos, float radius, const vec3& color, bool selection_draw) {
+    glBindVertexArray(circle_vao);  // bind vertex array
+    prepare_display(pos, radius, 0, color, selection_draw);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, CIRCLE_TRIANGLES + 2);  // draw circle
+    glBindVertexArray(0);  // unbind vertex array
+    if (counters != nullptr) {
+        counters->add(COUNTER_DRAW_CALLS);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Renderer::draw_unit
+//
+//  Purpose:    draws a unit to the frame buffer
+//
+//  Parameters: pos, size, rot, color, selection_draw
+//
+//  Member/Global Variables: unit_vao, UNIT_TRIANGLES, counters
+//
+//  Pre Conditions:  init must have been called, and an opengl context
+//                   must be valid and active
+//
+//  Post Conditions: draws a unit of the given size, with its tip at pos
+//                   and facing rot, to the frame buffer (counting the
+//                   draw call, if there are counters)
+//
+//  Calls:      glBindVertexArray, prepare_display, glDrawArrays,
+//              WorkCounters::add
+//
+//******************************************************************
+void Renderer::draw_unit(const vec2& pos, float size, float rot, const vec3& color, bool selection_draw) {
+    glBindVertexArray(unit_vao);  // bind vertex array
+    prepare_display(pos, size, rot, color, selection_draw);
+    glDrawArrays(GL_TRIANGLES, 0, UNIT_TRIANGLES * 3);  // draw unit
+    glBindVertexArray(0);  // unbind vertex array
+    if (counters != nullptr) {
+        counters->add(COUNTER_DRAW_CALLS);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Renderer::prepare_display
+//
+//  Purpose:    prepares the opengl parameters for displaying an object
+//
+//  Parameters: pos, size, rot, color, selection_draw
+//
+//  Member/Global Variables: pos_loc, size_loc, rot_loc, col_loc,
+//                           df_loc, counters, OBJECT_UNIFORMS
+//
+//  Pre Conditions:  an OpenGL context and shader must be active and
+//                   all of the shader variable locations must have
+//                   proper, correct values
+//
+//  Post Conditions: the object will be ready to be drawn using opengl,
+//                   all uniform variables will be loaded (when
+//                   selection_draw is true, color should be the
+//                   object's selection color), and counted if there
+//                   are counters
+//
+//  Calls:      glUniform2f, glUniform1f, glUniform3f, WorkCounters::add
+//
+//******************************************************************
+void Renderer::prepare_display(const vec2& pos, float size, float rot, const vec3& color, bool selection_draw) {
+    glUniform2f(pos_loc, pos.x, pos.y);  // send position to shader
+    glUniform1f(rot_loc, rot);  // send rotation to shader
+    if (selection_draw) {
+        glUniform2f(size_loc, size * 1.25, size * 1.25);  // send slightly bigger size to shader
+        glUniform3f(col_loc, color.x, color.y, color.z);  // send select color to shader
+        glUniform1f(df_loc, 0);  // send 0 darkening_factor to shader
+    } else {
+        glUniform2f(size_loc, size, size);  // send size to shader
+        glUniform3f(col_loc, color.x, color.y, color.z);  // send color to shader
+        glUniform1f(df_loc, 1);  // send 1 darkening_factor to shader
+    }
+    if (counters != nullptr) {
+        counters->add(COUNTER_UNIFORM_UPLOADS, OBJECT_UNIFORMS);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Renderer::get_uniform
+//
+//  Purpose:    finds the location of a uniform variable in the shader
+//
+//  Parameters: name
+//
+//  Member/Global Variables: shader_id
+//
+//  Pre Conditions:  shader_id must correspond to a valid, active
+//                   shader program
+//
+//  Post Conditions: returns the location of the uniform, errors and
+//                   quits the program if it can't be found
+//
+//  Calls:      glGetUniformLocation, exit
+//
+//******************************************************************
+GLint Renderer::get_uniform(const char* name) const {
+    GLint loc = glGetUniformLocation(shader_id, name);  // get location of the variable in our shader
+    if (loc == -1) {
+        // error if the variable wasn't found
+        std::cerr << "Unable to find " << name << " in shader.\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return loc;
+}
+
+//******************************************************************
+//
+//  Function:   Renderer::generate_circle_data
+//
+//  Purpose:    generates the opengl data for circles and sends it to
+//              the graphics card
+//
+//  Parameters: none
+//
+//  Member/Global Variables: CIRCLE_TRIANGLES, circle_vao, shader_id
+//
+//  Pre Conditions:  a valid opengl context must be active, and
+//                   shader_id must correspond to a valid, active
+//                   shader program
+//
+//  Post Conditions: circle_vao will contain the vertex array object id
+//
+//  Calls:      glGenVertexArrays, glBindVertexArray, glGenBuffers,
+//              glBindBuffer, glBufferData, glEnableVertexAttribArray,
+//              glVertexAttribPointer, BUFFER_OFFSET
+//
+//******************************************************************
+void Renderer::generate_circle_data() {
+    vec2 points[CIRCLE_TRIANGLES + 2];
+    points[0] = vec2(0, 0);  // first point is center of circle
+
+    for (GLuint i = 0; i < CIRCLE_TRIANGLES + 1; ++i) {
+        float angle = static_cast<float>(i) / CIRCLE_TRIANGLES * 2 * E_PI;
+        points[i + 1] = vec2(std::cos(angle), std::sin(angle));
+    }
+
+    // Create a vertex array object
+    glGenVertexArrays(1, &circle_vao);
+    glBindVertexArray(circle_vao);
+
+    // Create and initialize a buffer object
+    GLuint buffer;  // pointer to opengl buffer to hold our vertex data
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, (CIRCLE_TRIANGLES + 2) * 2 * sizeof(float), points, GL_STATIC_DRAW);
+
+    // Initialize the vertex position attribute from the vertex shader
+    GLint vert_loc = glGetAttribLocation(shader_id, "vPosition");  // get location of vPosition attrib in shader
+    if (vert_loc == -1) {
+        std::cerr << "Unable to find vPosition attribute in shader.\n";
+        exit(EXIT_FAILURE);
+    }
+    glEnableVertexAttribArray(vert_loc);  // enable attribute array
+    glVertexAttribPointer(vert_loc, 2, GL_FLOAT, GL_FALSE, 0,
+            BUFFER_OFFSET(0));  // create vertex attribute pointer for our data
+
+    // clean up after ourselves, unbind our buffer and vao
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+//******************************************************************
+//
+//  Function:   Renderer::generate_unit_data
+//
+//  Purpose:    generates the opengl data for units and sends it to
+//              the graphics card
+//
+//  Parameters: none
+//
+//  Member/Global Variables: UNIT_TRIANGLES, unit_vao, shader_id
+//
+//  Pre Conditions:  a valid opengl context must be active, and
+//                   shader_id must correspond to a valid, active
+//                   shader program
+//
+//  Post Conditions: unit_vao will contain the vertex array object id
+//
+//  Calls:      glGenVertexArrays, glBindVertexArray, glGenBuffers,
+//              glBindBuffer, glBufferData, glEnableVertexAttribArray,
+//              glVertexAttribPointer, BUFFER_OFFSET
+//
+//******************************************************************
+void Renderer::generate_unit_data() {
+    vec2 points[UNIT_TRIANGLES * 3];  // 3 points per triangle
+    // left triangle
+    points[0] = vec2(0, 0);  // make tip of unit at zero
+    points[1] = vec2(-1, 0.5);
+    points[2] = vec2(-0.75, 0);
+    // right triangle
+    points[3] = vec2(0, 0);
+    points[4] = vec2(-0.75, 0);
+    points[5] = vec2(-1, -0.5);
+
+    // Create a vertex array object
+    glGenVertexArrays(1, &unit_vao);
+    glBindVertexArray(unit_vao);
+
+    // Create and initialize a buffer object
+    GLuint buffer;  // pointer to opengl buffer to hold our vertex data
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, UNIT_TRIANGLES * 3 * 2 * sizeof(float), points, GL_STATIC_DRAW);
+
+    // Initialize the vertex position attribute from the vertex shader
+    GLint vert_loc = glGetAttribLocation(shader_id, "vPosition");  // get location of vPosition attrib in shader
+    if (vert_loc == -1) {
+        std::cerr << "Unable to find vPosition attribute in shader.\n";
+        exit(EXIT_FAILURE);
+    }
+    glEnableVertexAttribArray(vert_loc);  // enable attribute array
+    glVertexAttribPointer(vert_loc, 2, GL_FLOAT, GL_FALSE, 0,
+            BUFFER_OFFSET(0));  // create vertex attribute pointer for our data
+
+    // clean up after ourselves, unbind our buffer and vao
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,99 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        renderer.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class owns all of the OpenGL state used to draw
+//                 simulated objects (vertex data and shader uniform
+//                 locations), so that the objects themselves can be
+//                 simulated without an OpenGL context.
+//
+//    Date:        10/3/2019
+//
+//*******************************************************************
+
+#ifndef RENDERER_H
+#define RENDERER_H
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "work_counters.h"
+
+//******************************************************************
+//
+//  Class: Renderer
+//
+//  Purpose:  To draw circles and units to the frame buffer using
+//            the game's shader program.
+//
+//  Functions:
+//           Constructors
+//             Renderer() creates an uninitialized renderer
+//           setters
+//             set_window_size to send the window size to the shader
+//             set_work_counters to set where draw calls and uniforms sent
+//                               are counted
+//           mutators
+//             init(shader_id) to initialize opengl data and shader
+//                             variable locations
+//           helpers
+//             draw_circle(pos, radius, color,
+//                         selection_draw)  draws a circle to the frame buffer
+//             draw_unit(pos, size, rot, color,
+//                       selection_draw)  draws a unit to the frame buffer
+//           private helpers
+//             prepare_display(pos, size, rot, color,
+//                             selection_draw)  prepares an object to be drawn
+//             get_uniform(name) returns the location of a shader uniform
+//             generate_circle_data() generates the opengl data for circles
+//             generate_unit_data() generates the opengl data for units
+//
+//******************************************************************
+
+class Renderer {
+ public:
+    Renderer() : shader_id(0), pos_loc(-1), size_loc(-1), rot_loc(-1), col_loc(-1),
+        df_loc(-1), window_size_loc(-1), circle_vao(0), unit_vao(0), counters(nullptr) {}
+    Renderer(const Renderer&) = delete;  // no copy constructor
+    Renderer operator=(const Renderer&) = delete;  // no copy assignment operator
+
+    // setters
+    void set_window_size(const vec2& size);
+    void set_work_counters(WorkCounters* c);
+
+    // mutators
+    void init(GLuint shader);
+
+    // helpers
+    void draw_circle(const vec2& pos, float radius, const vec3& color, bool selection_draw);
+    void draw_unit(const vec2& pos, float size, float rot, const vec3& color, bool selection_draw);
+ private:
+    GLuint shader_id;  // opengl shader program id
+    GLint pos_loc;  // shader position variable location
+    GLint size_loc;  // shader size variable location
+    GLint rot_loc;  // shader rotation variable location
+    GLint col_loc;  // shader color variable location
+    GLint df_loc;  // shader darkening factor variable location
+    GLint window_size_loc;  // shader window size variable location
+    GLuint circle_vao;  // the vao for the circle data
+    GLuint unit_vao;  // the vao for the unit data
+    WorkCounters* counters;  // where draw calls and uniforms sent are counted, or null to not count them (not owned)
+
+    // static member variables
+    static const GLuint CIRCLE_TRIANGLES = 50;  // number of triangles to construct a circle out of
+    static const GLuint UNIT_TRIANGLES = 2;  // number of triangles to construct a unit out of
+    static const GLuint OBJECT_UNIFORMS = 5;  // number of uniforms sent to draw an object
+
+    // private helpers
+    void prepare_display(const vec2& pos, float size, float rot, const vec3& color, bool selection_draw);
+    GLint get_uniform(const char* name) const;
+    void generate_circle_data();
+    void generate_unit_data();
+};
+
+#endif
@@ -0,0 +1,441 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        scenario.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These functions load a scenario (how many of each
+//                 object a game has, how big its world and window are,
+//                 and the values it's played with) from a config file
+//                 and command line options, so games of any size can
+//                 be run without recompiling.
+//
+//    Date:        10/14/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// Source libraries
+#include "scenario.h"
+
+// A gameplay value that can be set by name
+struct TuningField {
+    const char* key;  // name of the value in config files and options
+    float Tuning::* value;  // member of Tuning it sets
+};
+
+// Every gameplay value that can be set by name
+const TuningField TUNING_FIELDS[] = {
+    { "food_per_drop", &Tuning::food_per_drop },
+    { "food_rot_speed", &Tuning::food_rot_speed },
+    { "good_max_food", &Tuning::good_max_food },
+    { "bad_food_rate", &Tuning::bad_food_rate },
+    { "good_food_rate", &Tuning::good_food_rate },
+    { "bad_speed", &Tuning::bad_speed },
+    { "good_speed", &Tuning::good_speed },
+    { "bad_range", &Tuning::bad_range },
+    { "good_range", &Tuning::good_range },
+    { "good_boost_factor", &Tuning::good_boost_factor },
+    { "bad_boost_factor", &Tuning::bad_boost_factor },
+    { "speed_boost_duration", &Tuning::speed_boost_duration },
+    { "plane_speed", &Tuning::plane_speed },
+    { "tree_clearance", &Tuning::tree_clearance }
+};
+
+// Characters skipped around keys and values
+constexpr char const* WHITESPACE = " \t\r\n";
+
+//******************************************************************
+//
+//  Function:   parse_count
+//
+//  Purpose:    reads a whole number that can't be negative
+//
+//  Parameters: text, count
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: if text is only a whole number that fits in count,
+//                   count will be set to it and true is returned,
+//                   otherwise count is left alone and false is returned
+//
+//  Calls:      std::strtoull
+//
+//******************************************************************
+template <typename T>
+static bool parse_count(const std::string& text, T& count) {
+    if (text.empty() || text[0] == '-') {  // strtoull would wrap negative numbers around
+        return false;
+    }
+
+    char* end;
+    errno = 0;
+    unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE || value != static_cast<T>(value)) {
+        return false;
+    }
+
+    count = static_cast<T>(value);
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   parse_amount
+//
+//  Purpose:    reads a number that can't be negative
+//
+//  Parameters: text, amount
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: if text is only a finite number that isn't
+//                   negative, amount will be set to it and true is
+//                   returned, otherwise amount is left alone and false
+//                   is returned
+//
+//  Calls:      std::strtof, std::isfinite
+//
+//******************************************************************
+static bool parse_amount(const std::string& text, float& amount) {
+    if (text.empty()) {
+        return false;
+    }
+
+    char* end;
+    float value = std::strtof(text.c_str(), &end);
+    if (*end != '\0' || !std::isfinite(value) || value < 0) {
+        return false;
+    }
+
+    amount = value;
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   trim
+//
+//  Purpose:    removes the whitespace around some text
+//
+//  Parameters: text
+//
+//  Member/Global Variables: WHITESPACE
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns text without leading or trailing whitespace
+//
+//  Calls:      std::string::find_first_not_of,
+//              std::string::find_last_not_of
+//
+//******************************************************************
+static std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(WHITESPACE);
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = text.find_last_not_of(WHITESPACE);
+    return text.substr(first, last - first + 1);
+}
+
+//******************************************************************
+//
+//  Function:   default_scenario
+//
+//  Purpose:    returns the scenario every game starts from
+//
+//  Parameters: none
+//
+//  Member/Global Variables: DEFAULT_BAD_GUYS, DEFAULT_GOOD_GUYS,
+//                           DEFAULT_TREES, DEFAULT_DROPS,
+//                           DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT,
+//                           DEFAULT_TICK_RATE, DEFAULT_TUNING
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the default game, on a world matching its
+//                   window, with seed 0 and one thread per core, that
+//                   makes its own maps and isn't recorded, traced, or
+//                   counted
+//
+//  Calls:      none
+//
+//******************************************************************
+Scenario default_scenario() {
+    Scenario scenario;
+    scenario.bad_guys = DEFAULT_BAD_GUYS;
+    scenario.good_guys = DEFAULT_GOOD_GUYS;
+    scenario.trees = DEFAULT_TREES;
+    scenario.drops = DEFAULT_DROPS;
+    scenario.world_size = vec2(0, 0);
+    scenario.window_size = vec2(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT);
+    scenario.tick_rate = DEFAULT_TICK_RATE;
+    scenario.seed = 0;
+    scenario.threads = 0;
+    scenario.tuning = DEFAULT_TUNING;
+    scenario.map = "";
+    scenario.record = "";
+    scenario.trace = "";
+    scenario.counters = "";
+    return scenario;
+}
+
+//******************************************************************
+//
+//  Function:   has_world_size
+//
+//  Purpose:    returns whether a scenario has a world size of its own
+//
+//  Parameters: scenario
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns false if either side of the scenario's world
+//                   size is 0 (so the world matches the window)
+//
+//  Calls:      none
+//
+//******************************************************************
+bool has_world_size(const Scenario& scenario) {
+    return scenario.world_size.x > 0 && scenario.world_size.y > 0;
+}
+
+//******************************************************************
+//
+//  Function:   get_world_size
+//
+//  Purpose:    returns the size of a scenario's world
+//
+//  Parameters: scenario
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the scenario's world size, or its window
+//                   size if it has none of its own
+//
+//  Calls:      has_world_size
+//
+//******************************************************************
+vec2 get_world_size(const Scenario& scenario) {
+    if (!has_world_size(scenario)) {
+        return scenario.window_size;
+    }
+    return scenario.world_size;
+}
+
+//******************************************************************
+//
+//  Function:   set_scenario_value
+//
+//  Purpose:    sets one value of a scenario by name
+//
+//  Parameters: scenario, key, value
+//
+//  Member/Global Variables: TUNING_FIELDS, MAX_THREADS, MAX_WORLD_SIZE
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: if key names a value of the scenario and value is
+//                   valid for it, it will be set and true is returned,
+//                   otherwise the scenario is left alone and false is
+//                   returned (window sizes and the tick rate must be
+//                   above 0, threads can't be above MAX_THREADS, world
+//                   and window sizes can't be above MAX_WORLD_SIZE, and
+//                   nothing can be negative)
+//
+//  Calls:      parse_count, parse_amount
+//
+//******************************************************************
+bool set_scenario_value(Scenario& scenario, const std::string& key, const std::string& value) {
+    // numbers of objects and how they're run
+    if (key == "bad_guys") {
+        return parse_count(value, scenario.bad_guys);
+    } else if (key == "good_guys") {
+        return parse_count(value, scenario.good_guys);
+    } else if (key == "trees") {
+        return parse_count(value, scenario.trees);
+    } else if (key == "drops") {
+        return parse_count(value, scenario.drops);
+    } else if (key == "seed") {
+        return parse_count(value, scenario.seed);
+    } else if (key == "threads") {
+        // each thread is a real one, and the system runs out of them long before a GLuint does
+        GLuint threads;
+        if (!parse_count(value, threads) || threads > MAX_THREADS) {
+            return false;
+        }
+        scenario.threads = threads;
+        return true;
+    } else if (key == "map") {
+        scenario.map = value;
+        return true;
+    } else if (key == "record") {
+        scenario.record = value;
+        return true;
+    } else if (key == "trace") {
+        scenario.trace = value;
+        return true;
+    } else if (key == "counters") {
+        scenario.counters = value;
+        return true;
+    }
+
+    // sizes and rates
+    float amount;
+    if (key == "world_width" || key == "world_height") {
+        if (!parse_amount(value, amount) || amount > MAX_WORLD_SIZE) {
+            return false;
+        }
+        (key == "world_width" ? scenario.world_size.x : scenario.world_size.y) = amount;
+        return true;
+    } else if (key == "window_width" || key == "window_height") {
+        // a scenario without a world size plays in one the size of the window
+        if (!parse_amount(value, amount) || amount == 0 || amount > MAX_WORLD_SIZE) {
+            return false;
+        }
+        (key == "window_width" ? scenario.window_size.x : scenario.window_size.y) = amount;
+        return true;
+    } else if (key == "tick_rate") {
+        if (!parse_amount(value, amount) || amount == 0) {
+            return false;
+        }
+        scenario.tick_rate = amount;
+        return true;
+    }
+
+    // gameplay values
+    for (const TuningField& field : TUNING_FIELDS) {
+        if (key == field.key) {
+            return parse_amount(value, scenario.tuning.*field.value);
+        }
+    }
+
+    return false;
+}
+
+//******************************************************************
+//
+//  Function:   load_scenario
+//
+//  Purpose:    sets the values of a scenario listed in a config file
+//
+//  Parameters: scenario, path
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every "key = value" line of the file will have been
+//                   set in order (text after a # is ignored, as are
+//                   blank lines); returns false, after printing the bad
+//                   line to standard error, if the file can't be read or
+//                   a line isn't a valid value (the lines before it stay
+//                   set)
+//
+//  Calls:      std::getline, trim, set_scenario_value
+//
+//******************************************************************
+bool load_scenario(Scenario& scenario, const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Unable to open scenario file " << path << ".\n";
+        return false;
+    }
+
+    std::string line;
+    GLuint line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        std::string text = trim(line.substr(0, line.find('#')));
+        if (text.empty()) {
+            continue;
+        }
+
+        size_t equals = text.find('=');
+        if (equals == std::string::npos ||
+            !set_scenario_value(scenario, trim(text.substr(0, equals)), trim(text.substr(equals + 1)))) {
+            std::cerr << path << ":" << line_number << ": invalid scenario value \"" << text << "\".\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   parse_scenario_args
+//
+//  Purpose:    sets the values of a scenario given as command line
+//              options
+//
+//  Parameters: scenario, argc, argv, rest
+//
+//  Member/Global Variables: CONFIG_OPTION
+//
+//  Pre Conditions:  argv must hold argc arguments, the first being the
+//                   program name
+//
+//  Post Conditions: every --key=value (or --key value) option will have
+//                   been set in order, with --config=file loading the
+//                   file at that point, so later options override it;
+//                   rest will hold the arguments that aren't options, in
+//                   order; returns false, after printing the bad option
+//                   to standard error, if an option isn't valid
+//
+//  Calls:      std::strncmp, std::strchr, load_scenario,
+//              set_scenario_value
+//
+//******************************************************************
+bool parse_scenario_args(Scenario& scenario, int argc, char** argv, std::vector<char*>& rest) {
+    rest.clear();
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--", 2) != 0) {
+            rest.push_back(argv[i]);
+            continue;
+        }
+
+        // the value is either after an = or the next argument
+        std::string key = argv[i] + 2;
+        std::string value;
+        const char* equals = std::strchr(argv[i], '=');
+        if (equals != nullptr) {
+            key = std::string(argv[i] + 2, equals - (argv[i] + 2));
+            value = equals + 1;
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            std::cerr << "Option --" << key << " needs a value.\n";
+            return false;
+        }
+
+        if (key == CONFIG_OPTION) {
+            if (!load_scenario(scenario, value)) {
+                return false;
+            }
+        } else if (!set_scenario_value(scenario, key, value)) {
+            std::cerr << "Invalid option --" << key << "=" << value << ".\n";
+            return false;
+        }
+    }
+
+    return true;
+}
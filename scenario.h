@@ -0,0 +1,81 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        scenario.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These functions load a scenario (how many of each
+//                 object a game has, how big its world and window are,
+//                 and the values it's played with) from a config file
+//                 and command line options, so games of any size can
+//                 be run without recompiling.
+//
+//    Date:        10/14/2019
+//
+//*******************************************************************
+
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+// C/C++ Standard libraries
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "simulation.h"
+
+// Scenario defaults
+const GLuint DEFAULT_BAD_GUYS = 6;  // number of bad guys to create
+const GLuint DEFAULT_GOOD_GUYS = 10;  // number of good guys to create
+const GLuint DEFAULT_TREES = 40;  // number of trees to create
+const GLuint DEFAULT_DROPS = 8;  // number of food drops the player starts with
+const float DEFAULT_WINDOW_WIDTH = 1200;  // window width in pixels
+const float DEFAULT_WINDOW_HEIGHT = 600;  // window height in pixels
+const float DEFAULT_TICK_RATE = 60;  // simulation updates per second
+
+// Option that names a config file on the command line
+constexpr char const* CONFIG_OPTION = "config";
+
+// Everything a game is set up with
+struct Scenario {
+    GLuint bad_guys;  // number of bad guys to create
+    GLuint good_guys;  // number of good guys to create
+    GLuint trees;  // number of trees to create
+    GLuint drops;  // number of food drops the player starts with
+    vec2 world_size;  // size of the world (0 by 0 makes it match the window)
+    vec2 window_size;  // size of the window in pixels
+    float tick_rate;  // simulation updates per second
+    uint64_t seed;  // seed the maps are made from
+    GLuint threads;  // threads units are updated on (0 means one per core)
+    Tuning tuning;  // gameplay values
+    std::string map;  // map file to play instead of making maps (empty for none)
+    std::string record;  // file to record the game's inputs to, to replay them (empty for none)
+    std::string trace;  // file to write a Chrome trace of the game to (empty for none)
+    std::string counters;  // file to write the work counted every DEFAULT_DUMP_TICKS ticks to (empty for none)
+};
+
+// Function to get the scenario every game starts from
+Scenario default_scenario();
+
+// Function to tell whether a scenario has a world size of its own (instead of matching the window)
+bool has_world_size(const Scenario& scenario);
+
+// Function to get the size of a scenario's world (its window size, if it has none of its own)
+vec2 get_world_size(const Scenario& scenario);
+
+// Function to set one value of a scenario by name, returning false if the name or value isn't valid
+bool set_scenario_value(Scenario& scenario, const std::string& key, const std::string& value);
+
+// Function to set the values listed in a config file ("key = value" lines, # starting comments)
+bool load_scenario(Scenario& scenario, const std::string& path);
+
+// Function to apply --key=value and --config=file options in order, keeping the other arguments
+bool parse_scenario_args(Scenario& scenario, int argc, char** argv, std::vector<char*>& rest);
+
+#endif
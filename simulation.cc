@@ -0,0 +1,2237 @@
+//******************************************************************* 
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        simulation.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a data structure to store the
+//                 game world and provides helper functions for
+//                 updating it based on delta time. It makes no OpenGL
+//                 or GLUT calls, so it can run without a context.
+//
+//    Date:        10/8/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+// Source libraries
+#include "simulation.h"
+#include "utilities.h"
+
+//******************************************************************
+//
+//  Function:   hash_trees
+//
+//  Purpose:    returns a fingerprint of a map's trees
+//
+//  Parameters: trees
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the hash of the trees' positions and radii
+//                   (so two maps with the same hash almost surely have
+//                   the same trees)
+//
+//  Calls:      hash_bytes, CircleStore::get_positions,
+//              CircleStore::get_init_radii
+//
+//******************************************************************
+static uint64_t hash_trees(const CircleStore& trees) {
+    uint64_t hash = hash_bytes(trees.get_positions().data(), trees.size() * sizeof(vec2));
+    return hash_bytes(trees.get_init_radii().data(), trees.size() * sizeof(float), hash);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_seed
+//
+//  Purpose:    returns the seed the maps are made from
+//
+//  Parameters: none
+//
+//  Member/Global Variables: seed
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the value of seed
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t Simulation::get_seed() const {
+    return seed;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_score
+//
+//  Purpose:    returns the player's score
+//
+//  Parameters: none
+//
+//  Member/Global Variables: score
+//
+//  Pre Conditions:  variable score must have a valid value
+//
+//  Post Conditions: returns the value of score
+//
+//  Calls:      none
+//
+//******************************************************************
+float Simulation::get_score() const {
+    return score;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_drops_left
+//
+//  Purpose:    returns the number of drops the player has left
+//
+//  Parameters: none
+//
+//  Member/Global Variables: drops_left
+//
+//  Pre Conditions:  variable drops_left must have a valid value
+//
+//  Post Conditions: returns the value of drops_left
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint Simulation::get_drops_left() const {
+    return drops_left;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_world_size
+//
+//  Purpose:    returns the size of the world
+//
+//  Parameters: none
+//
+//  Member/Global Variables: world_size
+//
+//  Pre Conditions:  variable world_size must have a valid value
+//
+//  Post Conditions: returns the value of world_size
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 Simulation::get_world_size() const {
+    return world_size;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_tuning
+//
+//  Purpose:    returns the gameplay values of the simulation
+//
+//  Parameters: none
+//
+//  Member/Global Variables: tuning
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the value of tuning
+//
+//  Calls:      none
+//
+//******************************************************************
+const Tuning& Simulation::get_tuning() const {
+    return tuning;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_bad_guys
+//
+//  Purpose:    returns the bad guys
+//
+//  Parameters: none
+//
+//  Member/Global Variables: bad_guys
+//
+//  Pre Conditions:  variable bad_guys must have a valid value
+//
+//  Post Conditions: returns the value of bad_guys
+//
+//  Calls:      none
+//
+//******************************************************************
+const UnitStore& Simulation::get_bad_guys() const {
+    return bad_guys;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_good_guys
+//
+//  Purpose:    returns the good guys
+//
+//  Parameters: none
+//
+//  Member/Global Variables: good_guys
+//
+//  Pre Conditions:  variable good_guys must have a valid value
+//
+//  Post Conditions: returns the value of good_guys
+//
+//  Calls:      none
+//
+//******************************************************************
+const UnitStore& Simulation::get_good_guys() const {
+    return good_guys;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_trees
+//
+//  Purpose:    returns the trees
+//
+//  Parameters: none
+//
+//  Member/Global Variables: trees
+//
+//  Pre Conditions:  variable trees must have a valid value
+//
+//  Post Conditions: returns the value of trees
+//
+//  Calls:      none
+//
+//******************************************************************
+const CircleStore& Simulation::get_trees() const {
+    return trees;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_food_drops
+//
+//  Purpose:    returns the food drops
+//
+//  Parameters: none
+//
+//  Member/Global Variables: food_drops
+//
+//  Pre Conditions:  variable food_drops must have a valid value
+//
+//  Post Conditions: returns the value of food_drops
+//
+//  Calls:      none
+//
+//******************************************************************
+const CircleStore& Simulation::get_food_drops() const {
+    return food_drops;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_plane
+//
+//  Purpose:    returns the drop plane
+//
+//  Parameters: none
+//
+//  Member/Global Variables: plane
+//
+//  Pre Conditions:  variable plane must have a valid value
+//
+//  Post Conditions: returns the value of plane
+//
+//  Calls:      none
+//
+//******************************************************************
+const UnitStore& Simulation::get_plane() const {
+    return plane;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_sampling_stats
+//
+//  Purpose:    returns how often picking random unit positions failed
+//
+//  Parameters: none
+//
+//  Member/Global Variables: sampling_stats
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the counts since the simulation was created
+//                   or last reset
+//
+//  Calls:      none
+//
+//******************************************************************
+const SamplingStats& Simulation::get_sampling_stats() const {
+    return sampling_stats;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_visibility_bytes
+//
+//  Purpose:    returns the memory the visibility cache takes on this map
+//
+//  Parameters: none
+//
+//  Member/Global Variables: visibility
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the bytes of the cache's pair table, or 0 if
+//                   the cache is turned off or the world is too big for
+//                   it
+//
+//  Calls:      VisibilityCache::get_bytes
+//
+//******************************************************************
+uint64_t Simulation::get_visibility_bytes() const {
+    return visibility.get_bytes();
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_map
+//
+//  Purpose:    returns a view of the current map's objects
+//
+//  Parameters: none
+//
+//  Member/Global Variables: seed, maps_made, world_size, drops_left,
+//                           trees, bad_guys, good_guys
+//
+//  Pre Conditions:  init must have been called
+//
+//  Post Conditions: returns the map with its trees, the units where they
+//                   stand now, and the drops left, pointing into the
+//                   stores (so it's only valid until the next update)
+//
+//  Calls:      CircleStore::get_positions, CircleStore::get_init_radii,
+//              UnitStore::get_positions, UnitStore::get_rotations
+//
+//******************************************************************
+MapView Simulation::get_map() const {
+    MapView map;
+    map.seed = seed;
+    map.map_index = maps_made - 1;
+    map.world_size = world_size;
+    map.drops = drops_left;
+    map.num_trees = trees.size();
+    map.tree_positions = trees.get_positions().data();
+    map.tree_radii = trees.get_init_radii().data();
+    map.num_bad_guys = bad_guys.size();
+    map.bad_positions = bad_guys.get_positions().data();
+    map.bad_rotations = bad_guys.get_rotations().data();
+    map.num_good_guys = good_guys.size();
+    map.good_positions = good_guys.get_positions().data();
+    map.good_rotations = good_guys.get_rotations().data();
+    return map;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_state_hash
+//
+//  Purpose:    returns a fingerprint of the whole state of the game
+//
+//  Parameters: none
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the hash of the game's snapshot, so two
+//                   games with the same hash almost surely play out the
+//                   same from here (the snapshot is made just for this,
+//                   so it's meant for checkpoints, not every tick)
+//
+//  Calls:      save_snapshot, hash_bytes
+//
+//******************************************************************
+uint64_t Simulation::get_state_hash() const {
+    std::vector<unsigned char> snapshot;
+    save_snapshot(snapshot);
+    return hash_bytes(snapshot.data(), snapshot.size());
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::set_world_size
+//
+//  Purpose:    sets the world size variable of the simulation class
+//
+//  Parameters: size
+//
+//  Member/Global Variables: world_size
+//
+//  Pre Conditions:  size must have a valid value
+//
+//  Post Conditions: world_size will equal size
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::set_world_size(const vec2& size) {
+    world_size = size;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::set_tuning
+//
+//  Purpose:    sets the gameplay values of the simulation
+//
+//  Parameters: values
+//
+//  Member/Global Variables: tuning
+//
+//  Pre Conditions:  values must have valid (positive) values, and the
+//                   simulation must not be in the middle of a map (unit
+//                   speeds are given out by init, and the line of sight
+//                   cache is built for its ranges)
+//
+//  Post Conditions: tuning will equal values
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::set_tuning(const Tuning& values) {
+    tuning = values;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::set_visibility_cache
+//
+//  Purpose:    sets whether line of sight between cells is cached
+//
+//  Parameters: enabled
+//
+//  Member/Global Variables: use_visibility_cache
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: use_visibility_cache will equal enabled, taking
+//                   effect the next time init is called
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::set_visibility_cache(bool enabled) {
+    use_visibility_cache = enabled;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::set_angle_tolerance
+//
+//  Purpose:    sets how far the rotations of moving objects may be off
+//
+//  Parameters: tolerance
+//
+//  Member/Global Variables: bad_guys, good_guys, plane
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every unit and the plane will be updated with
+//                   rotations within tolerance radians of exact
+//                   (positions, and so the game itself, are the same
+//                   for any tolerance)
+//
+//  Calls:      UnitStore::set_angle_tolerance
+//
+//******************************************************************
+void Simulation::set_angle_tolerance(float tolerance) {
+    bad_guys.set_angle_tolerance(tolerance);
+    good_guys.set_angle_tolerance(tolerance);
+    plane.set_angle_tolerance(tolerance);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::set_seed
+//
+//  Purpose:    sets the seed the maps are made from
+//
+//  Parameters: s
+//
+//  Member/Global Variables: seed, maps_made
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the next init will make the first map of seed s,
+//                   and every map after it will be the same as any
+//                   other game with the same seed
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::set_seed(uint64_t s) {
+    seed = s;
+    maps_made = 0;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::set_phase_timers
+//
+//  Purpose:    sets where the phases of every update are timed
+//
+//  Parameters: t
+//
+//  Member/Global Variables: timers
+//
+//  Pre Conditions:  t must outlive the simulation, or be unset first
+//
+//  Post Conditions: every update from now on will count the time it and
+//                   each of its phases took in t (none if t is null)
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::set_phase_timers(PhaseTimers* t) {
+    timers = t;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::set_trace_recorder
+//
+//  Purpose:    sets where the phases of every update, and the food and
+//              units coming and going, are traced
+//
+//  Parameters: t
+//
+//  Member/Global Variables: trace, pool
+//
+//  Pre Conditions:  t must outlive the simulation, or be unset first,
+//                   and no update may be running
+//
+//  Post Conditions: every update and map made from now on will be traced
+//                   in t while it's open, along with the chunks of units
+//                   each thread updates (nothing is traced if t is null)
+//
+//  Calls:      ThreadPool::set_trace_recorder
+//
+//******************************************************************
+void Simulation::set_trace_recorder(TraceRecorder* t) {
+    trace = t;
+    pool.set_trace_recorder(t);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::set_work_counters
+//
+//  Purpose:    sets where the work every update does is counted
+//
+//  Parameters: c
+//
+//  Member/Global Variables: counters
+//
+//  Pre Conditions:  c must outlive the simulation, or be unset first,
+//                   and no update may be running
+//
+//  Post Conditions: every update from now on will count its line of
+//                   sight tests, trees tested, wander targets tried,
+//                   food drops considered, and objects removed in c, and
+//                   end a tick of it (nothing is counted if c is null)
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::set_work_counters(WorkCounters* c) {
+    counters = c;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::update
+//
+//  Purpose:    to update all of the world objects and state based on given
+//              delta time
+//
+//  Parameters: dt
+//
+//  Member/Global Variables: good_guys, drops_left, food_drops, plane_visible,
+//                           score, tuning, timers, trace, counters
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: the world state will have been updated based on dt,
+//                   the time it took timed if there are timers and
+//                   traced if there's a trace, and a tick of work ended
+//                   if there are counters
+//
+//  Calls:      is_game_over, update_plane, update_food, update_bad_guys,
+//              update_good_guys, ScopedTimer, ScopedTrace,
+//              WorkCounters::end_tick
+//
+//******************************************************************
+void Simulation::update(float dt) {
+    // check if game ended
+    if (is_game_over()) {
+        // check if player gets extra points
+        if (drops_left > 0) {
+            score += drops_left * tuning.food_per_drop;  // give left over drops to player as points
+            drops_left = 0;
+        }
+    } else {
+        // call individual update functions, timing each one (and the whole tick, once the game is on)
+        ScopedTimer tick_timer(timers, PHASE_TICK);
+        ScopedTrace tick_span(trace, TRACE_SIM, PHASE_NAMES[PHASE_TICK]);
+        {
+            ScopedTimer timer(timers, PHASE_PLANE);
+            ScopedTrace span(trace, TRACE_SIM, PHASE_NAMES[PHASE_PLANE]);
+            update_plane(dt);
+        }
+        {
+            ScopedTimer timer(timers, PHASE_FOOD);
+            ScopedTrace span(trace, TRACE_SIM, PHASE_NAMES[PHASE_FOOD]);
+            update_food(dt);
+        }
+        {
+            ScopedTimer timer(timers, PHASE_BAD_GUYS);
+            ScopedTrace span(trace, TRACE_SIM, PHASE_NAMES[PHASE_BAD_GUYS]);
+            update_bad_guys(dt);
+        }
+        {
+            ScopedTimer timer(timers, PHASE_GOOD_GUYS);
+            ScopedTrace span(trace, TRACE_SIM, PHASE_NAMES[PHASE_GOOD_GUYS]);
+            update_good_guys(dt);
+        }
+    }
+
+    // every tick ends one of the counters, so their lines stay in step with the ticks played
+    if (counters != nullptr) {
+        counters->end_tick();
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::init
+//
+//  Purpose:    initializes all of the world objects
+//
+//  Parameters: none
+//
+//  Member/Global Variables: num_trees, trees, num_bad_guys, bad_guys,
+//                           num_good_guys, good_guys, free_space,
+//                           tree_scatter, sampling_stats, map_random,
+//                           tuning, TREE_MIN_SIZE, TREE_MAX_SIZE,
+//                           world_size, BAD_SIZE, GOOD_SIZE
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: all of the world objects will have been created according
+//                   to the gameplay constants (trees evenly spread and
+//                   never overlapping, units in the space left between
+//                   them), and every store will have room for as many
+//                   objects as the game can ever have
+//
+//  Calls:      ScopedTrace, begin_map, PoissonDisk::scatter,
+//              PoissonDisk::get_position, PoissonDisk::get_radius,
+//              CircleStore::add, build_map_indices, FreeSpace::sample,
+//              RandomStream::next, UnitStore::add
+//
+//******************************************************************
+void Simulation::init() {
+    ScopedTrace span(trace, TRACE_ENTITY, "make map");
+    begin_map();
+
+    // trees are spread evenly over the world, never closer to each other than the clearance
+    tree_scatter.scatter(map_random, num_trees, TREE_MIN_SIZE, TREE_MAX_SIZE, tuning.tree_clearance,
+                         -world_size / 2, world_size / 2);
+    for (GLuint i = 0; i < tree_scatter.size(); ++i) {
+        trees.add(tree_scatter.get_position(i), tree_scatter.get_radius(i), 0, 0);
+    }
+    sampling_stats.tree_failures += num_trees - tree_scatter.size();
+
+    build_map_indices();
+
+    for (GLuint i = 0; i < num_bad_guys; ++i) {
+        vec2 pos;
+        if (!free_space.sample(map_random, pos)) {
+            sampling_stats.spawn_failures++;
+            continue;
+        }
+        float rot = map_random.next() * 2 * E_PI;
+
+        bad_guys.add(pos, rot, BAD_SIZE, 0, tuning.bad_speed, tuning.bad_boost_factor);
+    }
+
+    for (GLuint i = 0; i < num_good_guys; ++i) {
+        vec2 pos;
+        if (!free_space.sample(map_random, pos)) {
+            sampling_stats.spawn_failures++;
+            continue;
+        }
+        float rot = map_random.next() * 2 * E_PI;
+
+        good_guys.add(pos, rot, GOOD_SIZE, tuning.good_max_food, tuning.good_speed, tuning.good_boost_factor);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::init
+//
+//  Purpose:    initializes all of the world objects from a saved map
+//
+//  Parameters: map
+//
+//  Member/Global Variables: seed, maps_made, world_size, drops_left,
+//                           num_drops, num_trees, num_bad_guys,
+//                           num_good_guys, trees, bad_guys, good_guys,
+//                           tuning, BAD_SIZE, GOOD_SIZE
+//
+//  Pre Conditions:  the simulation must be empty (just constructed, or
+//                   reset), and every array of map must hold as many
+//                   values as its count says
+//
+//  Post Conditions: the world will hold the map's objects, copied array
+//                   by array, with the map's world size and drops left;
+//                   the random streams will be the ones of the map's
+//                   seed and index, so the game plays out the same as
+//                   it did on the map it was saved from
+//
+//  Calls:      ScopedTrace, std::max, begin_map, CircleStore::assign,
+//              build_map_indices, UnitStore::assign
+//
+//******************************************************************
+void Simulation::init(const MapView& map) {
+    ScopedTrace span(trace, TRACE_ENTITY, "load map");
+    seed = map.seed;
+    maps_made = map.map_index;
+    world_size = map.world_size;
+    drops_left = map.drops;
+    num_drops = std::max(num_drops, map.drops);
+    num_trees = map.num_trees;
+    num_bad_guys = map.num_bad_guys;
+    num_good_guys = map.num_good_guys;
+
+    begin_map();
+    trees.assign(map.tree_positions, map.tree_radii, map.num_trees, 0, 0);
+    build_map_indices();
+    bad_guys.assign(map.bad_positions, map.bad_rotations, map.num_bad_guys,
+                    BAD_SIZE, 0, tuning.bad_speed, tuning.bad_boost_factor);
+    good_guys.assign(map.good_positions, map.good_rotations, map.num_good_guys,
+                     GOOD_SIZE, tuning.good_max_food, tuning.good_speed, tuning.good_boost_factor);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::reset
+//
+//  Purpose:    removes every world object and restores the starting
+//              state, so that init can create a new map
+//
+//  Parameters: none
+//
+//  Member/Global Variables: score, drops_left, num_drops, plane, trees,
+//                           bad_guys, good_guys, food_drops,
+//                           plane_visible, dropping_food, sampling_stats,
+//                           bad_targeting, good_targeting, spawned_food
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the simulation will be in the same state as when it
+//                   was constructed, but the stores keep their memory,
+//                   so the next init doesn't allocate
+//
+//  Calls:      UnitStore::clear, CircleStore::clear, clear_flow_fields
+//
+//******************************************************************
+void Simulation::reset() {
+    score = 0;
+    drops_left = num_drops;
+
+    // the stores only hold plain values, so clearing them is just resetting their sizes
+    plane.clear();
+    trees.clear();
+    bad_guys.clear();
+    good_guys.clear();
+    food_drops.clear();
+
+    // the new map's food and unit ids start over, so nothing targets them yet
+    bad_targeting.first_targeter.clear();
+    bad_targeting.listed_food.clear();
+    good_targeting.first_targeter.clear();
+    good_targeting.listed_food.clear();
+    spawned_food.clear();
+    clear_flow_fields();
+
+    plane_visible = false;
+    dropping_food = false;
+
+    sampling_stats = SamplingStats();
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::save_snapshot
+//
+//  Purpose:    writes the whole state of the game into a flat buffer
+//
+//  Parameters: buffer
+//
+//  Member/Global Variables: seed, maps_made, world_size, trees, score,
+//                           drops_left, plane_visible, dropping_food,
+//                           retarget_all, sampling_stats, map_random,
+//                           wander_random, plane_random, food_drops,
+//                           bad_guys, good_guys, plane, bad_targeting,
+//                           good_targeting, spawned_food, SNAPSHOT_MAGIC,
+//                           SNAPSHOT_VERSION
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: buffer will hold everything that carries over from
+//                   one tick to the next (every store with its ids, the
+//                   random streams, score, drops, and plane, and the
+//                   units listed as targeting each food drop), so that
+//                   restoring it plays out exactly the same from there;
+//                   the settings the game was made with (tuning, counts,
+//                   threads) aren't included, and buffer only allocates
+//                   if it has no room
+//
+//  Calls:      SnapshotWriter::write, hash_trees, CircleStore::save,
+//              RandomStream::save, UnitStore::save,
+//              SnapshotWriter::write_array
+//
+//******************************************************************
+void Simulation::save_snapshot(std::vector<unsigned char>& buffer) const {
+    SnapshotWriter out(buffer);
+    out.write(SNAPSHOT_MAGIC);
+    out.write(SNAPSHOT_VERSION);
+
+    // which map this is, so restoring it on the same map can skip rebuilding the indices
+    out.write(seed);
+    out.write(maps_made);
+    out.write(world_size);
+    out.write(hash_trees(trees));
+    trees.save(out);
+
+    out.write(score);
+    out.write(drops_left);
+    out.write(plane_visible);
+    out.write(dropping_food);
+    out.write(retarget_all);
+    out.write(sampling_stats);
+    map_random.save(out);
+    wander_random.save(out);
+    plane_random.save(out);
+
+    food_drops.save(out);
+    bad_guys.save(out);
+    good_guys.save(out);
+    plane.save(out);
+
+    // the lists of each food drop's units, in the order the units eat
+    out.write_array(bad_targeting.first_targeter);
+    out.write_array(bad_targeting.next_targeter);
+    out.write_array(bad_targeting.prev_targeter);
+    out.write_array(bad_targeting.listed_food);
+    out.write_array(good_targeting.first_targeter);
+    out.write_array(good_targeting.next_targeter);
+    out.write_array(good_targeting.prev_targeter);
+    out.write_array(good_targeting.listed_food);
+    out.write_array(spawned_food);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::restore_snapshot
+//
+//  Purpose:    puts the game back in the state saved in a buffer
+//
+//  Parameters: buffer
+//
+//  Member/Global Variables: everything save_snapshot writes
+//
+//  Pre Conditions:  the simulation must have the same tuning as the one
+//                   the snapshot was saved from
+//
+//  Post Conditions: the game will be exactly as it was saved, and units
+//                   will find the food they targeted by its saved id
+//                   (flow fields aren't saved: on the same map the ones
+//                   of food drops still in the game are kept, and the
+//                   rest are built again, the same as they were);
+//                   the spatial indices are only rebuilt if the snapshot
+//                   is of another map, so restoring on the same map only
+//                   copies arrays (which don't allocate if they have
+//                   room); returns false, after printing why to standard
+//                   error, if buffer isn't a snapshot of this version (the
+//                   game is left alone) or is cut short (the game is left
+//                   in no particular state, and should be reset)
+//
+//  Calls:      SnapshotReader::read, std::memcmp, hash_trees,
+//              CircleStore::restore, RandomStream::restore,
+//              UnitStore::restore,
+//              SnapshotReader::read_array, SnapshotReader::is_done,
+//              mark_moved_units, build_map_indices, clear_flow_fields, CircleStore::find,
+//              FlowField::get_goal, release_flow_field, build_flow_fields
+//
+//******************************************************************
+bool Simulation::restore_snapshot(const std::vector<unsigned char>& buffer) {
+    SnapshotReader in(buffer.data(), buffer.size());
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    uint32_t version;
+    if (!in.read(magic) || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 ||
+        !in.read(version) || version != SNAPSHOT_VERSION) {
+        std::cerr << "Not a version " << SNAPSHOT_VERSION << " snapshot.\n";
+        return false;
+    }
+
+    uint64_t saved_seed = seed;
+    uint64_t saved_maps_made = maps_made;
+    vec2 saved_world_size = world_size;
+    uint64_t saved_trees = 0;
+    in.read(saved_seed);
+    in.read(saved_maps_made);
+    in.read(saved_world_size);
+    in.read(saved_trees);
+    bool same_map = saved_seed == seed && saved_maps_made == maps_made &&
+                    saved_world_size.x == world_size.x && saved_world_size.y == world_size.y &&
+                    saved_trees == hash_trees(trees);
+    seed = saved_seed;
+    maps_made = saved_maps_made;
+    world_size = saved_world_size;
+    bool valid = trees.restore(in);
+
+    in.read(score);
+    in.read(drops_left);
+    in.read(plane_visible);
+    in.read(dropping_food);
+    in.read(retarget_all);
+    in.read(sampling_stats);
+    map_random.restore(in);
+    wander_random.restore(in);
+    plane_random.restore(in);
+
+    valid = food_drops.restore(in) && valid;
+    valid = bad_guys.restore(in) && valid;
+    valid = good_guys.restore(in) && valid;
+    valid = plane.restore(in) && valid;
+
+    in.read_array(bad_targeting.first_targeter);
+    in.read_array(bad_targeting.next_targeter);
+    in.read_array(bad_targeting.prev_targeter);
+    in.read_array(bad_targeting.listed_food);
+    in.read_array(good_targeting.first_targeter);
+    in.read_array(good_targeting.next_targeter);
+    in.read_array(good_targeting.prev_targeter);
+    in.read_array(good_targeting.listed_food);
+    in.read_array(spawned_food);
+
+    if (!valid || !in.is_done()) {
+        std::cerr << "Snapshot is damaged, and couldn't be restored.\n";
+        return false;
+    }
+
+    // the units that moved into another retarget cell follow from where they were, so
+    // they're marked again rather than saved
+    bad_targeting.retarget.resize(bad_guys.size());
+    mark_moved_units(bad_guys, bad_targeting, 0, bad_guys.size());
+    good_targeting.retarget.resize(good_guys.size());
+    mark_moved_units(good_guys, good_targeting, 0, good_guys.size());
+
+    // the flow fields aren't saved: on the same map the ones still leading to a saved food drop
+    // are kept, and the rest are built now, so the next update doesn't have to
+    if (!same_map) {
+        build_map_indices();
+        clear_flow_fields();
+    }
+    for (GLuint food_id = 0; food_id < food_fields.size(); ++food_id) {
+        GLuint i = food_drops.find(food_id);
+        if (food_fields[food_id] != NO_ID &&
+            (i == NO_ID || flow_fields[food_fields[food_id]].get_goal().x != food_drops.get_position(i).x ||
+             flow_fields[food_fields[food_id]].get_goal().y != food_drops.get_position(i).y)) {
+            release_flow_field(food_id);
+        }
+    }
+    build_flow_fields();
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::request_drop
+//
+//  Purpose:    to schedule a food drop at the given world position
+//
+//  Parameters: pos
+//
+//  Member/Global Variables: drops_left, plane_visible, dropping_food,
+//                           plane, plane_random, world_size, PLANE_SIZE
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: if the player has drops left, the plane isn't
+//                   already doing a drop, and pos is traversable, the
+//                   plane will be sent to drop food at pos and true
+//                   will be returned
+//
+//  Calls:      is_traversable, UnitStore::set_position,
+//              UnitStore::set_target_pos, RandomStream::next
+//
+//******************************************************************
+bool Simulation::request_drop(const vec2& pos) {
+    if (drops_left == 0 || plane_visible) {  // ensure we have drops left and plane isn't already doing a drop
+        return false;
+    }
+    if (!is_traversable(pos)) {  // one last check to make sure the position is traversable
+        return false;
+    }
+
+    // schedule a food drop
+    plane_visible = true;
+    dropping_food = true;
+    // set plane to random position off screen and make it target drop position
+    plane.set_position(0, vec2(-world_size.x / 2 - PLANE_SIZE, world_size.y * (plane_random.next() - 0.5)));
+    plane.set_target_pos(0, pos);
+
+    drops_left--;  // we used one drop, so decrement
+
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::boost_good_guy
+//
+//  Purpose:    to make the good guy at the given index zoom
+//
+//  Parameters: index
+//
+//  Member/Global Variables: good_guys, tuning
+//
+//  Pre Conditions:  index must be a valid index into good_guys
+//
+//  Post Conditions: the good guy will have been given a speed boost
+//
+//  Calls:      UnitStore::give_boost
+//
+//******************************************************************
+void Simulation::boost_good_guy(GLuint index) {
+    good_guys.give_boost(index, tuning.speed_boost_duration);  // give boost
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::boost_bad_guy
+//
+//  Purpose:    to make the bad guy at the given index slow
+//
+//  Parameters: index
+//
+//  Member/Global Variables: bad_guys, tuning
+//
+//  Pre Conditions:  index must be a valid index into bad_guys
+//
+//  Post Conditions: the bad guy will have been given a speed boost
+//                   (its boost factor is less than one, so it slows down)
+//
+//  Calls:      UnitStore::give_boost
+//
+//******************************************************************
+void Simulation::boost_bad_guy(GLuint index) {
+    bad_guys.give_boost(index, tuning.speed_boost_duration);  // give boost (it's boost factor is less than one, so it slows down)
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::is_plane_visible
+//
+//  Purpose:    to determine whether the drop plane is flying
+//
+//  Parameters: none
+//
+//  Member/Global Variables: plane_visible
+//
+//  Pre Conditions:  plane_visible must have a valid value
+//
+//  Post Conditions: returns the value of plane_visible
+//
+//  Calls:      none
+//
+//******************************************************************
+bool Simulation::is_plane_visible() const {
+    return plane_visible;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::is_game_over
+//
+//  Purpose:    to determine whether the game has ended
+//
+//  Parameters: none
+//
+//  Member/Global Variables: good_guys, drops_left, food_drops, plane_visible
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: returns true if all good guys are fed, or if the
+//                   player has no drops left and none are in play
+//
+//  Calls:      none
+//
+//******************************************************************
+bool Simulation::is_game_over() const {
+    return good_guys.size() == 0 || (drops_left == 0 && food_drops.size() == 0 && !plane_visible);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::target_food
+//
+//  Purpose:    to make the given unit target the given food if it can
+//              walk to it and it is closer than its current target
+//
+//  Parameters: units, unit, food, range
+//
+//  Member/Global Variables: food_drops
+//
+//  Pre Conditions:  unit must be a valid index into units, food a valid
+//                   index into food_drops, and the flow fields built
+//                   this tick
+//
+//  Post Conditions: the unit will be targeting food if it can walk to
+//                   food within range, and food is closer on foot than
+//                   the unit's old target
+//
+//  Calls:      UnitStore::get_position, CircleStore::get_id,
+//              get_food_distance, UnitStore::get_target_food,
+//              UnitStore::set_target_food, CircleStore::get_position
+//
+//******************************************************************
+void Simulation::target_food(UnitStore& units, GLuint unit, GLuint food, float range) {
+    vec2 unit_pos = units.get_position(unit);
+    GLuint food_id = food_drops.get_id(food);
+    float new_length = get_food_distance(food_id, unit_pos);
+    if (new_length <= range) {
+        GLuint target_id = units.get_target_food(unit);
+        // see if unit has a target already or not
+        if (target_id == NO_ID) {
+            units.set_target_food(unit, food_id, food_drops.get_position(food));  // target food
+        } else if (target_id != food_id) {
+            // unit already has a target, but see if this food is closer (a target
+            // removed earlier this tick has no field, so it's infinitely far)
+            if (new_length < get_food_distance(target_id, unit_pos)) {
+                units.set_target_food(unit, food_id, food_drops.get_position(food));  // target food
+            }
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_food_distance
+//
+//  Purpose:    to find how far a position is from a food drop on foot
+//
+//  Parameters: food_id, pos
+//
+//  Member/Global Variables: flow_fields, food_fields
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the walking distance from pos to the food
+//                   drop, looked up in its flow field; returns infinity
+//                   if the food drop has no field (it's gone, or landed
+//                   since the fields were built) or can't be walked to
+//                   within the field's range
+//
+//  Calls:      FlowField::get_distance
+//
+//******************************************************************
+float Simulation::get_food_distance(GLuint food_id, const vec2& pos) const {
+    if (food_id >= food_fields.size() || food_fields[food_id] == NO_ID) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return flow_fields[food_fields[food_id]].get_distance(pos);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::remove_gone_food
+//
+//  Purpose:    to remove the food drops that ran out of food
+//
+//  Parameters: none
+//
+//  Member/Global Variables: food_drops, bad_guys, good_guys,
+//                           bad_targeting, good_targeting, trace,
+//                           counters
+//
+//  Pre Conditions:  food_drops must have a valid value
+//
+//  Post Conditions: every food drop that ran out will have been removed
+//                   (and traced and counted, if there's a trace or
+//                   counters), no unit will be targeting one of them,
+//                   and their flow fields will be free for reuse
+//
+//  Calls:      CircleStore::get_id, CircleStore::is_gone,
+//              release_targeters, release_flow_field, CircleStore::remove,
+//              TraceRecorder::add_instant, WorkCounters::add
+//
+//******************************************************************
+void Simulation::remove_gone_food() {
+    // food only changes while it is visited, so whether it is gone is already known
+    // for every food, and its units can let go of it before any of them retarget
+    for (GLuint i = 0; i < food_drops.size(); ++i) {
+        if (food_drops.is_gone(i)) {  // food ran out, need to handle deleting it
+            GLuint food_id = food_drops.get_id(i);
+            release_targeters(bad_guys, bad_targeting, food_id);
+            release_targeters(good_guys, good_targeting, food_id);
+            release_flow_field(food_id);
+
+            // order doesn't need to preserved, so the store pops it out in constant time
+            food_drops.remove(i);
+            if (trace != nullptr) {
+                trace->add_instant(TRACE_ENTITY, "food gone", "id", food_id);
+            }
+            if (counters != nullptr) {
+                counters->add(COUNTER_REMOVED);
+            }
+
+            i--;  // we put a different element at index i, so next loop iteration needs to be at i again
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::release_targeters
+//
+//  Purpose:    to untarget the units of a group that were targeting the
+//              given food drop
+//
+//  Parameters: units, targeting, food_id
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  the group's retarget flags must be sized to its
+//                   units
+//
+//  Post Conditions: no unit of the group will be targeting food_id, or
+//                   be listed as targeting it, and the ones that were
+//                   will be marked to look for food again; only the
+//                   units that were listed as targeting it are visited
+//
+//  Calls:      get_first_targeter, UnitStore::find,
+//              UnitStore::set_target_food
+//
+//******************************************************************
+void Simulation::release_targeters(UnitStore& units, FoodTargeting& targeting, GLuint food_id) {
+    GLuint unit_id = get_first_targeter(targeting, food_id);
+    while (unit_id != NO_ID) {
+        // the whole list goes at once, so each unit is just unmarked as listed
+        GLuint next = targeting.next_targeter[unit_id];
+        targeting.listed_food[unit_id] = NO_ID;
+
+        GLuint j = units.find(unit_id);
+        if (j != NO_ID) {
+            units.set_target_food(j, NO_ID, vec2());
+            targeting.retarget[j] = 1;  // its target is gone, so it looks for another
+        }
+        unit_id = next;
+    }
+
+    if (food_id < targeting.first_targeter.size()) {
+        targeting.first_targeter[food_id] = NO_ID;
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::mark_retargets
+//
+//  Purpose:    to list the units of a group that have to look for food
+//              again this tick
+//
+//  Parameters: units, targeting, range
+//
+//  Member/Global Variables: spawned_food, unit_hash, nearby
+//
+//  Pre Conditions:  the group's retarget flags must be sized to its
+//                   units, with the units whose target is gone, and
+//                   the ones that moved into another retarget cell on
+//                   the last tick, already marked
+//
+//  Post Conditions: targeting will hold, in ascending order, the units
+//                   that were marked or that are within range of a
+//                   food drop made since the last tick
+//
+//  Calls:      PointHash::build, UnitStore::get_positions,
+//              PointHash::query, UnitStore::get_position, dot
+//
+//******************************************************************
+void Simulation::mark_retargets(const UnitStore& units, FoodTargeting& targeting, float range) {
+    // a new food drop can only change the minds of the units that can see it, and units
+    // move every tick, so they're only hashed on the ticks food lands
+    if (!spawned_food.empty()) {
+        unit_hash.build(units.get_positions(), range);
+        for (GLuint i = 0; i < spawned_food.size(); ++i) {
+            unit_hash.query(spawned_food[i], range, nearby);
+            for (GLuint k = 0; k < nearby.size(); ++k) {
+                vec2 dir = units.get_position(nearby[k]) - spawned_food[i];
+                if (dot(dir, dir) <= range * range) {
+                    targeting.retarget[nearby[k]] = 1;
+                }
+            }
+        }
+    }
+
+    targeting.retargets.clear();
+    for (GLuint j = 0; j < units.size(); ++j) {
+        if (targeting.retarget[j]) {
+            targeting.retargets.push_back(j);
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::mark_moved_units
+//
+//  Purpose:    to mark the units of a group that moved into another
+//              retarget cell, so they look for food again
+//
+//  Parameters: units, targeting, begin, end
+//
+//  Member/Global Variables: RETARGET_CELL_SIZE
+//
+//  Pre Conditions:  the group's retarget flags must be sized to its
+//                   units, and begin <= end <= units.size()
+//
+//  Post Conditions: the retarget flags of units begin to end - 1 will be
+//                   set if they moved into another retarget cell on
+//                   their last update, and cleared otherwise; only
+//                   their flags are touched, so ranges can be marked in
+//                   parallel
+//
+//  Calls:      UnitStore::get_position, UnitStore::get_prev_position,
+//              std::floor
+//
+//******************************************************************
+void Simulation::mark_moved_units(const UnitStore& units, FoodTargeting& targeting, GLuint begin, GLuint end) {
+    // a unit only sees differently once it has moved far enough
+    for (GLuint j = begin; j < end; ++j) {
+        vec2 cell = units.get_position(j) / RETARGET_CELL_SIZE;
+        vec2 prev_cell = units.get_prev_position(j) / RETARGET_CELL_SIZE;
+        targeting.retarget[j] = std::floor(cell.x) != std::floor(prev_cell.x) ||
+                                std::floor(cell.y) != std::floor(prev_cell.y);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::find_nearby_food
+//
+//  Purpose:    to list the food drops near each unit of a group that
+//              has to look for food again
+//
+//  Parameters: units, targeting, range
+//
+//  Member/Global Variables: food_hash, nearby
+//
+//  Pre Conditions:  food_hash must hold this tick's food drops, with
+//                   cells at least range wide, and mark_retargets must
+//                   have been called for the group this tick
+//
+//  Post Conditions: targeting will hold the indices of the food drops
+//                   whose hash cells are within range of each listed
+//                   unit, in ascending order
+//
+//  Calls:      UnitStore::get_position, PointHash::query
+//
+//******************************************************************
+void Simulation::find_nearby_food(const UnitStore& units, FoodTargeting& targeting, float range) {
+    targeting.near_start.resize(targeting.retargets.size() + 1);
+    targeting.near_food.clear();
+    for (GLuint k = 0; k < targeting.retargets.size(); ++k) {
+        targeting.near_start[k] = targeting.near_food.size();
+        food_hash.query(units.get_position(targeting.retargets[k]), range, nearby);
+        targeting.near_food.insert(targeting.near_food.end(), nearby.begin(), nearby.end());
+    }
+    targeting.near_start[targeting.retargets.size()] = targeting.near_food.size();
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::target_nearby_food
+//
+//  Purpose:    to retarget a range of the listed units of a group
+//
+//  Parameters: units, targeting, range, begin, end
+//
+//  Member/Global Variables: counters
+//
+//  Pre Conditions:  find_nearby_food must have been called for the
+//                   group this tick, and begin and end must be a valid
+//                   range of positions in its list of units
+//
+//  Post Conditions: the listed units begin to end - 1 will target the
+//                   same food as if every food drop had been visited in
+//                   order (and the food drops they considered counted,
+//                   if there are counters); only these units' elements
+//                   are touched, so disjoint ranges can be run at the
+//                   same time
+//
+//  Calls:      WorkCounters::add, target_food
+//
+//******************************************************************
+void Simulation::target_nearby_food(UnitStore& units, FoodTargeting& targeting, float range, GLuint begin, GLuint end) {
+    if (counters != nullptr) {
+        // every nearby food drop of every unit in the range is considered once
+        counters->add(COUNTER_TARGET_FOOD, targeting.near_start[end] - targeting.near_start[begin]);
+    }
+    for (GLuint k = begin; k < end; ++k) {
+        GLuint j = targeting.retargets[k];
+        for (GLuint m = targeting.near_start[k]; m < targeting.near_start[k + 1]; ++m) {
+            // make unit target food if possible
+            target_food(units, j, targeting.near_food[m], range);
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::list_targeters
+//
+//  Purpose:    to move the retargeted units of a group to the lists of
+//              the food drops they now target
+//
+//  Parameters: units, targeting
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  the group's listed units must have been retargeted
+//                   this tick
+//
+//  Post Conditions: every unit of the group will be listed under the
+//                   food drop it targets; only the retargeted units are
+//                   visited (the rest can't have changed targets), in
+//                   ascending order, so the lists come out the same
+//                   however many threads retargeted them; a unit that
+//                   changed targets goes to the front of its new list
+//
+//  Calls:      UnitStore::get_id, UnitStore::get_target_food,
+//              list_targeter
+//
+//******************************************************************
+void Simulation::list_targeters(const UnitStore& units, FoodTargeting& targeting) {
+    for (GLuint k = 0; k < targeting.retargets.size(); ++k) {
+        GLuint j = targeting.retargets[k];
+        list_targeter(targeting, units.get_id(j), units.get_target_food(j));
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::list_targeter
+//
+//  Purpose:    to move a unit to the list of the food drop it targets
+//
+//  Parameters: targeting, unit_id, food_id
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the unit will be listed first under food_id, and
+//                   nowhere else (nowhere at all if food_id is NO_ID);
+//                   a unit already listed under food_id keeps its place,
+//                   and the lists only allocate if they have no room
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::list_targeter(FoodTargeting& targeting, GLuint unit_id, GLuint food_id) {
+    if (unit_id >= targeting.listed_food.size()) {
+        targeting.listed_food.resize(unit_id + 1, NO_ID);
+        targeting.next_targeter.resize(unit_id + 1, NO_ID);
+        targeting.prev_targeter.resize(unit_id + 1, NO_ID);
+    }
+    GLuint old_id = targeting.listed_food[unit_id];
+    if (old_id == food_id) {
+        return;
+    }
+
+    // unlink it from its old food drop's list
+    if (old_id != NO_ID) {
+        GLuint prev = targeting.prev_targeter[unit_id];
+        GLuint next = targeting.next_targeter[unit_id];
+        if (prev != NO_ID) {
+            targeting.next_targeter[prev] = next;
+        } else {
+            targeting.first_targeter[old_id] = next;
+        }
+        if (next != NO_ID) {
+            targeting.prev_targeter[next] = prev;
+        }
+    }
+
+    // and link it in at the front of the new one's
+    targeting.listed_food[unit_id] = food_id;
+    if (food_id != NO_ID) {
+        if (food_id >= targeting.first_targeter.size()) {
+            targeting.first_targeter.resize(food_id + 1, NO_ID);
+        }
+        GLuint next = targeting.first_targeter[food_id];
+        targeting.prev_targeter[unit_id] = NO_ID;
+        targeting.next_targeter[unit_id] = next;
+        if (next != NO_ID) {
+            targeting.prev_targeter[next] = unit_id;
+        }
+        targeting.first_targeter[food_id] = unit_id;
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::get_first_targeter
+//
+//  Purpose:    to find the first unit of a group listed as targeting a
+//              food drop
+//
+//  Parameters: targeting, food_id
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the id of the first unit listed under
+//                   food_id (the rest follow through next_targeter), or
+//                   NO_ID if none are
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint Simulation::get_first_targeter(const FoodTargeting& targeting, GLuint food_id) const {
+    if (food_id >= targeting.first_targeter.size()) {
+        return NO_ID;
+    }
+    return targeting.first_targeter[food_id];
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::reserve_targeting
+//
+//  Purpose:    to allocate the retargeting lists of a group of units up
+//              front
+//
+//  Parameters: targeting, units
+//
+//  Member/Global Variables: num_drops
+//
+//  Pre Conditions:  units must be the most units the group can have
+//
+//  Post Conditions: the lists whose size is bounded by the number of
+//                   units or food drops won't need to allocate (the
+//                   nearby food lists still grow with how crowded the
+//                   food drops get)
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::reserve_targeting(FoodTargeting& targeting, GLuint units) {
+    targeting.retarget.reserve(units);
+    targeting.retargets.reserve(units);
+    targeting.near_start.reserve(units + 1);
+    targeting.first_targeter.reserve(num_drops);
+    targeting.next_targeter.reserve(units);
+    targeting.prev_targeter.reserve(units);
+    targeting.listed_food.reserve(units);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::pick_wander_target
+//
+//  Purpose:    to give a unit a random position target that it can
+//              reach within range
+//
+//  Parameters: units, unit, range
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  unit must be a valid index into units
+//
+//  Post Conditions: unit will be heading for a traversable position it
+//                   can reach, or, if none was found in
+//                   MAX_WANDER_ATTEMPTS tries, keep its target (and try
+//                   again next tick)
+//
+//  Calls:      UnitStore::get_position, find_wander_target,
+//              UnitStore::set_target_pos
+//
+//******************************************************************
+void Simulation::pick_wander_target(UnitStore& units, GLuint unit, float range) {
+    vec2 pos;
+    if (find_wander_target(units.get_position(unit), range, pos)) {
+        units.set_target_pos(unit, pos);  // set target position
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::find_wander_target
+//
+//  Purpose:    to find a random position that a unit can reach within
+//              range, as wandering units pick where to go
+//
+//  Parameters: from, range, pos
+//
+//  Member/Global Variables: free_space, wander_random, sampling_stats,
+//                           counters, MAX_WANDER_ATTEMPTS
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: pos will be a traversable position reachable from
+//                   from within range and true returned, or false
+//                   returned if none was found in MAX_WANDER_ATTEMPTS
+//                   tries; the tries are drawn from the wander random
+//                   stream, and counted in the sampling stats (and the
+//                   counters, if there are any)
+//
+//  Calls:      WorkCounters::add, FreeSpace::sample_near, can_reach
+//
+//******************************************************************
+bool Simulation::find_wander_target(const vec2& from, float range, vec2& pos) {
+    // only try positions that are traversable to begin with, and only a few of them,
+    // since a unit boxed in by trees may have nowhere it can see to go
+    for (GLuint attempt = 0; attempt < MAX_WANDER_ATTEMPTS; ++attempt) {
+        if (counters != nullptr) {
+            counters->add(COUNTER_WANDER_ATTEMPTS);
+        }
+        if (!free_space.sample_near(wander_random, from, range, pos)) {
+            break;  // no free space anywhere in range
+        }
+        if (can_reach(from, pos, range)) {
+            sampling_stats.wander_picks++;
+            return true;
+        }
+        sampling_stats.wander_rejections++;
+    }
+
+    sampling_stats.wander_failures++;
+    return false;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::build_flow_fields
+//
+//  Purpose:    to find the way to each food drop that doesn't have one
+//              yet
+//
+//  Parameters: none
+//
+//  Member/Global Variables: food_drops, flow_fields, food_fields,
+//                           free_fields, tree_grid, world_size, tuning,
+//                           counters, FLOW_CELL_SIZE
+//
+//  Pre Conditions:  tree_grid must have been built from the trees
+//
+//  Post Conditions: every food drop will have a flow field covering as
+//                   far as either group of units can see, built once
+//                   when it landed and reusing the memory of a field
+//                   freed earlier if there is one (and counted, if
+//                   there are counters)
+//
+//  Calls:      CircleStore::get_id, CircleStore::get_position,
+//              FlowField::build, WorkCounters::add, std::max
+//
+//******************************************************************
+void Simulation::build_flow_fields() {
+    for (GLuint i = 0; i < food_drops.size(); ++i) {
+        GLuint food_id = food_drops.get_id(i);
+        if (food_id >= food_fields.size()) {
+            food_fields.resize(food_id + 1, NO_ID);
+        }
+        if (food_fields[food_id] != NO_ID) {
+            continue;  // food never moves, so its way never changes
+        }
+
+        if (free_fields.empty()) {
+            free_fields.push_back(flow_fields.size());
+            flow_fields.push_back(FlowField());
+        }
+        food_fields[food_id] = free_fields.back();
+        free_fields.pop_back();
+
+        // both groups walk the same way, so one field as far as either can see serves them both
+        flow_fields[food_fields[food_id]].build(tree_grid, food_drops.get_position(i),
+                                                std::max(tuning.bad_range, tuning.good_range),
+                                                -world_size / 2, world_size / 2, FLOW_CELL_SIZE);
+        if (counters != nullptr) {
+            counters->add(COUNTER_FLOW_FIELDS);
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::release_flow_field
+//
+//  Purpose:    to free the way to a food drop that ran out
+//
+//  Parameters: food_id
+//
+//  Member/Global Variables: food_fields, free_fields
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the food drop will have no flow field, and the one
+//                   it had (if any) can be reused by the next food drop
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::release_flow_field(GLuint food_id) {
+    if (food_id < food_fields.size() && food_fields[food_id] != NO_ID) {
+        free_fields.push_back(food_fields[food_id]);
+        food_fields[food_id] = NO_ID;
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::clear_flow_fields
+//
+//  Purpose:    to free the way to every food drop
+//
+//  Parameters: none
+//
+//  Member/Global Variables: flow_fields, food_fields, free_fields
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: no food drop will have a flow field, so they're all
+//                   built again on the next update (from the trees as
+//                   they are then), keeping their memory
+//
+//  Calls:      none
+//
+//******************************************************************
+void Simulation::clear_flow_fields() {
+    food_fields.clear();
+    free_fields.clear();
+    for (GLuint i = 0; i < flow_fields.size(); ++i) {
+        free_fields.push_back(i);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::steer_units
+//
+//  Purpose:    to point a range of units along the way to their food
+//
+//  Parameters: units, begin, end
+//
+//  Member/Global Variables: flow_fields, food_fields
+//
+//  Pre Conditions:  begin and end must be a valid range of units, and
+//                   the flow fields built this tick
+//
+//  Post Conditions: units begin to end - 1 that target food will be
+//                   heading for the next spot on the way to it, looked
+//                   up in its flow field; only these units' elements are
+//                   touched, so disjoint ranges can be run at the same
+//                   time
+//
+//  Calls:      UnitStore::get_target_food, UnitStore::get_position,
+//              FlowField::get_waypoint, UnitStore::steer
+//
+//******************************************************************
+void Simulation::steer_units(UnitStore& units, GLuint begin, GLuint end) {
+    for (GLuint i = begin; i < end; ++i) {
+        GLuint food_id = units.get_target_food(i);
+        if (food_id != NO_ID && food_id < food_fields.size() && food_fields[food_id] != NO_ID) {
+            units.steer(i, flow_fields[food_fields[food_id]].get_waypoint(units.get_position(i)));
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::begin_map
+//
+//  Purpose:    readies the stores and random streams for a new map
+//
+//  Parameters: none
+//
+//  Member/Global Variables: plane, num_trees, trees, num_bad_guys, bad_guys,
+//                           num_good_guys, good_guys, num_drops, food_drops,
+//                           nearby, spawned_food, flow_fields,
+//                           food_fields, free_fields, retarget_all,
+//                           bad_targeting, good_targeting, seed,
+//                           maps_made, map_random, wander_random,
+//                           plane_random, MAP_STREAM, WANDER_STREAM,
+//                           PLANE_STREAM, STREAMS_PER_MAP, tuning,
+//                           PLANE_SIZE
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: every store will have room for as many objects as
+//                   the game can ever have, the map will have its own
+//                   random streams, and the plane will have been made
+//
+//  Calls:      UnitStore::reserve, CircleStore::reserve, reserve_targeting,
+//              RandomStream::RandomStream, UnitStore::add
+//
+//******************************************************************
+void Simulation::begin_map() {
+    // allocate everything up front, so that ticking the game never allocates
+    // (units are only ever removed, and there can't be more food drops than drops)
+    plane.reserve(1);
+    trees.reserve(num_trees);
+    bad_guys.reserve(num_bad_guys);
+    good_guys.reserve(num_good_guys);
+    food_drops.reserve(num_drops);
+    nearby.reserve(num_drops);
+    spawned_food.reserve(num_drops);
+    flow_fields.reserve(num_drops);
+    food_fields.reserve(num_drops);
+    free_fields.reserve(num_drops);
+    reserve_targeting(bad_targeting, num_bad_guys);
+    reserve_targeting(good_targeting, num_good_guys);
+
+    // no unit has looked for food on this map yet
+    retarget_all = true;
+
+    // give this map its own streams, so that it's the same whenever the seed is
+    uint64_t first_stream = maps_made * STREAMS_PER_MAP;
+    maps_made++;
+    map_random = RandomStream(seed, first_stream + MAP_STREAM);
+    wander_random = RandomStream(seed, first_stream + WANDER_STREAM);
+    plane_random = RandomStream(seed, first_stream + PLANE_STREAM);
+
+    // create drop plane
+    plane.add(vec2(), 0, PLANE_SIZE, 0, tuning.plane_speed, 1);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::build_map_indices
+//
+//  Purpose:    builds the spatial indices of the map's trees
+//
+//  Parameters: none
+//
+//  Member/Global Variables: trees, tree_grid, visibility,
+//                           use_visibility_cache, free_space, world_size,
+//                           tuning, VISIBILITY_CELL_SIZE,
+//                           FREE_SPACE_CELL_SIZE, BAD_SIZE, GOOD_SIZE
+//
+//  Pre Conditions:  trees must hold every tree of the map
+//
+//  Post Conditions: the tree grid, visibility cache, and free space will
+//                   cover the map's trees
+//
+//  Calls:      TreeGrid::build, VisibilityCache::build,
+//              VisibilityCache::clear, FreeSpace::build, std::max
+//
+//******************************************************************
+void Simulation::build_map_indices() {
+    // trees never move, so the grid only needs building once per map
+    float clearance = std::max(BAD_SIZE, GOOD_SIZE) / 2;
+    tree_grid.build(trees, clearance);
+
+    // and line of sight between two spots never changes either, so it's remembered for
+    // the whole map (only for units looking as far as they can see, and inside the world)
+    if (use_visibility_cache) {
+        visibility.build(trees, clearance, -world_size / 2, world_size / 2,
+                         VISIBILITY_CELL_SIZE, std::max(tuning.bad_range, tuning.good_range));
+    } else {
+        visibility.clear();
+    }
+
+    // units are placed straight into the space between the trees (if a map has none, it gets no units)
+    free_space.build(trees, clearance, -world_size / 2, world_size / 2, FREE_SPACE_CELL_SIZE);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::update_food
+//
+//  Purpose:    to update all of the food drops based on given delta time
+//
+//  Parameters: dt
+//
+//  Member/Global Variables: food_drops, bad_guys, good_guys, bad_targeting,
+//                           good_targeting, spawned_food, retarget_all,
+//                           food_hash, pool, score, tuning
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: the food drops in the game will have been updated based
+//                   on dt, the same however many threads there are, each
+//                   food drop's units eating from the one that most
+//                   recently started targeting it to the one that started
+//                   first; only the units marked to look for food again
+//                   will have been retargeted
+//
+//  Calls:      remove_gone_food, build_flow_fields, mark_retargets,
+//              PointHash::build,
+//              CircleStore::get_positions, find_nearby_food, ThreadPool::run,
+//              target_nearby_food, list_targeters, CircleStore::get_id,
+//              get_first_targeter,
+//              UnitStore::find, UnitStore::is_at, CircleStore::get_position,
+//              CircleStore::take_amount, CircleStore::give_amount,
+//              UnitStore::give_food, CircleStore::advance
+//
+//******************************************************************
+void Simulation::update_food(float dt) {
+    // a unit only looks for food again when something it could see changed: it moved into
+    // another retarget cell (marked as it moved), its target ran out, or a food drop landed
+    // within its range (on a map's first tick, every unit looks)
+    if (retarget_all) {
+        bad_targeting.retarget.assign(bad_guys.size(), 1);
+        good_targeting.retarget.assign(good_guys.size(), 1);
+    }
+    remove_gone_food();
+    build_flow_fields();
+    mark_retargets(bad_guys, bad_targeting, tuning.bad_range);
+    mark_retargets(good_guys, good_targeting, tuning.good_range);
+    spawned_food.clear();
+    retarget_all = false;
+
+    // food doesn't move, but drops come and go, so hash their positions once per tick
+    food_hash.build(food_drops.get_positions(), std::max(tuning.bad_range, tuning.good_range));
+
+    // which food a unit targets only depends on that unit, so units are retargeted
+    // in parallel
+    find_nearby_food(bad_guys, bad_targeting, tuning.bad_range);
+    pool.run(bad_targeting.retargets.size(), [this](GLuint begin, GLuint end) {
+        target_nearby_food(bad_guys, bad_targeting, tuning.bad_range, begin, end);
+    });
+    list_targeters(bad_guys, bad_targeting);
+
+    find_nearby_food(good_guys, good_targeting, tuning.good_range);
+    pool.run(good_targeting.retargets.size(), [this](GLuint begin, GLuint end) {
+        target_nearby_food(good_guys, good_targeting, tuning.good_range, begin, end);
+    });
+    list_targeters(good_guys, good_targeting);
+
+    // food amounts and the score are shared, so eating happens on this thread; only the
+    // units targeting a food drop can be eating from it, and they eat in the order they're
+    // listed, the one that most recently started targeting it first (not in unit order, so
+    // when a drop runs short, the units that came to it last are the ones fed)
+    for (GLuint i = 0; i < food_drops.size(); ++i) {
+        GLuint food_id = food_drops.get_id(i);
+        vec2 food_pos = food_drops.get_position(i);
+
+        // bad guys eat first (a unit's target position is only on the way to its food until it gets there)
+        for (GLuint id = get_first_targeter(bad_targeting, food_id); id != NO_ID; id = bad_targeting.next_targeter[id]) {
+            if (bad_guys.is_at(bad_guys.find(id), food_pos)) {  // unit is already at the food
+                float avail = food_drops.take_amount(i, tuning.bad_food_rate * dt);  // take food from drop
+                score -= avail;  // decrement score by avail
+            }
+        }
+
+        for (GLuint id = get_first_targeter(good_targeting, food_id); id != NO_ID; id = good_targeting.next_targeter[id]) {
+            GLuint j = good_guys.find(id);
+            if (!good_guys.is_at(j, food_pos)) {  // unit isn't at the food yet
+                continue;
+            }
+
+            float amnt = tuning.good_food_rate * dt;  // amount of food the guy will take
+            float avail = food_drops.take_amount(i, amnt);  // take food from drop
+            avail -= good_guys.give_food(j, avail);  // give food to unit;
+            score += amnt - avail;  // increment score by avail
+            if (avail >= 1e-3) {  // if avail is greater than 0
+                food_drops.give_amount(i, avail);  // unit couldn't take all of the food, give back to drop
+            }
+        }
+    }
+
+    // food drops shrink at a steady rate, so the store works out their sizes from the time
+    food_drops.advance(dt);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::update_bad_guys
+//
+//  Purpose:    to update all of the bad guys based on given delta time
+//
+//  Parameters: dt
+//
+//  Member/Global Variables: bad_guys, bad_targeting, pool, tuning
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: the bad guys in the game will have been updated based
+//                   on given delta time (dt), the ones going for food
+//                   walking the way to it, and the ones that moved into
+//                   another retarget cell marked to look for food again
+//
+//  Calls:      UnitStore::get_target_food, UnitStore::is_at_target,
+//              pick_wander_target, ThreadPool::run, steer_units,
+//              UnitStore::update, mark_moved_units
+//
+//******************************************************************
+void Simulation::update_bad_guys(float dt) {
+    for (GLuint i = 0; i < bad_guys.size(); ++i) {
+        // if bad guy doesn't have a target, give it a random position target
+        if (bad_guys.get_target_food(i) == NO_ID && bad_guys.is_at_target(i)) {
+            pick_wander_target(bad_guys, i, tuning.bad_range);
+        }
+    }
+
+    // a unit's movement doesn't affect any other unit, so move them all at once, in parallel
+    bad_targeting.retarget.resize(bad_guys.size());
+    pool.run(bad_guys.size(), [this, dt](GLuint begin, GLuint end) {
+        steer_units(bad_guys, begin, end);  // head for the next spot on the way to the food
+        bad_guys.update(begin, end, dt);  // update position and rotation, etc.
+        mark_moved_units(bad_guys, bad_targeting, begin, end);  // and see if it has to look for food again
+    });
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::update_good_guys
+//
+//  Purpose:    to update all of the good guys based on given delta time
+//
+//  Parameters: dt
+//
+//  Member/Global Variables: good_guys, good_targeting, pool, score, tuning,
+//                           trace, counters
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: the good guys in the game will have been updated based
+//                   on given delta time (dt), the ones going for food
+//                   walking the way to it, the ones that moved into
+//                   another retarget cell marked to look for food again,
+//                   and the ones removed for being full traced and
+//                   counted if there's a trace or counters
+//
+//  Calls:      UnitStore::is_full, TraceRecorder::add_instant,
+//              WorkCounters::add,
+//              UnitStore::get_id, UnitStore::remove,
+//              UnitStore::get_target_food, UnitStore::is_at_target,
+//              pick_wander_target, ThreadPool::run, steer_units,
+//              UnitStore::update, mark_moved_units
+//
+//******************************************************************
+void Simulation::update_good_guys(float dt) {
+    for (GLuint i = 0; i < good_guys.size(); ++i) {
+        if (good_guys.is_full(i)) {  // if good guy is full
+            // need to remove from game
+            if (trace != nullptr) {
+                trace->add_instant(TRACE_ENTITY, "good guy fed", "id", good_guys.get_id(i));
+            }
+            if (counters != nullptr) {
+                counters->add(COUNTER_REMOVED);
+            }
+            list_targeter(good_targeting, good_guys.get_id(i), NO_ID);  // it no longer eats from its food
+            // order doesn't need to preserved, so the store pops it out in constant time
+            good_guys.remove(i);
+
+            score += tuning.good_max_food * 2;  // increment score by double the amount of food the good guy got
+
+            i--;  // we put a different element at index i, so next loop iteration needs to be at i again
+        } else {
+            // if good guy doesn't have a target, give it a random position target
+            if (good_guys.get_target_food(i) == NO_ID && good_guys.is_at_target(i)) {
+                pick_wander_target(good_guys, i, tuning.good_range);
+            }
+        }
+    }
+
+    // a unit's movement doesn't affect any other unit, so move them all at once, in parallel
+    good_targeting.retarget.resize(good_guys.size());
+    pool.run(good_guys.size(), [this, dt](GLuint begin, GLuint end) {
+        steer_units(good_guys, begin, end);  // head for the next spot on the way to the food
+        good_guys.update(begin, end, dt);  // update position, rotation, etc.
+        mark_moved_units(good_guys, good_targeting, begin, end);  // and see if it has to look for food again
+    });
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::update_plane
+//
+//  Purpose:    to update the plane based on given delta time
+//
+//  Parameters: dt
+//
+//  Member/Global Variables: plane, plane_visible, dropping_food, FOOD_SIZE,
+//                           tuning, world_size,
+//                           plane_random, PLANE_SIZE, spawned_food, trace
+//
+//  Pre Conditions:  all of the above variables must have valid values
+//
+//  Post Conditions: the plane in the game will have been updated based
+//                   on given delta time (dt), and any food it dropped
+//                   traced if there's a trace
+//
+//  Calls:      UnitStore::is_at_target, UnitStore::get_position,
+//              CircleStore::add, TraceRecorder::add_instant,
+//              UnitStore::set_target_pos, RandomStream::next,
+//              UnitStore::update
+//
+//******************************************************************
+void Simulation::update_plane(float dt) {
+    if (plane_visible && plane.is_at_target(0)) {  // if plane has finished one of two stages
+        if (dropping_food) {  // plane reached drop position
+            // create food drop at location
+            GLuint food_id = food_drops.add(plane.get_position(0), FOOD_SIZE, tuning.food_per_drop, tuning.food_rot_speed);
+            spawned_food.push_back(plane.get_position(0));  // the units that can see it look for food again
+            if (trace != nullptr) {
+                trace->add_instant(TRACE_ENTITY, "food dropped", "id", food_id);
+            }
+
+            // make plane target somewhere random off-screen to the right
+            plane.set_target_pos(0, vec2(world_size.x / 2 + PLANE_SIZE, world_size.y * (plane_random.next() - 0.5)));
+
+            dropping_food = false;
+        } else {  // plane finished drop and left screen
+            plane_visible = false;
+        }
+    }
+
+    if (plane_visible) {
+        plane.update(dt);  // update position, rotation, etc.
+    }
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::is_within_bounds
+//
+//  Purpose:    to determine whether the given position is within world
+//              bounds or not
+//
+//  Parameters: pos
+//
+//  Member/Global Variables: world_size
+//
+//  Pre Conditions:  world_size and pos must have valid values
+//
+//  Post Conditions: will return true if pos is within the world bounds
+//
+//  Calls:      none
+//
+//******************************************************************
+bool Simulation::is_within_bounds(const vec2& pos) const {
+    vec2 half_world_size = world_size / 2;
+    if (pos.x < -half_world_size.x || pos.x > half_world_size.x) {  // x component out of world range
+        return false;
+    }
+    if (pos.y < -half_world_size.y || pos.y > half_world_size.y) {  // y component out of world range
+        return false;
+    }
+
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::is_traversable
+//
+//  Purpose:    to determine whether the given position is traversable
+//              for the units or not
+//
+//  Parameters: pos
+//
+//  Member/Global Variables: tree_grid
+//
+//  Pre Conditions:  tree_grid must have been built from the trees
+//
+//  Post Conditions: will return true if pos is traversable by units
+//
+//  Calls:      is_within_bounds, TreeGrid::point_blocked
+//
+//******************************************************************
+bool Simulation::is_traversable(const vec2& pos) const {
+    if (!is_within_bounds(pos)) {
+        return false;
+    }
+
+    // if position is within a tree's radius, it is not traversable
+    return !tree_grid.point_blocked(pos);
+}
+
+//******************************************************************
+//
+//  Function:   Simulation::can_reach
+//
+//  Purpose:    to determine whether given position a is reachable by
+//              given position b within range
+//
+//  Parameters: a, b, range
+//
+//  Member/Global Variables: tree_grid, visibility, counters
+//
+//  Pre Conditions:  tree_grid must have been built from the trees
+//
+//  Post Conditions: will return true if a is reachable by b within range;
+//                   the test, and the trees it was checked against, will
+//                   have been counted if there are counters
+//
+//  Calls:      WorkCounters::add, is_within_bounds, length,
+//              VisibilityCache::lookup, TreeGrid::segment_blocked
+//
+//******************************************************************
+bool Simulation::can_reach(const vec2& a, const vec2& b, float range) const {
+    if (counters != nullptr) {
+        counters->add(COUNTER_CAN_REACH);
+    }
+    if (!is_within_bounds(b)) {
+        // if a isn't in bounds either, let it slide
+        // this exception prevents crashing, but as a result
+        // some units may be lost outside the bounds of the window
+        // forever if you resize the window and they are cut off
+        if (is_within_bounds(a)) {
+            return false;
+        }
+    }
+
+    vec2 dir = b - a;  // get displacement vector from b to a
+    float dist = length(dir);
+
+    if (dist > range) {
+        return false;
+    }
+
+    // most segments are known to be clear or blocked from the cells they join
+    Visibility known = visibility.lookup(a, b);
+    if (known != VISIBILITY_UNKNOWN) {
+        return known == VISIBILITY_CLEAR;
+    }
+
+    // only the trees in the cells the segment crosses can block it
+    if (counters == nullptr) {
+        return !tree_grid.segment_blocked(a, b);
+    }
+    GLuint tested = 0;
+    bool blocked = tree_grid.segment_blocked(a, b, &tested);
+    counters->add(COUNTER_TREE_TESTS, tested);
+    return !blocked;
+}
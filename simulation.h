@@ -0,0 +1,400 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        simulation.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a data structure to store the
+//                 game world and provides helper functions for
+//                 updating it based on delta time. It makes no OpenGL
+//                 or GLUT calls, so it can run without a context.
+//
+//    Date:        10/6/2019
+//
+//*******************************************************************
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// C/C++ Standard libraries
+#include <cstdint>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "circle_store.h"
+#include "flow_field.h"
+#include "free_space.h"
+#include "map_file.h"
+#include "phase_timer.h"
+#include "poisson_disk.h"
+#include "random_stream.h"
+#include "snapshot.h"
+#include "thread_pool.h"
+#include "trace_recorder.h"
+#include "point_hash.h"
+#include "tree_grid.h"
+#include "unit_store.h"
+#include "visibility_cache.h"
+#include "work_counters.h"
+
+// World size constants
+const float BAD_SIZE = 30;
+const float GOOD_SIZE = 30;
+const float FOOD_SIZE = 20;
+const float TREE_MIN_SIZE = 25;
+const float TREE_MAX_SIZE = 55;
+const float PLANE_SIZE = 65;
+
+// Gameplay constants (the defaults of Tuning)
+const float FOOD_PER_DROP = 1000;  // amount of food in a drop
+const float FOOD_ROT_SPEED = 50;  // amount of food that rots every second
+const float GOOD_MAX_FOOD = 350;  // amount of food that a good guy needs to be full
+const float BAD_FOOD_RATE = 250;  // how much food bad guys take per second
+const float GOOD_FOOD_RATE = 150;  // how much food good guys take per second
+const float BAD_SPEED = 40;  // how far bad guys can move per second
+const float GOOD_SPEED = 30;  // how far good guys can move per second
+const float BAD_RANGE = 200;  // how far bad guys can see food from
+const float GOOD_RANGE = 150;  // how far good guys can see food from
+const float GOOD_BOOST_FACTOR = 4;  // speed boost factor for good guys
+const float BAD_BOOST_FACTOR = 0.25;  // speed boost factor for bad guys
+const float SPEED_BOOST_DURATION = 5;  // how long do speed boosts last for
+const float PLANE_SPEED = 600;  // speed of drop plane
+const float TREE_CLEARANCE = 0;  // least gap between the edges of two trees
+
+// Performance constants
+const float VISIBILITY_CELL_SIZE = 10;  // width of the cells that line of sight is cached between
+const float FREE_SPACE_CELL_SIZE = 10;  // width of the cells that random unit positions are picked from
+const float RETARGET_CELL_SIZE = 20;  // width of the cells that units look for food again whenever they move into
+const float FLOW_CELL_SIZE = 10;  // width of the cells that the way to each food drop is found over
+const GLuint MAX_WANDER_ATTEMPTS = 16;  // number of wander targets tried per unit per tick before giving up
+
+// Counts of how often picking random unit positions failed
+struct SamplingStats {
+    unsigned long wander_picks;  // number of wander targets picked
+    unsigned long wander_rejections;  // number of wander targets tried that couldn't be reached
+    unsigned long wander_failures;  // number of times a unit gave up on finding a wander target this tick
+    unsigned long spawn_failures;  // number of units that couldn't be placed, since the map has no room
+    unsigned long tree_failures;  // number of trees that couldn't be placed, since the map has no room
+};
+
+// Gameplay values a simulation is played with
+struct Tuning {
+    float food_per_drop;  // amount of food in a drop
+    float food_rot_speed;  // amount of food that rots every second
+    float good_max_food;  // amount of food that a good guy needs to be full
+    float bad_food_rate;  // how much food bad guys take per second
+    float good_food_rate;  // how much food good guys take per second
+    float bad_speed;  // how far bad guys can move per second
+    float good_speed;  // how far good guys can move per second
+    float bad_range;  // how far bad guys can see food from
+    float good_range;  // how far good guys can see food from
+    float good_boost_factor;  // speed boost factor for good guys
+    float bad_boost_factor;  // speed boost factor for bad guys
+    float speed_boost_duration;  // how long do speed boosts last for
+    float plane_speed;  // speed of drop plane
+    float tree_clearance;  // least gap between the edges of two trees
+};
+
+// Gameplay values a simulation starts with
+const Tuning DEFAULT_TUNING = {
+    FOOD_PER_DROP, FOOD_ROT_SPEED, GOOD_MAX_FOOD, BAD_FOOD_RATE, GOOD_FOOD_RATE, BAD_SPEED, GOOD_SPEED,
+    BAD_RANGE, GOOD_RANGE, GOOD_BOOST_FACTOR, BAD_BOOST_FACTOR, SPEED_BOOST_DURATION, PLANE_SPEED, TREE_CLEARANCE
+};
+
+//******************************************************************
+//
+//  Class: Simulation
+//
+//  Purpose:  To provide a data structure that handles the game world
+//            and updating it based on delta time, independent of
+//            any rendering.
+//
+//  Functions:
+//           Constructors
+//             Simulation() = delete
+//             Simulation(num_b_guys, num_g_guys,
+//                        num_ts, drops,
+//                        threads)  create simulation with given number good
+//                                  and bad guys, number trees, and drops,
+//                                  updating units on the given number of
+//                                  threads (0, the default, means one per core)
+//           getters
+//             get_seed to return the seed the maps are made from
+//             get_score to return the player's score
+//             get_drops_left to return the number of drops left
+//             get_world_size to return the size of the world
+//             get_tuning to return the gameplay values
+//             get_bad_guys to return the bad guys
+//             get_good_guys to return the good guys
+//             get_trees to return the trees
+//             get_food_drops to return the food drops
+//             get_plane to return the drop plane
+//             get_sampling_stats to return how often picking random
+//                                unit positions failed
+//             get_visibility_bytes to return the memory the visibility
+//                                  cache takes on this map (0 if it's off)
+//             get_map to return a view of the current map's objects, to
+//                     save it
+//             get_state_hash to return a fingerprint of the whole state
+//                            of the game
+//           setters
+//             set_world_size to set the world size variable
+//             set_tuning to set the gameplay values
+//             set_visibility_cache to set whether line of sight between
+//                                  cells is cached (from the next init)
+//             set_angle_tolerance to set how far unit rotations may be off
+//             set_seed to set the seed the maps are made from, starting
+//                      over from the first map
+//             set_phase_timers to set where the phases of every update are
+//                              timed
+//             set_trace_recorder to set where the phases of every update,
+//                                and the food and units coming and going,
+//                                are traced
+//             set_work_counters to set where the work every update does is
+//                               counted
+//           mutators
+//             update(dt) to update the world objects' positions and such
+//                        based on given delta time
+//             init() to initialize world objects
+//             init(map) to initialize world objects from a saved map
+//             reset() to remove every world object and restore the
+//                     starting score and drops, keeping memory for reuse
+//             restore_snapshot(buffer) puts the game back in the state
+//                                      saved in buffer
+//             request_drop(pos) schedules a food drop at pos if allowed
+//             boost_good_guy(index) gives the good guy at index a boost
+//             boost_bad_guy(index) gives the bad guy at index a boost
+//             find_wander_target(from, range, pos) finds a random position
+//                                                  reachable from from within
+//                                                  range, as wandering units
+//                                                  do
+//           helpers
+//             save_snapshot(buffer) writes the whole state of the game
+//                                   into buffer
+//             is_plane_visible() returns true if the plane is flying
+//             is_game_over() returns true if the game has ended
+//             is_traversable(pos) determines whether the given position
+//                                 is traversable by a unit or not
+//             can_reach(a, b, range) determines whether position b is
+//                                    reachable by position a within range
+//           private helpers
+//             target_food(units, unit, food, range) makes unit target
+//                                                   food if it can walk
+//                                                   to it within range
+//             get_food_distance(food_id, pos) returns how far pos is from
+//                                             a food drop on foot
+//             remove_gone_food() removes the food drops that ran out, and
+//                                untargets the units that were targeting them
+//             release_targeters(units, targeting,
+//                               food_id)  untargets the units of a group that
+//                                         were targeting the given food drop
+//             mark_retargets(units, targeting, range) lists the units of a
+//                                                     group that have to look
+//                                                     for food again
+//             mark_moved_units(units, targeting,
+//                              begin, end)  marks the units begin to end - 1
+//                                           that moved into another
+//                                           retarget cell
+//             find_nearby_food(units, targeting, range) lists the food
+//                                                       drops near each unit
+//                                                       that has to look again
+//             target_nearby_food(units, targeting, range,
+//                                begin, end)  retargets the listed units begin
+//                                             to end - 1
+//             list_targeters(units, targeting) moves the retargeted units of a
+//                                              group to the lists of their new
+//                                              food drops
+//             list_targeter(targeting, unit_id,
+//                           food_id)  moves a unit to the list of the given
+//                                     food drop (NO_ID for none)
+//             get_first_targeter(targeting, food_id) returns the first unit
+//                                                    listed as targeting a
+//                                                    food drop
+//             reserve_targeting(targeting, units) allocates a group's
+//                                                 retargeting lists
+//             pick_wander_target(units, unit, range) gives unit a random
+//                                                    position target it can
+//                                                    reach within range
+//             build_flow_fields() finds the way to each food drop that
+//                                 doesn't have one yet
+//             release_flow_field(food_id) frees the way to a food drop that
+//                                         ran out, for reuse
+//             clear_flow_fields() frees the way to every food drop
+//             steer_units(units, begin, end) points units begin to end - 1
+//                                            along the way to their food
+//             begin_map() readies the stores and random streams for a new map
+//             build_map_indices() builds the spatial indices of the trees
+//             update_food(dt) updates all of the food drops based on
+//                             given delta time
+//             update_bad_guys(dt) updates all of the bad guys based on
+//                             given delta time
+//             update_good_guys(dt) updates all of the good guys based on
+//                             given delta time
+//             update_plane(dt) updates the plane based on given delta
+//                              time
+//             is_within_bounds(pos) determines whether the given position
+//                                   is within the world bounds
+//
+//******************************************************************
+
+class Simulation {
+ public:
+    Simulation() = delete;  // no default constructor
+    Simulation(GLuint num_b_guys, GLuint num_g_guys, GLuint num_ts, GLuint drops, GLuint threads = 0)
+        : score(0), drops_left(drops), num_bad_guys(num_b_guys), num_good_guys(num_g_guys),
+          num_trees(num_ts), num_drops(drops), retarget_all(false),
+          plane_visible(false), dropping_food(false),
+          world_size(vec2()), tuning(DEFAULT_TUNING), use_visibility_cache(true), sampling_stats(), seed(0), maps_made(0),
+          pool(threads), timers(nullptr), trace(nullptr), counters(nullptr) {}
+    Simulation(const Simulation&) = delete;  // no copy constructor
+    Simulation operator=(const Simulation&) = delete;  // no copy assignment operator
+
+    // getters
+    uint64_t get_seed() const;
+    float get_score() const;
+    GLuint get_drops_left() const;
+    vec2 get_world_size() const;
+    const Tuning& get_tuning() const;
+    const UnitStore& get_bad_guys() const;
+    const UnitStore& get_good_guys() const;
+    const CircleStore& get_trees() const;
+    const CircleStore& get_food_drops() const;
+    const UnitStore& get_plane() const;
+    const SamplingStats& get_sampling_stats() const;
+    uint64_t get_visibility_bytes() const;
+    MapView get_map() const;
+    uint64_t get_state_hash() const;
+
+    // setters
+    void set_world_size(const vec2& size);
+    void set_tuning(const Tuning& values);
+    void set_visibility_cache(bool enabled);
+    void set_angle_tolerance(float tolerance);
+    void set_seed(uint64_t s);
+    void set_phase_timers(PhaseTimers* t);
+    void set_trace_recorder(TraceRecorder* t);
+    void set_work_counters(WorkCounters* c);
+
+    // mutators
+    void update(float dt);
+    void init();
+    void init(const MapView& map);
+    void reset();
+    bool restore_snapshot(const std::vector<unsigned char>& buffer);
+    bool request_drop(const vec2& pos);
+    void boost_good_guy(GLuint index);
+    void boost_bad_guy(GLuint index);
+    bool find_wander_target(const vec2& from, float range, vec2& pos);
+
+    // helpers
+    void save_snapshot(std::vector<unsigned char>& buffer) const;
+    bool is_plane_visible() const;
+    bool is_game_over() const;
+    bool is_traversable(const vec2& pos) const;
+    bool can_reach(const vec2& a, const vec2& b, float range) const;
+ private:
+    float score;  // user score
+    GLuint drops_left;  // drops left for the player
+
+    GLuint num_bad_guys;  // max number of bad guys
+    GLuint num_good_guys;  // max number of good guys
+    GLuint num_trees;  // max number of trees
+    GLuint num_drops;  // number of drops the player starts with
+
+    UnitStore bad_guys;  // store containing bad guys
+    UnitStore good_guys;  // store containing good guys
+    CircleStore trees;  // store containing trees
+    CircleStore food_drops;  // store containing food drops
+    TreeGrid tree_grid;  // spatial index over the trees, built once per map
+    VisibilityCache visibility;  // line of sight between cells, filled in as it's asked about
+    FreeSpace free_space;  // cells units can stand anywhere in, built once per map
+    PoissonDisk tree_scatter;  // spots trees are placed at, picked once per map (kept to reuse memory)
+
+    // Per-tick lists used to retarget one group of units in parallel (kept to reuse memory)
+    struct FoodTargeting {
+        std::vector<unsigned char> retarget;  // whether each unit has to look for food again (set as units move)
+        std::vector<GLuint> retargets;  // indices of the units that have to look for food again, in ascending order
+        std::vector<GLuint> near_start;  // index into near_food where each retargeted unit's food drops begin
+        std::vector<GLuint> near_food;  // food drops near each retargeted unit, grouped by unit
+
+        // The units targeting each food drop, as a doubly linked list through the unit ids, kept up
+        // to date as units change targets (so only the units that did are ever visited); each
+        // list runs from the unit that most recently started targeting the food to the first
+        std::vector<GLuint> first_targeter;  // id of the first unit targeting each food id (or NO_ID)
+        std::vector<GLuint> next_targeter;  // id of the next unit targeting the same food, by unit id (or NO_ID)
+        std::vector<GLuint> prev_targeter;  // id of the previous unit targeting the same food, by unit id (or NO_ID)
+        std::vector<GLuint> listed_food;  // id of the food each unit is listed as targeting, by unit id (or NO_ID)
+    };
+    FoodTargeting bad_targeting;  // retargeting lists of the bad guys
+    FoodTargeting good_targeting;  // retargeting lists of the good guys
+    std::vector<GLuint> nearby;  // scratch list of food drops near a unit, or units near a food drop (kept to reuse memory)
+    PointHash food_hash;  // spatial hash of the food drops, rebuilt every tick
+    PointHash unit_hash;  // spatial hash of one group's units, rebuilt on the ticks food lands
+    std::vector<vec2> spawned_food;  // positions of the food drops made since the food was last updated
+    std::vector<FlowField> flow_fields;  // way to each food drop, shared by every unit going for it (kept to reuse memory)
+    std::vector<GLuint> food_fields;  // index into flow_fields of each food id's field (or NO_ID)
+    std::vector<GLuint> free_fields;  // indices of the flow fields no food drop is using
+    bool retarget_all;  // whether every unit has to look for food on the next tick (the first of a map)
+
+    UnitStore plane;  // plane that makes the food drops (always its only unit)
+    bool plane_visible;  // whether or not the plane is visible
+    bool dropping_food;  // whether or not the plane is dropping food
+
+    vec2 world_size;  // size of the world, centered on the origin
+    Tuning tuning;  // gameplay values
+    bool use_visibility_cache;  // whether init builds the visibility cache
+
+    SamplingStats sampling_stats;  // how often picking random unit positions failed
+
+    // Random numbers: each map gets its own streams of the seed, so that a map only
+    // depends on the seed and how many maps were made before it
+    uint64_t seed;  // seed the maps are made from
+    uint64_t maps_made;  // number of maps made from the seed so far
+    RandomStream map_random;  // random numbers used to place trees and units
+    RandomStream wander_random;  // random numbers used to pick wander targets
+    RandomStream plane_random;  // random numbers used to fly the plane
+
+    ThreadPool pool;  // threads that units are updated on
+    PhaseTimers* timers;  // where the phases of every update are timed, or null to not time them (not owned)
+    TraceRecorder* trace;  // where the phases of every update are traced, or null to not trace them (not owned)
+    WorkCounters* counters;  // where the work of every update is counted, or null to not count it (not owned)
+
+    // static member variables
+    static const GLuint MAP_STREAM = 0;  // stream of a map's random numbers used for map_random
+    static const GLuint WANDER_STREAM = 1;  // stream of a map's random numbers used for wander_random
+    static const GLuint PLANE_STREAM = 2;  // stream of a map's random numbers used for plane_random
+    static const GLuint STREAMS_PER_MAP = 3;  // number of streams each map uses
+
+    // private helpers
+    void target_food(UnitStore& units, GLuint unit, GLuint food, float range);
+    float get_food_distance(GLuint food_id, const vec2& pos) const;
+    void remove_gone_food();
+    void release_targeters(UnitStore& units, FoodTargeting& targeting, GLuint food_id);
+    void mark_retargets(const UnitStore& units, FoodTargeting& targeting, float range);
+    void mark_moved_units(const UnitStore& units, FoodTargeting& targeting, GLuint begin, GLuint end);
+    void find_nearby_food(const UnitStore& units, FoodTargeting& targeting, float range);
+    void target_nearby_food(UnitStore& units, FoodTargeting& targeting, float range, GLuint begin, GLuint end);
+    void list_targeters(const UnitStore& units, FoodTargeting& targeting);
+    void list_targeter(FoodTargeting& targeting, GLuint unit_id, GLuint food_id);
+    GLuint get_first_targeter(const FoodTargeting& targeting, GLuint food_id) const;
+    void reserve_targeting(FoodTargeting& targeting, GLuint units);
+    void pick_wander_target(UnitStore& units, GLuint unit, float range);
+    void build_flow_fields();
+    void release_flow_field(GLuint food_id);
+    void clear_flow_fields();
+    void steer_units(UnitStore& units, GLuint begin, GLuint end);
+    void begin_map();
+    void build_map_indices();
+    void update_food(float dt);
+    void update_bad_guys(float dt);
+    void update_good_guys(float dt);
+    void update_plane(float dt);
+    bool is_within_bounds(const vec2& pos) const;
+};
+
+#endif
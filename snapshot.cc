@@ -0,0 +1,121 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        snapshot.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These classes write the state of a game into a flat
+//                 buffer of bytes and read it back, so that a game can
+//                 be saved and restored in one copy per array.
+//
+//    Date:        10/16/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <cstring>
+
+// Source libraries
+#include "snapshot.h"
+
+//******************************************************************
+//
+//  Function:   SnapshotWriter::write_bytes
+//
+//  Purpose:    appends bytes to the snapshot
+//
+//  Parameters: bytes, count
+//
+//  Member/Global Variables: buffer
+//
+//  Pre Conditions:  bytes must hold count bytes
+//
+//  Post Conditions: the bytes will have been appended to buffer (which
+//                   only allocates if it has no room left)
+//
+//  Calls:      std::vector::insert
+//
+//******************************************************************
+void SnapshotWriter::write_bytes(const void* bytes, size_t count) {
+    const unsigned char* first = static_cast<const unsigned char*>(bytes);
+    buffer.insert(buffer.end(), first, first + count);
+}
+
+//******************************************************************
+//
+//  Function:   SnapshotReader::read_bytes
+//
+//  Purpose:    reads bytes from the snapshot
+//
+//  Parameters: bytes, count
+//
+//  Member/Global Variables: data, size, pos, failed
+//
+//  Pre Conditions:  bytes must have room for count bytes
+//
+//  Post Conditions: if count bytes are left and no read has failed,
+//                   they will have been copied to bytes and true is
+//                   returned; otherwise the reader will have failed and
+//                   false is returned
+//
+//  Calls:      std::memcpy
+//
+//******************************************************************
+bool SnapshotReader::read_bytes(void* bytes, size_t count) {
+    if (failed || count > size - pos) {
+        failed = true;
+        return false;
+    }
+
+    if (count > 0) {
+        std::memcpy(bytes, data + pos, count);
+    }
+    pos += count;
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   SnapshotReader::is_ok
+//
+//  Purpose:    returns whether every read so far succeeded
+//
+//  Parameters: none
+//
+//  Member/Global Variables: failed
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if no read has run past the end of the
+//                   snapshot
+//
+//  Calls:      none
+//
+//******************************************************************
+bool SnapshotReader::is_ok() const {
+    return !failed;
+}
+
+//******************************************************************
+//
+//  Function:   SnapshotReader::is_done
+//
+//  Purpose:    returns whether the whole snapshot was read
+//
+//  Parameters: none
+//
+//  Member/Global Variables: failed, pos, size
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if every read succeeded and no bytes
+//                   are left over
+//
+//  Calls:      none
+//
+//******************************************************************
+bool SnapshotReader::is_done() const {
+    return !failed && pos == size;
+}
@@ -0,0 +1,229 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        snapshot.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These classes write the state of a game into a flat
+//                 buffer of bytes and read it back, so that a game can
+//                 be saved and restored in one copy per array.
+//
+//    Date:        10/16/2019
+//
+//*******************************************************************
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+// C/C++ Standard libraries
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Snapshot format constants
+const char SNAPSHOT_MAGIC[4] = { 'F', 'D', 'S', 'S' };  // first bytes of every snapshot
+const uint32_t SNAPSHOT_VERSION = 3;  // version of the layout written (snapshots of other versions are refused)
+
+//******************************************************************
+//
+//  Class: SnapshotWriter
+//
+//  Purpose:  To append plain values (ones that own no memory and have
+//            no padding, such as numbers and vec2s), and arrays of them, to
+//            a buffer of bytes, exactly as they sit in memory. Arrays are
+//            written as their length followed by their values.
+//
+//  Functions:
+//           Constructors
+//             SnapshotWriter() = delete
+//             SnapshotWriter(buf) creates a writer that empties buf and
+//                                 appends to it
+//           mutators
+//             write(value) appends a plain value
+//             write_array(values) appends an array of plain values
+//           private helpers
+//             write_bytes(bytes, count) appends count bytes
+//
+//******************************************************************
+
+class SnapshotWriter {
+ public:
+    SnapshotWriter() = delete;  // no default constructor
+    explicit SnapshotWriter(std::vector<unsigned char>& buf) : buffer(buf) { buffer.clear(); }
+
+    // mutators
+    template <typename T>
+    void write(const T& value);
+    template <typename T>
+    void write_array(const std::vector<T>& values);
+ private:
+    std::vector<unsigned char>& buffer;  // bytes written so far
+
+    // private helpers
+    void write_bytes(const void* bytes, size_t count);
+};
+
+//******************************************************************
+//
+//  Class: SnapshotReader
+//
+//  Purpose:  To read values back in the order a SnapshotWriter wrote
+//            them. Reading past the end of the buffer fails instead of
+//            reading garbage, and every read after a failure fails too,
+//            so a whole snapshot can be read and checked once at the end.
+//
+//  Functions:
+//           Constructors
+//             SnapshotReader() = delete
+//             SnapshotReader(d, sz) creates a reader of the sz bytes at d
+//           mutators
+//             read(value) reads a plain value
+//             read_array(values) reads an array of plain values into
+//                                values (which doesn't allocate if it has
+//                                the room already)
+//           helpers
+//             is_ok() returns true if every read so far succeeded
+//             is_done() returns true if every read succeeded and the
+//                       whole buffer was read
+//           private helpers
+//             read_bytes(bytes, count) reads count bytes
+//
+//******************************************************************
+
+class SnapshotReader {
+ public:
+    SnapshotReader() = delete;  // no default constructor
+    SnapshotReader(const unsigned char* d, size_t sz) : data(d), size(sz), pos(0), failed(false) {}
+
+    // mutators
+    template <typename T>
+    bool read(T& value);
+    template <typename T>
+    bool read_array(std::vector<T>& values);
+
+    // helpers
+    bool is_ok() const;
+    bool is_done() const;
+ private:
+    const unsigned char* data;  // start of the snapshot
+    size_t size;  // number of bytes in the snapshot
+    size_t pos;  // number of bytes read so far
+    bool failed;  // whether a read has failed
+
+    // private helpers
+    bool read_bytes(void* bytes, size_t count);
+};
+
+//******************************************************************
+//
+//  Function:   SnapshotWriter::write
+//
+//  Purpose:    appends a plain value to the snapshot
+//
+//  Parameters: value
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the bytes of value will have been appended
+//
+//  Calls:      write_bytes
+//
+//******************************************************************
+template <typename T>
+void SnapshotWriter::write(const T& value) {
+    write_bytes(&value, sizeof(T));
+}
+
+//******************************************************************
+//
+//  Function:   SnapshotWriter::write_array
+//
+//  Purpose:    appends an array of plain values to the snapshot
+//
+//  Parameters: values
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the number of values, then their bytes, will have
+//                   been appended
+//
+//  Calls:      write, write_bytes
+//
+//******************************************************************
+template <typename T>
+void SnapshotWriter::write_array(const std::vector<T>& values) {
+    write(static_cast<uint64_t>(values.size()));
+    write_bytes(values.data(), values.size() * sizeof(T));
+}
+
+//******************************************************************
+//
+//  Function:   SnapshotReader::read
+//
+//  Purpose:    reads a plain value from the snapshot
+//
+//  Parameters: value
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  the next thing in the snapshot must have been
+//                   written as a T
+//
+//  Post Conditions: value will be set to the next value and true is
+//                   returned, or false if the snapshot ended (or a read
+//                   already failed) and value is left alone
+//
+//  Calls:      read_bytes
+//
+//******************************************************************
+template <typename T>
+bool SnapshotReader::read(T& value) {
+    return read_bytes(&value, sizeof(T));
+}
+
+//******************************************************************
+//
+//  Function:   SnapshotReader::read_array
+//
+//  Purpose:    reads an array of plain values from the snapshot
+//
+//  Parameters: values
+//
+//  Member/Global Variables: size, pos, failed
+//
+//  Pre Conditions:  the next thing in the snapshot must have been
+//                   written as an array of T
+//
+//  Post Conditions: values will hold the next array and true is
+//                   returned, or false if the snapshot ended (or a read
+//                   already failed) and values is left alone
+//
+//  Calls:      read, std::vector::resize, read_bytes
+//
+//******************************************************************
+template <typename T>
+bool SnapshotReader::read_array(std::vector<T>& values) {
+    uint64_t count;
+    if (!read(count)) {
+        return false;
+    }
+    if (count > (size - pos) / sizeof(T)) {  // checked by count, so a bad length can't overflow
+        failed = true;
+        return false;
+    }
+
+    // copied bytewise, since values in the buffer needn't be aligned
+    values.resize(count);
+    return read_bytes(values.data(), count * sizeof(T));
+}
+
+#endif
@@ -0,0 +1,225 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        thread_pool.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a fixed set of worker threads
+//                 that split a range of indices between them, so that
+//                 per-unit work can be spread across every core.
+//
+//    Date:        10/10/2019
+//
+//*******************************************************************
+
+// Source libraries
+#include "thread_pool.h"
+
+//******************************************************************
+//
+//  Function:   ThreadPool::ThreadPool
+//
+//  Purpose:    creates the worker threads
+//
+//  Parameters: threads
+//
+//  Member/Global Variables: num_threads, workers, task, task_count,
+//                           generation, busy, stopping, trace
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: threads - 1 workers (or one per core, minus one,
+//                   if threads is 0) will be waiting for jobs
+//
+//  Calls:      std::thread::hardware_concurrency, work
+//
+//******************************************************************
+ThreadPool::ThreadPool(GLuint threads)
+    : num_threads(threads), task(nullptr), task_count(0), generation(0), busy(0), stopping(false),
+      trace(nullptr) {
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+    if (num_threads == 0) {  // hardware_concurrency is allowed to not know
+        num_threads = 1;
+    }
+
+    // the calling thread does a share of the work, so it needs one less worker
+    for (GLuint i = 1; i < num_threads; ++i) {
+        workers.push_back(std::thread(&ThreadPool::work, this, i));
+    }
+}
+
+//******************************************************************
+//
+//  Function:   ThreadPool::~ThreadPool
+//
+//  Purpose:    stops and joins the worker threads
+//
+//  Parameters: none
+//
+//  Member/Global Variables: workers, mutex, start_cond, stopping
+//
+//  Pre Conditions:  no job may be running
+//
+//  Post Conditions: every worker thread will have exited
+//
+//  Calls:      std::thread::join
+//
+//******************************************************************
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    start_cond.notify_all();
+
+    for (GLuint i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+//******************************************************************
+//
+//  Function:   ThreadPool::get_num_threads
+//
+//  Purpose:    returns the number of threads work is split across
+//
+//  Parameters: none
+//
+//  Member/Global Variables: num_threads
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the number of workers plus the caller
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint ThreadPool::get_num_threads() const {
+    return num_threads;
+}
+
+//******************************************************************
+//
+//  Function:   ThreadPool::set_trace_recorder
+//
+//  Purpose:    sets where the chunks each thread runs are traced
+//
+//  Parameters: t
+//
+//  Member/Global Variables: trace
+//
+//  Pre Conditions:  no job may be running, and t must outlive the pool
+//                   or be unset first
+//
+//  Post Conditions: every chunk of a job split across threads will be
+//                   traced in t while it's open, on the thread that ran
+//                   it (nothing is traced if t is null)
+//
+//  Calls:      none
+//
+//******************************************************************
+void ThreadPool::set_trace_recorder(TraceRecorder* t) {
+    trace = t;  // workers read it after waiting on the mutex for their next job
+}
+
+//******************************************************************
+//
+//  Function:   ThreadPool::run
+//
+//  Purpose:    runs a job over a range of indices in parallel
+//
+//  Parameters: count, job
+//
+//  Member/Global Variables: num_threads, mutex, start_cond, done_cond,
+//                           task, task_count, generation, busy, MIN_CHUNK,
+//                           trace
+//
+//  Pre Conditions:  job must be safe to call on disjoint ranges at the
+//                   same time, and run must not be called from a job
+//
+//  Post Conditions: job(begin, end) will have been called on chunks
+//                   that cover [0, count) exactly once, and returned
+//
+//  Calls:      job, ScopedTrace
+//
+//******************************************************************
+void ThreadPool::run(GLuint count, const std::function<void(GLuint, GLuint)>& job) {
+    if (num_threads == 1 || count < MIN_CHUNK * num_threads) {
+        // waking the workers would cost more than the work itself
+        job(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &job;
+        task_count = count;
+        busy = num_threads - 1;
+        generation++;
+    }
+    start_cond.notify_all();
+
+    {
+        ScopedTrace span(trace, TRACE_SIM, "chunk");
+        job(0, static_cast<unsigned long long>(count) / num_threads);  // the caller takes the first chunk
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cond.wait(lock, [this] { return busy == 0; });
+    task = nullptr;
+}
+
+//******************************************************************
+//
+//  Function:   ThreadPool::work
+//
+//  Purpose:    runs worker index's chunk of every job it's given
+//
+//  Parameters: index
+//
+//  Member/Global Variables: num_threads, mutex, start_cond, done_cond,
+//                           task, task_count, generation, busy, stopping,
+//                           trace
+//
+//  Pre Conditions:  index must be between 1 and the number of workers
+//
+//  Post Conditions: the worker will have exited once the pool stopped
+//
+//  Calls:      task, ScopedTrace
+//
+//******************************************************************
+void ThreadPool::work(GLuint index) {
+    GLuint seen = 0;  // generation of the last job this worker ran
+    while (true) {
+        const std::function<void(GLuint, GLuint)>* current;
+        GLuint count;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_cond.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            current = task;
+            count = task_count;
+        }
+
+        // split the range the same way every time, so each chunk always goes to the same thread
+        GLuint begin = static_cast<unsigned long long>(count) * index / num_threads;
+        GLuint end = static_cast<unsigned long long>(count) * (index + 1) / num_threads;
+        {
+            ScopedTrace span(trace, TRACE_SIM, "chunk");
+            (*current)(begin, end);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy--;
+        }
+        done_cond.notify_one();
+    }
+}
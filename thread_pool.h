@@ -0,0 +1,103 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        thread_pool.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a fixed set of worker threads
+//                 that split a range of indices between them, so that
+//                 per-unit work can be spread across every core.
+//
+//    Date:        10/10/2019
+//
+//*******************************************************************
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// C/C++ Standard libraries
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "trace_recorder.h"
+
+const GLuint MAX_THREADS = 256;  // most threads a pool can be asked for (options asking for more are refused)
+
+//******************************************************************
+//
+//  Class: ThreadPool
+//
+//  Purpose:  To run a job over the range [0, count) in parallel. The
+//            range is cut into one contiguous chunk per thread (the
+//            calling thread works on the first chunk), and run only
+//            returns once every chunk is done.
+//
+//  Functions:
+//           Constructors
+//             ThreadPool() = delete
+//             ThreadPool(threads) creates a pool that splits work across
+//                                 the given number of threads (0 means
+//                                 one per core)
+//           Destructor
+//             ~ThreadPool() stops and joins the worker threads
+//           getters
+//             get_num_threads to return the number of threads work is
+//                             split across
+//           setters
+//             set_trace_recorder to set where the chunks each thread runs
+//                                are traced
+//           helpers
+//             run(count, job) calls job(begin, end) on chunks covering
+//                             [0, count), in parallel
+//           private helpers
+//             work(index) runs worker index's chunk of every job it's
+//                         given until the pool is destroyed
+//
+//******************************************************************
+
+class ThreadPool {
+ public:
+    ThreadPool() = delete;  // no default constructor
+    explicit ThreadPool(GLuint threads);
+    ThreadPool(const ThreadPool&) = delete;  // no copy constructor
+    ThreadPool operator=(const ThreadPool&) = delete;  // no copy assignment operator
+    ~ThreadPool();
+
+    // getters
+    GLuint get_num_threads() const;
+
+    // setters
+    void set_trace_recorder(TraceRecorder* t);
+
+    // helpers
+    void run(GLuint count, const std::function<void(GLuint, GLuint)>& job);
+ private:
+    GLuint num_threads;  // number of threads work is split across, including the caller
+    std::vector<std::thread> workers;  // threads other than the caller's
+    std::mutex mutex;  // guards everything below
+    std::condition_variable start_cond;  // signalled when a job is ready
+    std::condition_variable done_cond;  // signalled when the last worker finishes
+    const std::function<void(GLuint, GLuint)>* task;  // job being run
+    GLuint task_count;  // size of the range the job is run over
+    GLuint generation;  // number of jobs started, so workers can tell a new one apart
+    GLuint busy;  // number of workers still working on the job
+    bool stopping;  // whether the workers should exit
+    TraceRecorder* trace;  // where chunks are traced, or null to not trace them (not owned)
+
+    // static member variables
+    static const GLuint MIN_CHUNK = 256;  // ranges smaller than this per thread are run on the caller only
+
+    // private helpers
+    void work(GLuint index);
+};
+
+#endif
@@ -0,0 +1,671 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        tools/bench-suite.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This program times the hot paths of the simulation
+//                 (tree tests, line of sight, picking wander targets,
+//                 moving units, rotting food, updating the food drops
+//                 and the units going for them, and whole ticks) on maps
+//                 of a few sizes and tree densities, always made from
+//                 the same seed. It writes the results as JSON, and can
+//                 compare them to an earlier run, failing if anything
+//                 got slower than a threshold, so a change can be
+//                 checked for regressions before it goes in.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Source libraries
+#include "circle_store.h"
+#include "free_space.h"
+#include "phase_timer.h"
+#include "random_stream.h"
+#include "simulation.h"
+#include "unit_store.h"
+
+// Run defaults
+const uint64_t BENCH_SEED = 425;  // seed every map is made from, so runs time the same work
+const uint64_t BENCH_STREAM = 0xFFFFFFFFFFFFFFFE;  // stream of the seed the benchmarks pick positions with (far past any map's)
+const GLuint DEFAULT_THREADS = 1;  // threads units are updated on (1 keeps timings steady)
+const GLuint SAMPLES = 5;  // number of times each benchmark is timed (the fastest is kept)
+const double MIN_SAMPLE_SECONDS = 0.25;  // shortest time each sample runs for
+const double QUICK_SAMPLE_SECONDS = 0.05;  // shortest time each sample runs for with --quick
+const double DEFAULT_THRESHOLD = 0.25;  // fraction slower than the baseline that counts as a regression (well past the noise of a shared machine)
+
+// Workload constants
+const GLuint POINTS = 4096;  // number of positions or pairs tested per run of the point benchmarks
+const GLuint UPDATES_PER_RUN = 64;  // number of updates per run of the unit and circle benchmarks
+const GLuint TICKS_PER_RUN = 60;  // number of ticks per run of the tick and food update benchmarks
+const GLuint WARMUP_TICKS = 600;  // ticks played before the tick and food update benchmarks' snapshot
+const GLuint DROP_INTERVAL = 60;  // ticks between attempted drops
+const GLuint BENCH_DROPS = 1000000;  // drops the player has (so the game never runs out)
+const float TICK = 1.0f / 60;  // delta time of each update
+
+// A map the benchmarks run on
+struct BenchCase {
+    const char* name;  // name results are reported under
+    GLuint units;  // number of units (three eighths bad guys, the rest good guys, as in the default game)
+    GLuint trees;  // number of trees
+    float width;  // width of the world
+    float height;  // height of the world
+};
+
+// Maps the benchmarks run on, from the default game up to crowded, dense forests
+const BenchCase CASES[] = {
+    { "default", 16, 40, 1200, 600 },
+    { "dense", 16, 160, 1200, 600 },
+    { "crowd", 2000, 400, 3000, 1500 },
+    { "crowd_dense", 2000, 1600, 3000, 1500 },
+    { "large", 20000, 4000, 9600, 4800 }
+};
+
+// The result of one benchmark on one map
+struct BenchResult {
+    std::string name;  // name of the benchmark
+    std::string bench_case;  // name of the map
+    GLuint units;  // number of units on the map
+    GLuint trees;  // number of trees on the map
+    float width;  // width of the world
+    float height;  // height of the world
+    double ns_per_op;  // fastest time per operation of the samples, in nanoseconds
+};
+
+//******************************************************************
+//
+//  Function:   time_benchmark
+//
+//  Purpose:    times an operation, keeping the fastest of a few samples
+//
+//  Parameters: setup, run, min_seconds
+//
+//  Member/Global Variables: SAMPLES
+//
+//  Pre Conditions:  setup must ready the state run works on, and run
+//                   must return the number of operations it did
+//
+//  Post Conditions: returns the fastest time per operation of SAMPLES
+//                   samples, each running for at least min_seconds, in
+//                   nanoseconds (setup isn't timed)
+//
+//  Calls:      setup, run, std::chrono::steady_clock::now, std::min
+//
+//******************************************************************
+template <typename Setup, typename Run>
+double time_benchmark(Setup setup, Run run, double min_seconds) {
+    double best = 0;
+    for (GLuint sample = 0; sample <= SAMPLES; ++sample) {
+        std::chrono::duration<double> elapsed(0);
+        double ops = 0;
+        while (elapsed.count() < min_seconds) {
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            ops += run();
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+
+        // the first sample only warms the caches up
+        double ns = elapsed.count() * 1e9 / ops;
+        if (sample == 1 || (sample > 1 && ns < best)) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+//******************************************************************
+//
+//  Function:   time_phase
+//
+//  Purpose:    times one phase of the simulation's updates, keeping the
+//              fastest of a few samples
+//
+//  Parameters: setup, run, timers, phase, min_seconds
+//
+//  Member/Global Variables: SAMPLES
+//
+//  Pre Conditions:  setup must ready the state run works on, run must
+//                   update a simulation whose phases are timed by timers
+//
+//  Post Conditions: returns the fastest average time of the phase of
+//                   SAMPLES samples, each running for at least
+//                   min_seconds, in nanoseconds (only the phase's own
+//                   time counts, not setup or the rest of the update)
+//
+//  Calls:      setup, run, std::chrono::steady_clock::now,
+//              PhaseTimers::clear, PhaseTimers::get_histogram,
+//              LatencyHistogram::get_count, LatencyHistogram::get_mean
+//
+//******************************************************************
+template <typename Setup, typename Run>
+double time_phase(Setup setup, Run run, PhaseTimers& timers, GLuint phase, double min_seconds) {
+    double best = 0;
+    for (GLuint sample = 0; sample <= SAMPLES; ++sample) {
+        std::chrono::duration<double> elapsed(0);
+        timers.clear();
+        while (elapsed.count() < min_seconds) {
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            run();
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+
+        // the first sample only warms the caches up
+        const LatencyHistogram& histogram = timers.get_histogram(phase);
+        double ns = histogram.get_count() > 0 ? histogram.get_mean() : 0;
+        if (sample == 1 || (sample > 1 && ns < best)) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+//******************************************************************
+//
+//  Function:   random_position
+//
+//  Purpose:    returns a random position in the world
+//
+//  Parameters: random, world_size
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns a position anywhere in the world, with every
+//                   one equally likely
+//
+//  Calls:      RandomStream::next
+//
+//******************************************************************
+vec2 random_position(RandomStream& random, const vec2& world_size) {
+    return world_size * vec2(random.next() - 0.5, random.next() - 0.5);
+}
+
+//******************************************************************
+//
+//  Function:   play
+//
+//  Purpose:    steps a simulation, dropping food as a player would
+//
+//  Parameters: sim, player, ticks
+//
+//  Member/Global Variables: DROP_INTERVAL, TICK
+//
+//  Pre Conditions:  sim must have been initialized
+//
+//  Post Conditions: sim will have been updated ticks times, with a drop
+//                   tried every DROP_INTERVAL ticks at a position picked
+//                   with player
+//
+//  Calls:      random_position, Simulation::get_world_size,
+//              Simulation::request_drop, Simulation::update
+//
+//******************************************************************
+void play(Simulation& sim, RandomStream& player, GLuint ticks) {
+    for (GLuint i = 0; i < ticks; ++i) {
+        if (i % DROP_INTERVAL == 0) {
+            sim.request_drop(random_position(player, sim.get_world_size()));
+        }
+
+        sim.update(TICK);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   run_case
+//
+//  Purpose:    runs every benchmark on one map
+//
+//  Parameters: bench_case, filter, threads, min_seconds, results
+//
+//  Member/Global Variables: BENCH_SEED, BENCH_STREAM, BENCH_DROPS,
+//                           POINTS, UPDATES_PER_RUN, TICKS_PER_RUN,
+//                           WARMUP_TICKS, BAD_SIZE,
+//                           GOOD_SIZE, FREE_SPACE_CELL_SIZE, TICK
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the result of every benchmark whose name contains
+//                   filter will have been printed to standard output and
+//                   appended to results
+//
+//  Calls:      Simulation::set_world_size, Simulation::set_seed,
+//              Simulation::init, Simulation::get_visibility_bytes,
+//              FreeSpace::build, FreeSpace::sample,
+//              FreeSpace::sample_near, random_position, time_benchmark,
+//              Simulation::is_traversable, Simulation::can_reach,
+//              Simulation::find_wander_target, Simulation::get_sampling_stats,
+//              UnitStore::set_target_pos, UnitStore::update,
+//              CircleStore::add, CircleStore::advance,
+//              CircleStore::is_gone, play, Simulation::save_snapshot,
+//              Simulation::restore_snapshot, Simulation::set_phase_timers,
+//              time_phase
+//
+//******************************************************************
+void run_case(const BenchCase& bench_case, const std::string& filter, GLuint threads, double min_seconds,
+              std::vector<BenchResult>& results) {
+    GLuint bad_guys = bench_case.units * 3 / 8;
+    vec2 world_size(bench_case.width, bench_case.height);
+    Simulation sim(bad_guys, bench_case.units - bad_guys, bench_case.trees, BENCH_DROPS, threads);
+    sim.set_world_size(world_size);
+    sim.set_seed(BENCH_SEED);
+    sim.init();
+    const Tuning& tuning = sim.get_tuning();
+
+    // a map too big for the visibility cache runs without it, which changes every timing
+    std::cout << bench_case.name << " visibility cache: " << sim.get_visibility_bytes() << " bytes"
+              << (sim.get_visibility_bytes() == 0 ? " (off)" : "") << "\n";
+
+    // the same free space the simulation picks positions from
+    FreeSpace free_space;
+    free_space.build(sim.get_trees(), std::max(BAD_SIZE, GOOD_SIZE) / 2, -world_size / 2, world_size / 2,
+                     FREE_SPACE_CELL_SIZE);
+
+    RandomStream random(BENCH_SEED, BENCH_STREAM);
+    std::vector<vec2> points(POINTS);
+    std::vector<vec2> starts(POINTS);
+    std::vector<vec2> ends(POINTS);
+    for (GLuint i = 0; i < POINTS; ++i) {
+        points[i] = random_position(random, world_size);
+        if (!free_space.sample(random, starts[i]) ||
+            !free_space.sample_near(random, starts[i], tuning.bad_range, ends[i])) {
+            starts[i] = ends[i] = vec2();
+        }
+    }
+
+    auto report = [&](const char* name, double ns_per_op, const std::string& note) {
+        BenchResult result = { name, bench_case.name, bench_case.units, bench_case.trees,
+                               bench_case.width, bench_case.height, ns_per_op };
+        results.push_back(result);
+        std::cout << bench_case.name << " " << name << ": " << ns_per_op << " ns/op" << note << "\n";
+    };
+    auto wanted = [&](const char* name) {
+        return std::string(name).find(filter) != std::string::npos ||
+               std::string(bench_case.name).find(filter) != std::string::npos;
+    };
+    auto no_setup = []() {};
+
+    // tree test of any position
+    if (wanted("is_traversable")) {
+        volatile GLuint sink = 0;
+        double ns = time_benchmark(no_setup, [&]() {
+            GLuint traversable = 0;
+            for (const vec2& point : points) {
+                traversable += sim.is_traversable(point);
+            }
+            sink = sink + traversable;
+            return POINTS;
+        }, min_seconds);
+        report("is_traversable", ns, "");
+    }
+
+    // line of sight between free positions in range, as units looking for food test it
+    if (wanted("can_reach")) {
+        volatile GLuint sink = 0;
+        double ns = time_benchmark(no_setup, [&]() {
+            GLuint reachable = 0;
+            for (GLuint i = 0; i < POINTS; ++i) {
+                reachable += sim.can_reach(starts[i], ends[i], tuning.bad_range);
+            }
+            sink = sink + reachable;
+            return POINTS;
+        }, min_seconds);
+        report("can_reach", ns, "");
+    }
+
+    // picking a wander target from free positions, with the simulation's own search (which
+    // draws from its wander stream, so the game is put back afterwards for the benchmarks below)
+    if (wanted("wander_pick")) {
+        std::vector<unsigned char> fresh;
+        sim.save_snapshot(fresh);
+        SamplingStats before = sim.get_sampling_stats();
+        volatile GLuint sink = 0;
+        double ns = time_benchmark(no_setup, [&]() {
+            GLuint found = 0;
+            for (const vec2& start : starts) {
+                vec2 pos;
+                found += sim.find_wander_target(start, tuning.bad_range, pos);
+            }
+            sink = sink + found;
+            return POINTS;
+        }, min_seconds);
+        const SamplingStats& after = sim.get_sampling_stats();
+        double picks = std::max(after.wander_picks - before.wander_picks, 1UL);
+        report("wander_pick", ns, " (" + std::to_string((after.wander_rejections - before.wander_rejections) / picks) +
+                                  " rejections/pick)");
+        sim.restore_snapshot(fresh);
+    }
+
+    // moving every unit toward a target across the map
+    if (wanted("unit_update")) {
+        UnitStore start_units = sim.get_good_guys();
+        for (GLuint i = 0; i < start_units.size(); ++i) {
+            vec2 pos;
+            if (free_space.sample(random, pos)) {
+                start_units.set_target_pos(i, pos);
+            }
+        }
+        UnitStore units;
+        double ns = time_benchmark([&]() { units = start_units; }, [&]() {
+            for (GLuint t = 0; t < UPDATES_PER_RUN; ++t) {
+                units.update(TICK);
+            }
+            return static_cast<double>(units.size()) * UPDATES_PER_RUN;
+        }, min_seconds);
+        report("unit_update", ns, "");
+    }
+
+    // rotting food drops and checking which are gone, the store's part of updating the food
+    if (wanted("circle_update")) {
+        CircleStore start_food;
+        for (GLuint i = 0; i < bench_case.units / 4 + 8; ++i) {
+            start_food.add(random_position(random, world_size), FOOD_SIZE, tuning.food_per_drop,
+                           tuning.food_rot_speed);
+        }
+        CircleStore food;
+        volatile GLuint sink = 0;
+        double ns = time_benchmark([&]() { food = start_food; }, [&]() {
+            GLuint gone = 0;
+            for (GLuint t = 0; t < UPDATES_PER_RUN; ++t) {
+                food.advance(TICK);
+                for (GLuint i = 0; i < food.size(); ++i) {
+                    gone += food.is_gone(i);
+                }
+            }
+            sink = sink + gone;
+            return static_cast<double>(food.size()) * UPDATES_PER_RUN;
+        }, min_seconds);
+        report("circle_update", ns, "");
+    }
+
+    // a game in progress, with food on the map and units chasing it, played from the same
+    // snapshot by each run of the benchmarks below
+    if (!wanted("update_food") && !wanted("tick")) {
+        return;
+    }
+    RandomStream player(BENCH_SEED, BENCH_STREAM - 2);
+    play(sim, player, WARMUP_TICKS);
+    std::vector<unsigned char> snapshot;
+    sim.save_snapshot(snapshot);
+    RandomStream saved_player = player;
+    auto restore_game = [&]() {
+        sim.restore_snapshot(snapshot);
+        player = saved_player;
+    };
+
+    // the food phase of those ticks (retargeting, eating, and removing food), as the game's
+    // own phase timer measures it
+    if (wanted("update_food")) {
+        PhaseTimers timers;
+        sim.set_phase_timers(&timers);
+        double ns = time_phase(restore_game, [&]() { play(sim, player, TICKS_PER_RUN); }, timers, PHASE_FOOD,
+                               min_seconds);
+        sim.set_phase_timers(nullptr);
+        report("update_food", ns, "");
+    }
+
+    // whole ticks of that game
+    if (wanted("tick")) {
+        double ns = time_benchmark(restore_game, [&]() {
+            play(sim, player, TICKS_PER_RUN);
+            return TICKS_PER_RUN;
+        }, min_seconds);
+        report("tick", ns, "");
+    }
+}
+
+//******************************************************************
+//
+//  Function:   write_results
+//
+//  Purpose:    writes benchmark results as JSON
+//
+//  Parameters: path, results
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the file at path will hold the results, one per
+//                   line; returns false, after printing why to standard
+//                   error, if it couldn't be written
+//
+//  Calls:      std::ofstream::operator<<
+//
+//******************************************************************
+bool write_results(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream file(path, std::ios::trunc);
+    file << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& result = results[i];
+        file << "    {\"name\": \"" << result.name << "\", \"case\": \"" << result.bench_case
+             << "\", \"units\": " << result.units << ", \"trees\": " << result.trees
+             << ", \"world_width\": " << result.width << ", \"world_height\": " << result.height
+             << ", \"ns_per_op\": " << result.ns_per_op << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+
+    if (!file) {
+        std::cerr << "Unable to write results " << path << ".\n";
+        return false;
+    }
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   find_json_value
+//
+//  Purpose:    finds the value of a key on a line of results
+//
+//  Parameters: line, key, value
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: if the line has the key, value will be set to the
+//                   text of its value (without quotes) and true is
+//                   returned
+//
+//  Calls:      std::string::find, std::string::find_first_of
+//
+//******************************************************************
+bool find_json_value(const std::string& line, const std::string& key, std::string& value) {
+    size_t pos = line.find("\"" + key + "\":");
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = line.find_first_not_of(" \"", pos + key.size() + 3);
+    size_t end = line.find_first_of("\",}", pos);
+    if (pos == std::string::npos || end == std::string::npos) {
+        return false;
+    }
+    value = line.substr(pos, end - pos);
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   read_results
+//
+//  Purpose:    reads benchmark results written by write_results
+//
+//  Parameters: path, results
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: results will hold the name, map, and time of every
+//                   result in the file; returns false, after printing
+//                   why to standard error, if it couldn't be read
+//
+//  Calls:      std::getline, find_json_value, std::strtod
+//
+//******************************************************************
+bool read_results(const std::string& path, std::vector<BenchResult>& results) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Unable to open baseline " << path << ".\n";
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        BenchResult result = BenchResult();
+        std::string ns;
+        if (find_json_value(line, "name", result.name) && find_json_value(line, "case", result.bench_case) &&
+            find_json_value(line, "ns_per_op", ns)) {
+            result.ns_per_op = std::strtod(ns.c_str(), nullptr);
+            results.push_back(result);
+        }
+    }
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   compare_results
+//
+//  Purpose:    compares benchmark results to a baseline
+//
+//  Parameters: results, baseline, threshold
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the time of every result relative to the baseline's
+//                   will have been printed to standard output; returns
+//                   the number of results more than threshold slower
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint compare_results(const std::vector<BenchResult>& results, const std::vector<BenchResult>& baseline,
+                       double threshold) {
+    GLuint regressions = 0;
+    std::cout << "\ncompared to baseline (time / baseline time):\n";
+    for (const BenchResult& result : results) {
+        const BenchResult* base = nullptr;
+        for (const BenchResult& old : baseline) {
+            if (old.name == result.name && old.bench_case == result.bench_case) {
+                base = &old;
+            }
+        }
+
+        std::cout << result.bench_case << " " << result.name << ": ";
+        if (base == nullptr || base->ns_per_op <= 0) {
+            std::cout << "new\n";
+            continue;
+        }
+        double ratio = result.ns_per_op / base->ns_per_op;
+        std::cout << base->ns_per_op << " -> " << result.ns_per_op << " ns/op (" << ratio << "x)";
+        if (ratio > 1 + threshold) {
+            std::cout << " SLOWER";
+            regressions++;
+        } else if (ratio < 1 - threshold) {
+            std::cout << " faster";
+        }
+        std::cout << "\n";
+    }
+    return regressions;
+}
+
+//******************************************************************
+//
+//  Function:   main
+//
+//  Purpose:    main function that runs the benchmarks and writes or
+//              compares their results
+//
+//  Parameters: argc, argv (options: --out=file to write the results
+//              to, --baseline=file to compare them to, --threshold=x
+//              for the fraction slower that fails, --filter=text to
+//              run only benchmarks or maps named with it, --threads=n,
+//              and --quick for shorter samples)
+//
+//  Member/Global Variables: CASES, DEFAULT_THREADS, MIN_SAMPLE_SECONDS,
+//                           QUICK_SAMPLE_SECONDS, DEFAULT_THRESHOLD,
+//                           MAX_THREADS
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the results will have been printed to standard
+//                   output (and written and compared, if asked);
+//                   returns failure if an option isn't valid, a file
+//                   couldn't be read or written, or a result regressed
+//
+//  Calls:      run_case, write_results, read_results, compare_results,
+//              std::strtoul, std::strtod
+//
+//******************************************************************
+int main(int argc, char** argv) {
+    std::string out;
+    std::string baseline_path;
+    std::string filter;
+    double threshold = DEFAULT_THRESHOLD;
+    GLuint threads = DEFAULT_THREADS;
+    double min_seconds = MIN_SAMPLE_SECONDS;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        std::string key = arg.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+        if (key == "--out") {
+            out = value;
+        } else if (key == "--baseline") {
+            baseline_path = value;
+        } else if (key == "--threshold") {
+            threshold = std::strtod(value.c_str(), nullptr);
+        } else if (key == "--filter") {
+            filter = value;
+        } else if (key == "--threads" && std::strtoul(value.c_str(), nullptr, 10) <= MAX_THREADS) {
+            threads = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (key == "--quick") {
+            min_seconds = QUICK_SAMPLE_SECONDS;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--out=file] [--baseline=file] [--threshold=fraction]"
+                      << " [--filter=text] [--threads=n] [--quick]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (const BenchCase& bench_case : CASES) {
+        run_case(bench_case, filter, threads, min_seconds, results);
+    }
+
+    if (!out.empty() && !write_results(out, results)) {
+        return EXIT_FAILURE;
+    }
+    if (!baseline_path.empty()) {
+        std::vector<BenchResult> baseline;
+        if (!read_results(baseline_path, baseline)) {
+            return EXIT_FAILURE;
+        }
+        GLuint regressions = compare_results(results, baseline, threshold);
+        if (regressions > 0) {
+            std::cout << regressions << " benchmarks more than " << threshold * 100 << "% slower than the baseline\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,203 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        tools/headless-main.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This main file runs the food drop game simulation
+//                 without a window or OpenGL context. It steps the
+//                 simulation a fixed number of ticks, scheduling a
+//                 food drop at random positions as a player would,
+//                 and reports how fast the ticks ran. The game is set
+//                 up from a scenario given with --key=value options
+//                 (and --config=file), see scenario.h, and recorded for
+//                 the replay program if the scenario names a log.
+//
+//    Date:        10/6/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Source libraries
+#include "input_log.h"
+#include "map_file.h"
+#include "random_stream.h"
+#include "scenario.h"
+#include "simulation.h"
+
+// Run defaults
+const unsigned long DEFAULT_TICKS = 100000;  // number of ticks to simulate
+const unsigned long DROP_INTERVAL = 600;  // ticks between attempted drops
+const uint64_t PLAYER_STREAM = 0xFFFFFFFFFFFFFFFF;  // stream of the seed the fake player clicks with (far past any map's)
+const unsigned long TRACE_FLUSH_INTERVAL = 60;  // ticks between writing the trace out (about once a frame, as the game does)
+
+//******************************************************************
+//
+//  Function:   main
+//
+//  Purpose:    main function that creates a simulation, steps it, and
+//              prints timing and game results
+//
+//  Parameters: argc, argv (scenario options, then optional tick count,
+//              delta time, which defaults to one over the tick rate,
+//              thread count, where 0 means one thread per core, and
+//              seed, which override the scenario's)
+//
+//  Member/Global Variables: DEFAULT_TICKS, DROP_INTERVAL,
+//                           PLAYER_STREAM, CHECKPOINT_TICKS,
+//                           TRACE_FLUSH_INTERVAL
+//
+//  Pre Conditions:  all of the above constants must have valid values
+//
+//  Post Conditions: the simulation will have been run and its results
+//                   printed to standard output; exits with failure if
+//                   an option or the thread count isn't valid, the
+//                   scenario's map can't be opened, or its input log,
+//                   trace, or counters can't be written
+//
+//  Calls:      default_scenario, parse_scenario_args, set_scenario_value,
+//              get_world_size,
+//              Simulation::set_world_size, Simulation::set_tuning,
+//              Simulation::set_seed, MapFile::open, Simulation::init,
+//              Simulation::get_world_size, InputRecorder::open,
+//              RandomStream::next, make_input, InputRecorder::record,
+//              InputRecorder::close,
+//              apply_input, Simulation::update,
+//              Simulation::get_state_hash, Simulation::get_sampling_stats,
+//              Simulation::get_visibility_bytes,
+//              Simulation::set_phase_timers, PhaseTimers::dump,
+//              TraceRecorder::open, Simulation::set_trace_recorder,
+//              TraceRecorder::flush, TraceRecorder::close,
+//              WorkCounters::open, Simulation::set_work_counters,
+//              WorkCounters::get_total, WorkCounters::close
+//
+//******************************************************************
+int main(int argc, char** argv) {
+    Scenario scenario = default_scenario();
+    std::vector<char*> rest;
+    if (!parse_scenario_args(scenario, argc, argv, rest)) {
+        return EXIT_FAILURE;
+    }
+
+    unsigned long ticks = DEFAULT_TICKS;
+    float dt = 1 / scenario.tick_rate;
+    if (rest.size() > 0) {
+        ticks = std::strtoul(rest[0], nullptr, 10);
+    }
+    if (rest.size() > 1) {
+        dt = std::strtof(rest[1], nullptr);
+    }
+    if (rest.size() > 2 && !set_scenario_value(scenario, "threads", rest[2])) {
+        std::cerr << "Invalid number of threads " << rest[2] << ".\n";
+        return EXIT_FAILURE;
+    }
+    if (rest.size() > 3) {
+        scenario.seed = std::strtoull(rest[3], nullptr, 10);
+    }
+
+    Simulation sim(scenario.bad_guys, scenario.good_guys, scenario.trees, scenario.drops, scenario.threads);
+    sim.set_world_size(get_world_size(scenario));
+    sim.set_tuning(scenario.tuning);
+    sim.set_seed(scenario.seed);
+    TraceRecorder trace;
+    if (!scenario.trace.empty()) {
+        if (!trace.open(scenario.trace)) {
+            return EXIT_FAILURE;
+        }
+        sim.set_trace_recorder(&trace);
+    }
+
+    // a saved map brings its own world size, seed, and drops
+    auto load_start = std::chrono::steady_clock::now();
+    MapFile map;
+    if (!scenario.map.empty()) {
+        if (!map.open(scenario.map)) {
+            return EXIT_FAILURE;
+        }
+        sim.init(map.get_view());
+    } else {
+        sim.init();
+    }
+    std::chrono::duration<double> load_time = std::chrono::steady_clock::now() - load_start;
+    vec2 world_size = sim.get_world_size();
+    RandomStream player(sim.get_seed(), PLAYER_STREAM);
+
+    // the fake player's clicks are recorded just as a real player's are
+    InputRecorder recorder;
+    if (!scenario.record.empty() && !recorder.open(scenario.record, scenario, dt)) {
+        return EXIT_FAILURE;
+    }
+    std::vector<unsigned char> saved;
+    PhaseTimers timers;
+    sim.set_phase_timers(&timers);
+    WorkCounters counters;
+    if (!scenario.counters.empty()) {
+        if (!counters.open(scenario.counters)) {
+            return EXIT_FAILURE;
+        }
+        sim.set_work_counters(&counters);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < ticks; ++i) {
+        if (i % DROP_INTERVAL == 0) {
+            // act like a player clicking somewhere on the map
+            InputEvent drop = make_input(INPUT_DROP, 0, world_size * vec2(player.next() - 0.5, player.next() - 0.5));
+            drop.tick = i;
+            recorder.record(drop);
+            apply_input(sim, drop, map.is_open() ? &map : nullptr, saved);
+        }
+
+        sim.update(dt);
+
+        if (recorder.is_open() && (i + 1) % CHECKPOINT_TICKS == 0) {
+            InputEvent checkpoint = make_input(INPUT_CHECKPOINT);
+            checkpoint.tick = i + 1;
+            checkpoint.hash = sim.get_state_hash();
+            recorder.record(checkpoint);
+        }
+        if (i % TRACE_FLUSH_INTERVAL == 0) {
+            trace.flush();
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    recorder.close(ticks, sim.get_state_hash());  // a replay runs every tick up to here
+
+    std::cout << "seed: " << sim.get_seed() << "\n";
+    std::cout << (map.is_open() ? "map load" : "map generation") << " seconds: " << load_time.count() << "\n";
+    std::cout << "ticks: " << ticks << "\n";
+    std::cout << "seconds: " << elapsed.count() << "\n";
+    std::cout << "ticks/second: " << ticks / elapsed.count() << "\n";
+    std::cout << "score: " << sim.get_score() << "\n";
+    std::cout << "drops left: " << sim.get_drops_left() << "\n";
+    std::cout << "good guys left: " << sim.get_good_guys().size() << "\n";
+
+    const SamplingStats& stats = sim.get_sampling_stats();
+    std::cout << "wander targets picked: " << stats.wander_picks << "\n";
+    std::cout << "wander targets rejected: " << stats.wander_rejections << "\n";
+    std::cout << "wander searches given up: " << stats.wander_failures << "\n";
+    std::cout << "units that couldn't be placed: " << stats.spawn_failures << "\n";
+    std::cout << "visibility cache bytes: " << sim.get_visibility_bytes()
+              << (sim.get_visibility_bytes() == 0 ? " (off)" : "") << "\n";
+    std::cout << "trees that couldn't be placed: " << stats.tree_failures << "\n";
+    timers.dump(std::cout);
+    if (trace.is_open()) {
+        trace.close();
+        std::cout << "trace events dropped: " << trace.get_dropped() << "\n";
+    }
+    if (counters.is_open()) {
+        counters.close();
+        for (GLuint i = 0; i < NUM_COUNTERS; ++i) {
+            std::cout << COUNTER_NAMES[i] << ": " << counters.get_total(i) << "\n";
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        tools/make-map.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This program makes the map of a scenario and saves it
+//                 in the binary map format, so that everyone can play
+//                 and time the same map. It then loads the map back,
+//                 checking that it comes back the same, and reports how
+//                 long making, saving, and loading it took.
+//
+//    Date:        10/15/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Source libraries
+#include "map_file.h"
+#include "scenario.h"
+#include "simulation.h"
+
+//******************************************************************
+//
+//  Function:   seconds_since
+//
+//  Purpose:    returns how long ago a time was
+//
+//  Parameters: start
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the seconds passed since start
+//
+//  Calls:      std::chrono::steady_clock::now
+//
+//******************************************************************
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//******************************************************************
+//
+//  Function:   same_array
+//
+//  Purpose:    determines whether two arrays hold the same bytes
+//
+//  Parameters: a, b, count
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  a and b must each hold count values
+//
+//  Post Conditions: returns true if the arrays are bit for bit the same
+//
+//  Calls:      std::memcmp
+//
+//******************************************************************
+template <typename T>
+bool same_array(const T* a, const T* b, GLuint count) {
+    return count == 0 || std::memcmp(a, b, count * sizeof(T)) == 0;
+}
+
+//******************************************************************
+//
+//  Function:   same_map
+//
+//  Purpose:    determines whether two maps hold the same objects
+//
+//  Parameters: a, b
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  every array of a and b must hold as many values as
+//                   its count says
+//
+//  Post Conditions: returns true if the maps are bit for bit the same
+//
+//  Calls:      same_array
+//
+//******************************************************************
+bool same_map(const MapView& a, const MapView& b) {
+    return a.seed == b.seed && a.map_index == b.map_index && a.drops == b.drops &&
+           a.world_size.x == b.world_size.x && a.world_size.y == b.world_size.y &&
+           a.num_trees == b.num_trees && a.num_bad_guys == b.num_bad_guys && a.num_good_guys == b.num_good_guys &&
+           same_array(a.tree_positions, b.tree_positions, a.num_trees) &&
+           same_array(a.tree_radii, b.tree_radii, a.num_trees) &&
+           same_array(a.bad_positions, b.bad_positions, a.num_bad_guys) &&
+           same_array(a.bad_rotations, b.bad_rotations, a.num_bad_guys) &&
+           same_array(a.good_positions, b.good_positions, a.num_good_guys) &&
+           same_array(a.good_rotations, b.good_rotations, a.num_good_guys);
+}
+
+//******************************************************************
+//
+//  Function:   main
+//
+//  Purpose:    main function that makes, saves, and reloads a map
+//
+//  Parameters: argc, argv (scenario options, then the file to save to)
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the scenario's map will have been saved and the
+//                   timings printed to standard output; returns failure
+//                   if an option isn't valid, the map couldn't be saved
+//                   or loaded, or it didn't load back the same
+//
+//  Calls:      default_scenario, parse_scenario_args, get_world_size,
+//              Simulation::set_world_size, Simulation::set_tuning,
+//              Simulation::set_seed, Simulation::init,
+//              Simulation::get_map, write_map, MapFile::open,
+//              MapFile::get_view, seconds_since, same_map
+//
+//******************************************************************
+int main(int argc, char** argv) {
+    Scenario scenario = default_scenario();
+    std::vector<char*> rest;
+    if (!parse_scenario_args(scenario, argc, argv, rest)) {
+        return EXIT_FAILURE;
+    }
+    if (rest.size() != 1) {
+        std::cerr << "Usage: " << argv[0] << " [--key=value ...] map-file\n";
+        return EXIT_FAILURE;
+    }
+    const char* path = rest[0];
+
+    // make the map as a game would
+    Simulation made(scenario.bad_guys, scenario.good_guys, scenario.trees, scenario.drops, scenario.threads);
+    made.set_world_size(get_world_size(scenario));
+    made.set_tuning(scenario.tuning);
+    made.set_seed(scenario.seed);
+    auto start = std::chrono::steady_clock::now();
+    made.init();
+    double make_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    if (!write_map(path, made.get_map())) {
+        return EXIT_FAILURE;
+    }
+    double save_time = seconds_since(start);
+
+    // and load it back into a game that has never made a map
+    Simulation loaded(0, 0, 0, 0, scenario.threads);
+    loaded.set_tuning(scenario.tuning);
+    start = std::chrono::steady_clock::now();
+    MapFile map;
+    if (!map.open(path)) {
+        return EXIT_FAILURE;
+    }
+    loaded.init(map.get_view());
+    double load_time = seconds_since(start);
+
+    MapView view = made.get_map();
+    std::cout << "map: " << path << "\n";
+    std::cout << "trees: " << view.num_trees << ", bad guys: " << view.num_bad_guys
+              << ", good guys: " << view.num_good_guys << "\n";
+    std::cout << "make seconds: " << make_time << "\n";
+    std::cout << "save seconds: " << save_time << "\n";
+    std::cout << "load seconds: " << load_time << "\n";
+
+    if (!same_map(view, map.get_view()) || !same_map(view, loaded.get_map())) {
+        std::cout << "the map didn't load back the same!\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        reach-bench.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This program times the line of sight test used by
+//                 can_reach: the old one-tree-at-a-time loop over every
+//                 tree, the SIMD kernel over every tree (one segment
+//                 and a batch of segments at a time), the tree grid,
+//                 and the visibility cache in front of the tree grid.
+//
+//    Date:        10/11/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Source libraries
+#include "circle_store.h"
+#include "free_space.h"
+#include "random_stream.h"
+#include "reach_kernel.h"
+#include "simulation.h"
+#include "tree_grid.h"
+#include "visibility_cache.h"
+
+// World constants
+const float WORLD_WIDTH = 1200;  // world width
+const float WORLD_HEIGHT = 600;  // world height
+
+// Run defaults
+const GLuint DEFAULT_TREES = 40;  // number of trees to test against
+const GLuint DEFAULT_SEGMENTS = 100000;  // number of segments to test
+const GLuint REPEATS = 10;  // number of times every segment is tested by each method
+const GLuint MAX_DRAWS_PER_SEGMENT = 100;  // segments drawn per one kept before giving up on finding room
+
+//******************************************************************
+//
+//  Function:   time_method
+//
+//  Purpose:    times how long a line of sight method takes per segment
+//
+//  Parameters: name, num_segments, method, baseline
+//
+//  Member/Global Variables: REPEATS
+//
+//  Pre Conditions:  method must test every segment once and return how
+//                   many were blocked
+//
+//  Post Conditions: prints the method's time per segment, its speedup
+//                   over baseline (if baseline isn't 0), and the number
+//                   of blocked segments; returns the time per segment
+//
+//  Calls:      method, std::chrono::steady_clock::now
+//
+//******************************************************************
+template <typename Method>
+double time_method(const char* name, GLuint num_segments, Method method, double baseline) {
+    GLuint blocked = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (GLuint r = 0; r < REPEATS; ++r) {
+        blocked = method();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double ns = elapsed.count() * 1e9 / (static_cast<double>(num_segments) * REPEATS);
+
+    std::cout << name << ": " << ns << " ns/segment";
+    if (baseline > 0) {
+        std::cout << " (" << baseline / ns << "x)";
+    }
+    std::cout << ", " << blocked << " blocked\n";
+
+    return ns;
+}
+
+//******************************************************************
+//
+//  Function:   main
+//
+//  Purpose:    main function that creates random trees and segments
+//              and times each line of sight method on them
+//
+//  Parameters: argc, argv (optional tree count and segment count)
+//
+//  Member/Global Variables: WORLD_WIDTH, WORLD_HEIGHT, DEFAULT_TREES,
+//                           DEFAULT_SEGMENTS, TREE_MIN_SIZE,
+//                           TREE_MAX_SIZE, BAD_SIZE, GOOD_SIZE,
+//                           BAD_RANGE, VISIBILITY_CELL_SIZE,
+//                           FREE_SPACE_CELL_SIZE, MAX_DRAWS_PER_SEGMENT
+//
+//  Pre Conditions:  all of the above constants must have valid values
+//
+//  Post Conditions: the timings will have been printed to standard
+//                   output; returns failure if the methods disagree, or
+//                   (after printing why to standard error) if the trees
+//                   leave no room for the segments
+//
+//  Calls:      RandomStream::next, CircleStore::add, TreeGrid::build,
+//              FreeSpace::build, FreeSpace::sample, TreeGrid::point_blocked,
+//              segment_hits_circles_scalar, segment_hits_circles,
+//              segments_hit_circles, TreeGrid::segment_blocked,
+//              VisibilityCache::build, VisibilityCache::lookup,
+//              time_method, reach_kernel_name
+//
+//******************************************************************
+int main(int argc, char** argv) {
+    GLuint num_trees = DEFAULT_TREES;
+    GLuint num_segments = DEFAULT_SEGMENTS;
+    if (argc > 1) {
+        num_trees = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2) {
+        num_segments = std::strtoul(argv[2], nullptr, 10);
+    }
+
+    RandomStream random;
+
+    // random trees, packed the way the kernel wants them
+    float clearance = std::max(BAD_SIZE, GOOD_SIZE) / 2;
+    CircleStore trees;
+    std::vector<float> xs, ys, r2s;
+    for (GLuint i = 0; i < num_trees; ++i) {
+        float radius = TREE_MIN_SIZE + (TREE_MAX_SIZE - TREE_MIN_SIZE) * random.next();
+        vec2 pos = vec2(WORLD_WIDTH * (random.next() - 0.5), WORLD_HEIGHT * (random.next() - 0.5));
+        trees.add(pos, radius, 0, 0);
+        xs.push_back(pos.x);
+        ys.push_back(pos.y);
+        r2s.push_back((radius + clearance) * (radius + clearance));
+    }
+    TreeGrid grid;
+    grid.build(trees, clearance);
+    VisibilityCache cache;
+    vec2 half_world = vec2(WORLD_WIDTH, WORLD_HEIGHT) / 2;
+    cache.build(trees, clearance, -half_world, half_world, VISIBILITY_CELL_SIZE, BAD_RANGE);
+
+    // random segments the way units look for food: from a spot a unit can stand on (picked
+    // from the free space, as units are placed), to somewhere in the world within a bad guy's range
+    FreeSpace free_space;
+    free_space.build(trees, clearance, -half_world, half_world, FREE_SPACE_CELL_SIZE);
+    std::vector<vec2> as, bs;
+    unsigned long draws = 0;
+    while (as.size() < num_segments) {
+        vec2 a;
+        if (!free_space.sample(random, a) || ++draws > static_cast<unsigned long>(num_segments) * MAX_DRAWS_PER_SEGMENT) {
+            std::cerr << "Unable to find room for segments between the trees.\n";
+            return EXIT_FAILURE;
+        }
+        vec2 b = a + BAD_RANGE * vec2((random.next() - 0.5) * 2, (random.next() - 0.5) * 2);
+        if (grid.point_blocked(a) || length(b - a) > BAD_RANGE ||
+            std::abs(b.x) > half_world.x || std::abs(b.y) > half_world.y) {
+            continue;
+        }
+        as.push_back(a);
+        bs.push_back(b);
+    }
+    std::vector<char> expected(num_segments);
+    std::vector<char> actual(num_segments);
+    std::unique_ptr<bool[]> hits(new bool[num_segments]);  // what the batch kernel writes into
+
+    std::cout << "trees: " << num_trees << ", segments: " << num_segments << ", kernel: " << reach_kernel_name() << "\n";
+
+    double scalar = time_method("scalar, every tree", num_segments, [&]() {
+        GLuint blocked = 0;
+        for (GLuint i = 0; i < num_segments; ++i) {
+            vec2 dir = bs[i] - as[i];
+            expected[i] = segment_hits_circles_scalar(xs.data(), ys.data(), r2s.data(), num_trees, as[i], bs[i], dir, length(dir));
+            blocked += expected[i];
+        }
+        return blocked;
+    }, 0);
+
+    bool agree = true;
+    time_method("kernel, every tree", num_segments, [&]() {
+        GLuint blocked = 0;
+        for (GLuint i = 0; i < num_segments; ++i) {
+            vec2 dir = bs[i] - as[i];
+            actual[i] = segment_hits_circles(xs.data(), ys.data(), r2s.data(), num_trees, as[i], bs[i], dir, length(dir));
+            blocked += actual[i];
+        }
+        return blocked;
+    }, scalar);
+    agree = agree && actual == expected;
+
+    time_method("kernel batch, every tree", num_segments, [&]() {
+        segments_hit_circles(xs.data(), ys.data(), r2s.data(), num_trees, as.data(), bs.data(), num_segments, hits.get());
+        GLuint blocked = 0;
+        for (GLuint i = 0; i < num_segments; ++i) {
+            actual[i] = hits[i];
+            blocked += actual[i];
+        }
+        return blocked;
+    }, scalar);
+    agree = agree && actual == expected;
+
+    time_method("tree grid", num_segments, [&]() {
+        GLuint blocked = 0;
+        for (GLuint i = 0; i < num_segments; ++i) {
+            actual[i] = grid.segment_blocked(as[i], bs[i]);
+            blocked += actual[i];
+        }
+        return blocked;
+    }, scalar);
+    agree = agree && actual == expected;
+
+    // the first repeat fills in the cache, the rest only read it
+    GLuint unknown = 0;
+    time_method("visibility cache", num_segments, [&]() {
+        GLuint blocked = 0;
+        unknown = 0;
+        for (GLuint i = 0; i < num_segments; ++i) {
+            Visibility known = cache.lookup(as[i], bs[i]);
+            if (known == VISIBILITY_UNKNOWN) {
+                actual[i] = grid.segment_blocked(as[i], bs[i]);
+                unknown++;
+            } else {
+                actual[i] = (known == VISIBILITY_BLOCKED);
+            }
+            blocked += actual[i];
+        }
+        return blocked;
+    }, scalar);
+    agree = agree && actual == expected;
+    std::cout << "visibility cache fell back on " << unknown << " segments\n";
+
+    if (!agree) {
+        std::cout << "methods disagree!\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        tools/replay.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This program replays a recorded game without a window,
+//                 as fast as it can, applying every input at the tick it
+//                 was given and checking the state of the game at every
+//                 recorded checkpoint. It reports how fast the replay ran
+//                 and the first checkpoint that didn't match, if any, so
+//                 recorded games can be used to time and bisect changes.
+//
+//    Date:        10/16/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Source libraries
+#include "input_log.h"
+#include "map_file.h"
+#include "scenario.h"
+#include "simulation.h"
+
+//******************************************************************
+//
+//  Function:   main
+//
+//  Purpose:    main function that replays an input log and prints
+//              timing and game results
+//
+//  Parameters: argc, argv (the input log, then an optional thread
+//              count, where 0 means one thread per core)
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the game will have been replayed and its results
+//                   printed to standard output; returns failure if the
+//                   log or its map can't be opened, the thread count
+//                   isn't valid, or a checkpoint didn't match
+//
+//  Calls:      InputLog::load, InputLog::get_scenario, set_scenario_value,
+//              Simulation::set_world_size, Simulation::set_tuning,
+//              Simulation::set_seed, MapFile::open, Simulation::init,
+//              InputLog::get_tick_time, InputLog::get_inputs,
+//              Simulation::update, apply_input,
+//              Simulation::get_state_hash
+//
+//******************************************************************
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " input-log [threads]\n";
+        return EXIT_FAILURE;
+    }
+
+    InputLog log;
+    if (!log.load(argv[1])) {
+        return EXIT_FAILURE;
+    }
+    Scenario scenario = log.get_scenario();
+    if (argc > 2 && !set_scenario_value(scenario, "threads", argv[2])) {
+        std::cerr << "Invalid number of threads " << argv[2] << ".\n";
+        return EXIT_FAILURE;
+    }
+
+    // set the game up exactly as the recorded one was
+    Simulation sim(scenario.bad_guys, scenario.good_guys, scenario.trees, scenario.drops, scenario.threads);
+    sim.set_world_size(scenario.world_size);
+    sim.set_tuning(scenario.tuning);
+    sim.set_seed(scenario.seed);
+    MapFile map;
+    if (!scenario.map.empty()) {
+        if (!map.open(scenario.map)) {
+            return EXIT_FAILURE;
+        }
+        sim.init(map.get_view());
+    } else {
+        sim.init();
+    }
+    float dt = log.get_tick_time();
+
+    const std::vector<InputEvent>& inputs = log.get_inputs();
+    std::vector<unsigned char> saved;  // the quick save, as the recorded game had it
+    uint64_t ticks = 0;
+    unsigned long checkpoints = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const InputEvent& input : inputs) {
+        while (ticks < input.tick) {
+            sim.update(dt);
+            ticks++;
+        }
+
+        if (!apply_input(sim, input, map.is_open() ? &map : nullptr, saved)) {
+            std::cout << "checkpoint at tick " << input.tick << " (" << input.time
+                      << " seconds into the recording) doesn't match\n";
+            return EXIT_FAILURE;
+        }
+        if (input.kind == INPUT_CHECKPOINT) {
+            checkpoints++;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "seed: " << scenario.seed << "\n";
+    std::cout << "inputs: " << inputs.size() << "\n";
+    std::cout << "checkpoints matched: " << checkpoints << "\n";
+    std::cout << "ticks: " << ticks << "\n";
+    std::cout << "recorded seconds: " << (inputs.empty() ? 0 : inputs.back().time) << "\n";
+    std::cout << "seconds: " << elapsed.count() << "\n";
+    std::cout << "ticks/second: " << ticks / elapsed.count() << "\n";
+    std::cout << "score: " << sim.get_score() << "\n";
+    std::cout << "drops left: " << sim.get_drops_left() << "\n";
+    std::cout << "state hash: " << std::hex << sim.get_state_hash() << std::dec << "\n";
+
+    return EXIT_SUCCESS;
+}
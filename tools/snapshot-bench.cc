@@ -0,0 +1,297 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        tools/snapshot-bench.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This program plays a scenario partway, snapshots it,
+//                 and reports how long saving and restoring the
+//                 snapshot takes. It then checks that rolling the game
+//                 back to the snapshot, and forking a new game from it,
+//                 both play out exactly as the original did.
+//
+//    Date:        10/16/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Source libraries
+#include "map_file.h"
+#include "random_stream.h"
+#include "scenario.h"
+#include "simulation.h"
+
+// Run defaults
+const unsigned long DEFAULT_TICKS = 3000;  // number of ticks to play before the snapshot
+const unsigned long DEFAULT_ROLLBACK_TICKS = 1000;  // number of ticks to play after it, each time
+const unsigned long DEFAULT_REPEATS = 1000;  // number of times saving and restoring are timed
+const unsigned long DROP_INTERVAL = 600;  // ticks between attempted drops
+const uint64_t PLAYER_STREAM = 0xFFFFFFFFFFFFFFFF;  // stream of the seed the fake player clicks with (far past any map's)
+
+//******************************************************************
+//
+//  Function:   seconds_since
+//
+//  Purpose:    returns how long ago a time was
+//
+//  Parameters: start
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the seconds passed since start
+//
+//  Calls:      std::chrono::steady_clock::now
+//
+//******************************************************************
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//******************************************************************
+//
+//  Function:   play
+//
+//  Purpose:    steps a simulation, dropping food as a player would
+//
+//  Parameters: sim, player, first, ticks, dt
+//
+//  Member/Global Variables: DROP_INTERVAL
+//
+//  Pre Conditions:  sim must have been initialized
+//
+//  Post Conditions: sim will have been updated ticks times, numbered
+//                   from first, with a drop tried every DROP_INTERVAL
+//                   ticks at a position picked with player
+//
+//  Calls:      Simulation::get_world_size, RandomStream::next,
+//              Simulation::request_drop, Simulation::update
+//
+//******************************************************************
+void play(Simulation& sim, RandomStream& player, unsigned long first, unsigned long ticks, float dt) {
+    vec2 world_size = sim.get_world_size();
+    for (unsigned long i = first; i < first + ticks; ++i) {
+        if (i % DROP_INTERVAL == 0) {
+            vec2 pos = world_size * vec2(player.next() - 0.5, player.next() - 0.5);
+            sim.request_drop(pos);
+        }
+
+        sim.update(dt);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   same_array
+//
+//  Purpose:    determines whether two arrays hold the same bytes
+//
+//  Parameters: a, b
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if the arrays are bit for bit the same
+//
+//  Calls:      std::memcmp
+//
+//******************************************************************
+template <typename T>
+bool same_array(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+//******************************************************************
+//
+//  Function:   same_units
+//
+//  Purpose:    determines whether two stores hold the same units
+//
+//  Parameters: a, b
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if the units have the same ids,
+//                   positions, rotations, food, and targets
+//
+//  Calls:      same_array, UnitStore::get_id, UnitStore::get_food,
+//              UnitStore::get_target_food
+//
+//******************************************************************
+bool same_units(const UnitStore& a, const UnitStore& b) {
+    if (!same_array(a.get_positions(), b.get_positions()) || !same_array(a.get_rotations(), b.get_rotations())) {
+        return false;
+    }
+    for (GLuint i = 0; i < a.size(); ++i) {
+        if (a.get_id(i) != b.get_id(i) || a.get_food(i) != b.get_food(i) ||
+            a.get_target_food(i) != b.get_target_food(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   same_game
+//
+//  Purpose:    determines whether two simulations are in the same state
+//
+//  Parameters: a, b
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if the score, drops, units, and food
+//                   drops of the games are bit for bit the same
+//
+//  Calls:      same_units, same_array, CircleStore::get_amount
+//
+//******************************************************************
+bool same_game(const Simulation& a, const Simulation& b) {
+    if (a.get_score() != b.get_score() || a.get_drops_left() != b.get_drops_left() ||
+        !same_units(a.get_bad_guys(), b.get_bad_guys()) || !same_units(a.get_good_guys(), b.get_good_guys()) ||
+        !same_units(a.get_plane(), b.get_plane()) ||
+        !same_array(a.get_food_drops().get_positions(), b.get_food_drops().get_positions())) {
+        return false;
+    }
+    for (GLuint i = 0; i < a.get_food_drops().size(); ++i) {
+        if (a.get_food_drops().get_amount(i) != b.get_food_drops().get_amount(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   main
+//
+//  Purpose:    main function that times snapshots and checks that
+//              games restored from them play out the same
+//
+//  Parameters: argc, argv (scenario options, then optional ticks to
+//              play before the snapshot, ticks to play after it, and
+//              times to repeat saving and restoring)
+//
+//  Member/Global Variables: DEFAULT_TICKS, DEFAULT_ROLLBACK_TICKS,
+//                           DEFAULT_REPEATS, PLAYER_STREAM
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the timings will have been printed to standard
+//                   output; returns failure if an option isn't valid,
+//                   the scenario's map can't be opened, or a restored
+//                   game didn't play out the same
+//
+//  Calls:      default_scenario, parse_scenario_args, get_world_size,
+//              Simulation::set_world_size, Simulation::set_tuning,
+//              Simulation::set_seed, MapFile::open, Simulation::init,
+//              play, Simulation::save_snapshot,
+//              Simulation::restore_snapshot, seconds_since, same_game
+//
+//******************************************************************
+int main(int argc, char** argv) {
+    Scenario scenario = default_scenario();
+    std::vector<char*> rest;
+    if (!parse_scenario_args(scenario, argc, argv, rest)) {
+        return EXIT_FAILURE;
+    }
+
+    unsigned long ticks = DEFAULT_TICKS;
+    unsigned long rollback_ticks = DEFAULT_ROLLBACK_TICKS;
+    unsigned long repeats = DEFAULT_REPEATS;
+    if (rest.size() > 0) {
+        ticks = std::strtoul(rest[0], nullptr, 10);
+    }
+    if (rest.size() > 1) {
+        rollback_ticks = std::strtoul(rest[1], nullptr, 10);
+    }
+    if (rest.size() > 2) {
+        repeats = std::max(std::strtoul(rest[2], nullptr, 10), 1UL);
+    }
+    float dt = 1 / scenario.tick_rate;
+
+    Simulation sim(scenario.bad_guys, scenario.good_guys, scenario.trees, scenario.drops, scenario.threads);
+    sim.set_world_size(get_world_size(scenario));
+    sim.set_tuning(scenario.tuning);
+    sim.set_seed(scenario.seed);
+    MapFile map;
+    if (!scenario.map.empty()) {
+        if (!map.open(scenario.map)) {
+            return EXIT_FAILURE;
+        }
+        sim.init(map.get_view());
+    } else {
+        sim.init();
+    }
+
+    // play up to the snapshot (the player's clicks are kept alongside it, so they repeat too)
+    RandomStream player(sim.get_seed(), PLAYER_STREAM);
+    play(sim, player, 0, ticks, dt);
+    std::vector<unsigned char> snapshot;
+    sim.save_snapshot(snapshot);
+    RandomStream saved_player = player;
+
+    // time saving and restoring on the same map, as a rollback would
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < repeats; ++i) {
+        sim.save_snapshot(snapshot);
+    }
+    double save_time = seconds_since(start) / repeats;
+    start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < repeats; ++i) {
+        sim.restore_snapshot(snapshot);
+    }
+    double restore_time = seconds_since(start) / repeats;
+
+    // play on from the snapshot, then roll back and play the same ticks again
+    Simulation played(0, 0, 0, 0, scenario.threads);
+    played.set_tuning(scenario.tuning);
+    play(sim, player, ticks, rollback_ticks, dt);
+    std::vector<unsigned char> after;
+    sim.save_snapshot(after);
+    played.restore_snapshot(after);
+
+    player = saved_player;
+    bool rolled_back = sim.restore_snapshot(snapshot);
+    play(sim, player, ticks, rollback_ticks, dt);
+    rolled_back = rolled_back && same_game(sim, played);
+
+    // and fork a game that has never made a map from the snapshot
+    Simulation fork(0, 0, 0, 0, scenario.threads);
+    fork.set_tuning(scenario.tuning);
+    player = saved_player;
+    start = std::chrono::steady_clock::now();
+    bool forked = fork.restore_snapshot(snapshot);
+    double fork_time = seconds_since(start);
+    play(fork, player, ticks, rollback_ticks, dt);
+    forked = forked && same_game(fork, played);
+
+    std::cout << "snapshot bytes: " << snapshot.size() << "\n";
+    std::cout << "save microseconds: " << save_time * 1e6 << "\n";
+    std::cout << "restore microseconds: " << restore_time * 1e6 << "\n";
+    std::cout << "fork microseconds: " << fork_time * 1e6 << "\n";
+    std::cout << "rollback plays out the same: " << (rolled_back ? "yes" : "no") << "\n";
+    std::cout << "fork plays out the same: " << (forked ? "yes" : "no") << "\n";
+
+    if (!rolled_back || !forked) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
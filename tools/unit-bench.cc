@@ -0,0 +1,181 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        unit-bench.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This program times the batch unit update: the exact
+//                 one-unit-at-a-time update, and the SIMD kernel with
+//                 each of its angle tolerances, checking that the
+//                 kernel moves every unit exactly as the exact update
+//                 does and keeps rotations within its tolerance (units
+//                 at rest sleep once they face their targets within
+//                 it).
+//
+//    Date:        10/13/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Source libraries
+#include "random_stream.h"
+#include "simulation.h"
+#include "unit_kernel.h"
+#include "unit_store.h"
+#include "utilities.h"
+
+// World constants
+const float WORLD_WIDTH = 1200;  // world width
+const float WORLD_HEIGHT = 600;  // world height
+
+// Run defaults
+const GLuint DEFAULT_UNITS = 1000000;  // number of units to update
+const GLuint DEFAULT_TICKS = 10;  // number of times every unit is updated by each method
+const float TICK = 1.0f / 60;  // delta time of each update
+
+// Extra error allowed on top of the tolerance, for rounding in the angle differences
+const float ROUNDING_SLACK = 1e-5;
+
+// Angle tolerances the kernel is timed with
+const float TOLERANCES[] = { 1e-2, 1e-3, 1e-4, 1e-5 };
+
+//******************************************************************
+//
+//  Function:   time_update
+//
+//  Purpose:    times how long updating every unit takes per unit
+//
+//  Parameters: name, units, ticks, baseline
+//
+//  Member/Global Variables: TICK
+//
+//  Pre Conditions:  units must have its angle tolerance set
+//
+//  Post Conditions: units will have been updated ticks times; prints the
+//                   time per unit update and its speedup over baseline
+//                   (if baseline isn't 0), and returns the time per unit
+//                   update
+//
+//  Calls:      UnitStore::update, std::chrono::steady_clock::now
+//
+//******************************************************************
+double time_update(const char* name, UnitStore& units, GLuint ticks, double baseline) {
+    auto start = std::chrono::steady_clock::now();
+    for (GLuint t = 0; t < ticks; ++t) {
+        units.update(TICK);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double ns = elapsed.count() * 1e9 / (static_cast<double>(units.size()) * ticks);
+
+    std::cout << name << ": " << ns << " ns/unit";
+    if (baseline > 0) {
+        std::cout << " (" << baseline / ns << "x)";
+    }
+    std::cout << "\n";
+
+    return ns;
+}
+
+//******************************************************************
+//
+//  Function:   main
+//
+//  Purpose:    main function that creates random units and times each
+//              way of updating them
+//
+//  Parameters: argc, argv (optional unit count and tick count)
+//
+//  Member/Global Variables: WORLD_WIDTH, WORLD_HEIGHT, DEFAULT_UNITS,
+//                           DEFAULT_TICKS, TOLERANCES, ROUNDING_SLACK,
+//                           BAD_SIZE, BAD_SPEED, BAD_BOOST_FACTOR,
+//                           SPEED_BOOST_DURATION, UNIT_KERNEL_EXACT, E_PI
+//
+//  Pre Conditions:  all of the above constants must have valid values
+//
+//  Post Conditions: the timings will have been printed to standard
+//                   output; returns failure if the kernel moved a unit
+//                   differently or let a rotation drift past its
+//                   tolerance
+//
+//  Calls:      RandomStream::next, UnitStore::reserve, UnitStore::add,
+//              UnitStore::set_target_pos, UnitStore::give_boost,
+//              UnitStore::set_angle_tolerance, time_update,
+//              unit_kernel_name, angle_difference
+//
+//******************************************************************
+int main(int argc, char** argv) {
+    GLuint num_units = DEFAULT_UNITS;
+    GLuint ticks = DEFAULT_TICKS;
+    if (argc > 1) {
+        num_units = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2) {
+        ticks = std::strtoul(argv[2], nullptr, 10);
+    }
+
+    RandomStream random;
+
+    // random units heading for random spots; some are boosted, and some are already
+    // where they're going, so every branch of the update is taken (units start facing
+    // within a quarter turn of their targets: one facing straight away could turn either
+    // way, and an approximate angle may send it the other way than the exact one)
+    UnitStore start;
+    start.reserve(num_units);
+    for (GLuint i = 0; i < num_units; ++i) {
+        vec2 pos = vec2(WORLD_WIDTH * (random.next() - 0.5), WORLD_HEIGHT * (random.next() - 0.5));
+        vec2 target = pos;
+        if (i % 16 != 0) {
+            target = vec2(WORLD_WIDTH * (random.next() - 0.5), WORLD_HEIGHT * (random.next() - 0.5));
+        }
+        float rot = std::atan2(target.y - pos.y, target.x - pos.x) + (random.next() - 0.5) * E_PI;
+        start.add(pos, rot, BAD_SIZE, 0, BAD_SPEED, BAD_BOOST_FACTOR);
+        start.set_target_pos(i, target);
+        if (i % 4 == 0) {
+            start.give_boost(i, SPEED_BOOST_DURATION * random.next());
+        }
+    }
+
+    std::cout << "units: " << num_units << ", ticks: " << ticks << ", kernel: " << unit_kernel_name() << "\n";
+
+    UnitStore expected = start;
+    expected.set_angle_tolerance(UNIT_KERNEL_EXACT);
+    double exact = time_update("exact", expected, ticks, 0);
+
+    bool agree = true;
+    for (float tolerance : TOLERANCES) {
+        UnitStore actual = start;
+        actual.set_angle_tolerance(tolerance);
+        std::cout << "tolerance " << tolerance << ", ";
+        time_update("kernel", actual, ticks, exact);
+
+        // positions must match exactly, and rotations stay within the bound
+        GLuint moved_differently = 0;
+        float worst = 0;
+        for (GLuint i = 0; i < num_units; ++i) {
+            vec2 a = expected.get_position(i);
+            vec2 b = actual.get_position(i);
+            if (a.x != b.x || a.y != b.y) {
+                moved_differently++;
+            }
+            worst = std::max(worst, std::fabs(angle_difference(expected.get_rotation(i), actual.get_rotation(i))));
+        }
+        float bound = tolerance + ROUNDING_SLACK;
+        std::cout << "  worst rotation error " << worst << " (bound " << bound << "), "
+                  << moved_differently << " units moved differently\n";
+        agree = agree && moved_differently == 0 && worst <= bound;
+    }
+
+    if (!agree) {
+        std::cout << "kernel disagrees with the exact update!\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,436 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        trace_recorder.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These classes record what every thread of the game
+//                 was doing and when (frames, simulation phases, draw
+//                 passes, clicks, and units and food coming and going)
+//                 to a Chrome trace JSON file, which chrome://tracing
+//                 and Perfetto show as a timeline. Each thread records
+//                 into a ring buffer of its own without locking, and the
+//                 rings are written out between frames, so tracing can
+//                 be left on for a whole session.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <iomanip>
+#include <iostream>
+
+// Source libraries
+#include "trace_recorder.h"
+
+// The ring the calling thread last recorded into, and the trace it was recording then
+struct ThreadRing {
+    uint64_t session;  // unique number of the trace (0 for none)
+    TraceBuffer* buffer;  // the thread's ring in that trace
+};
+static thread_local ThreadRing thread_ring = { 0, nullptr };
+
+std::atomic<uint64_t> TraceRecorder::sessions_started(0);
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::~TraceRecorder
+//
+//  Purpose:    finishes the trace and frees every ring
+//
+//  Parameters: none
+//
+//  Member/Global Variables: buffers
+//
+//  Pre Conditions:  no thread may be recording
+//
+//  Post Conditions: the trace will have been finished, if one was open,
+//                   and every ring freed
+//
+//  Calls:      close
+//
+//******************************************************************
+TraceRecorder::~TraceRecorder() {
+    close();
+
+    TraceBuffer* buffer = buffers.load();
+    while (buffer != nullptr) {
+        TraceBuffer* next = buffer->next;
+        delete buffer;
+        buffer = next;
+    }
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::get_dropped
+//
+//  Purpose:    returns the number of events lost to full rings
+//
+//  Parameters: none
+//
+//  Member/Global Variables: buffers
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the number of events of the current trace
+//                   that weren't recorded, since their thread's ring
+//                   was full (it wasn't flushed often enough)
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t TraceRecorder::get_dropped() const {
+    uint64_t dropped = 0;
+    for (TraceBuffer* buffer = buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::open
+//
+//  Purpose:    starts a trace
+//
+//  Parameters: path
+//
+//  Member/Global Variables: file, origin, buffers, session,
+//                           sessions_started, first_event, recording
+//
+//  Pre Conditions:  no thread may be recording
+//
+//  Post Conditions: the file at path will hold the start of a trace, and
+//                   events recorded from now on are added to it (rings
+//                   of an earlier trace are emptied, to be reused);
+//                   returns false, after printing why to standard
+//                   error, if it couldn't be written
+//
+//  Calls:      close, std::ofstream::open, std::chrono::steady_clock::now
+//
+//******************************************************************
+bool TraceRecorder::open(const std::string& path) {
+    close();
+
+    file.open(path, std::ios::trunc);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    if (!file) {
+        file.close();
+        std::cerr << "Unable to write trace " << path << ".\n";
+        return false;
+    }
+    file << std::fixed << std::setprecision(3);  // timestamps are in microseconds, to the nanosecond
+
+    for (TraceBuffer* buffer = buffers.load(); buffer != nullptr; buffer = buffer->next) {
+        buffer->written.store(0);
+        buffer->read.store(0);
+        buffer->dropped.store(0);
+        buffer->named = false;
+    }
+    session = ++sessions_started;
+    first_event = true;
+    origin = std::chrono::steady_clock::now();
+    recording.store(true);
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::flush
+//
+//  Purpose:    writes every event recorded so far to the trace
+//
+//  Parameters: none
+//
+//  Member/Global Variables: buffers, file, TRACE_BUFFER_EVENTS
+//
+//  Pre Conditions:  only one thread may flush at a time
+//
+//  Post Conditions: every event added to a ring before the call will
+//                   have been written out and its slot freed (threads
+//                   can keep recording while it runs)
+//
+//  Calls:      is_open, write_event
+//
+//******************************************************************
+void TraceRecorder::flush() {
+    if (!is_open()) {
+        return;
+    }
+
+    for (TraceBuffer* buffer = buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next) {
+        // only this thread moves read, and the acquire makes the events before written visible
+        uint64_t read = buffer->read.load(std::memory_order_relaxed);
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        for (uint64_t i = read; i < written; ++i) {
+            write_event(*buffer, buffer->events[i & (TRACE_BUFFER_EVENTS - 1)]);
+        }
+        buffer->read.store(written, std::memory_order_release);  // the thread may reuse the slots now
+    }
+    file.flush();
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::close
+//
+//  Purpose:    finishes the trace
+//
+//  Parameters: none
+//
+//  Member/Global Variables: file, recording
+//
+//  Pre Conditions:  no thread may be recording
+//
+//  Post Conditions: every event left will have been written out and the
+//                   file finished, and nothing more is recorded
+//
+//  Calls:      is_open, flush, std::ofstream::close
+//
+//******************************************************************
+void TraceRecorder::close() {
+    if (!is_open()) {
+        return;
+    }
+
+    flush();
+    file << "\n]}\n";
+    file.close();
+    recording.store(false);
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::is_open
+//
+//  Purpose:    returns whether events are being recorded
+//
+//  Parameters: none
+//
+//  Member/Global Variables: recording
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if a trace is open
+//
+//  Calls:      none
+//
+//******************************************************************
+bool TraceRecorder::is_open() const {
+    return recording.load(std::memory_order_relaxed);
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::now
+//
+//  Purpose:    returns the time events are stamped with
+//
+//  Parameters: none
+//
+//  Member/Global Variables: origin
+//
+//  Pre Conditions:  a trace must be open
+//
+//  Post Conditions: returns the nanoseconds since the trace started
+//
+//  Calls:      std::chrono::steady_clock::now
+//
+//******************************************************************
+uint64_t TraceRecorder::now() const {
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - origin;
+    return elapsed.count();
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::add_span
+//
+//  Purpose:    records a span on the calling thread
+//
+//  Parameters: category, name, start
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  category and name must be string literals, and
+//                   start a time given by now
+//
+//  Post Conditions: if a trace is open, a span from start until now
+//                   will have been added to the calling thread's ring
+//
+//  Calls:      is_open, now, add
+//
+//******************************************************************
+void TraceRecorder::add_span(const char* category, const char* name, uint64_t start) {
+    if (!is_open()) {
+        return;
+    }
+
+    TraceEvent event = { category, name, nullptr, 0, start, now() - start, false };
+    add(event);
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::add_instant
+//
+//  Purpose:    records a moment on the calling thread
+//
+//  Parameters: category, name, arg_name, arg
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  category, name, and arg_name (unless it's null)
+//                   must be string literals
+//
+//  Post Conditions: if a trace is open, an instant event will have been
+//                   added to the calling thread's ring, with arg as
+//                   arg_name if arg_name isn't null
+//
+//  Calls:      is_open, now, add
+//
+//******************************************************************
+void TraceRecorder::add_instant(const char* category, const char* name, const char* arg_name, uint64_t arg) {
+    if (!is_open()) {
+        return;
+    }
+
+    TraceEvent event = { category, name, arg_name, arg, now(), 0, true };
+    add(event);
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::add
+//
+//  Purpose:    adds an event to the calling thread's ring
+//
+//  Parameters: event
+//
+//  Member/Global Variables: TRACE_BUFFER_EVENTS
+//
+//  Pre Conditions:  a trace must be open
+//
+//  Post Conditions: the event will be in the ring for the next flush, or
+//                   counted as dropped if the ring is full
+//
+//  Calls:      get_buffer
+//
+//******************************************************************
+void TraceRecorder::add(const TraceEvent& event) {
+    TraceBuffer* buffer = get_buffer();
+
+    // only this thread moves written, and the acquire makes sure a flush is done with a slot before it's reused
+    uint64_t written = buffer->written.load(std::memory_order_relaxed);
+    if (written - buffer->read.load(std::memory_order_acquire) >= TRACE_BUFFER_EVENTS) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[written & (TRACE_BUFFER_EVENTS - 1)] = event;
+    buffer->written.store(written + 1, std::memory_order_release);
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::get_buffer
+//
+//  Purpose:    returns the calling thread's ring
+//
+//  Parameters: none
+//
+//  Member/Global Variables: buffers, num_threads, session, thread_ring,
+//                           TRACE_BUFFER_EVENTS
+//
+//  Pre Conditions:  a trace must be open
+//
+//  Post Conditions: returns the ring the calling thread records into,
+//                   after finding the one it had in an earlier trace, or
+//                   adding one to the front of the list if it never had
+//                   one (with a compare and swap, so threads never wait
+//                   on each other)
+//
+//  Calls:      std::this_thread::get_id,
+//              std::atomic::compare_exchange_weak
+//
+//******************************************************************
+TraceBuffer* TraceRecorder::get_buffer() {
+    if (thread_ring.session == session) {
+        return thread_ring.buffer;
+    }
+
+    // rings are kept between traces, so a thread only ever has one
+    std::thread::id id = std::this_thread::get_id();
+    TraceBuffer* buffer = buffers.load(std::memory_order_acquire);
+    while (buffer != nullptr && buffer->owner != id) {
+        buffer = buffer->next;
+    }
+    if (buffer != nullptr) {
+        thread_ring.session = session;
+        thread_ring.buffer = buffer;
+        return buffer;
+    }
+
+    buffer = new TraceBuffer();
+    buffer->owner = id;
+    buffer->events.resize(TRACE_BUFFER_EVENTS);
+    buffer->written.store(0);
+    buffer->read.store(0);
+    buffer->dropped.store(0);
+    buffer->thread = num_threads++;
+    buffer->named = false;
+    buffer->next = buffers.load(std::memory_order_relaxed);
+    while (!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+        // another thread added its ring first, so buffer->next now holds it; try again
+    }
+
+    thread_ring.session = session;
+    thread_ring.buffer = buffer;
+    return buffer;
+}
+
+//******************************************************************
+//
+//  Function:   TraceRecorder::write_event
+//
+//  Purpose:    writes an event out as JSON
+//
+//  Parameters: buffer, event
+//
+//  Member/Global Variables: file, first_event
+//
+//  Pre Conditions:  event must have been recorded into buffer
+//
+//  Post Conditions: the event will have been written to the trace as a
+//                   Chrome trace event (a complete event for a span, a
+//                   thread scoped instant event otherwise), preceded by
+//                   the name of its thread the first time it shows up
+//
+//  Calls:      none
+//
+//******************************************************************
+void TraceRecorder::write_event(TraceBuffer& buffer, const TraceEvent& event) {
+    if (!buffer.named) {
+        buffer.named = true;
+        file << (first_event ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+             << buffer.thread << ", \"args\": {\"name\": \"thread " << buffer.thread << "\"}}";
+        first_event = false;
+    }
+
+    file << (first_event ? "" : ",\n") << "{\"name\": \"" << event.name << "\", \"cat\": \"" << event.category
+         << "\", \"ts\": " << event.start / 1000.0 << ", \"pid\": 1, \"tid\": " << buffer.thread;
+    if (event.instant) {
+        file << ", \"ph\": \"i\", \"s\": \"t\"";
+    } else {
+        file << ", \"ph\": \"X\", \"dur\": " << event.duration / 1000.0;
+    }
+    if (event.arg_name != nullptr) {
+        file << ", \"args\": {\"" << event.arg_name << "\": " << event.arg << "}";
+    }
+    file << "}";
+    first_event = false;
+}
@@ -0,0 +1,184 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        trace_recorder.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These classes record what every thread of the game
+//                 was doing and when (frames, simulation phases, draw
+//                 passes, clicks, and units and food coming and going)
+//                 to a Chrome trace JSON file, which chrome://tracing
+//                 and Perfetto show as a timeline. Each thread records
+//                 into a ring buffer of its own without locking, and the
+//                 rings are written out between frames, so tracing can
+//                 be left on for a whole session.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+// C/C++ Standard libraries
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Trace constants
+const GLuint TRACE_BUFFER_EVENTS = 1 << 14;  // events each thread's ring holds before new ones are dropped (a power of 2)
+
+// Categories events are recorded under
+constexpr char const* TRACE_FRAME = "frame";  // frames and updating the game between them
+constexpr char const* TRACE_SIM = "sim";  // simulation phases
+constexpr char const* TRACE_DRAW = "draw";  // draw passes
+constexpr char const* TRACE_INPUT = "input";  // clicks and the selection pass
+constexpr char const* TRACE_ENTITY = "entity";  // units and food drops made and removed
+
+// One event of a trace (names must be string literals, since they're written out later)
+struct TraceEvent {
+    const char* category;  // TRACE_ category
+    const char* name;  // what happened
+    const char* arg_name;  // name of the event's argument, or null if it has none
+    uint64_t arg;  // value of the argument
+    uint64_t start;  // nanoseconds since the trace started
+    uint64_t duration;  // nanoseconds the event lasted (0 for an instant)
+    bool instant;  // whether the event is a moment instead of a span
+};
+
+// One thread's events, written by that thread and read by whoever flushes the trace
+struct TraceBuffer {
+    std::vector<TraceEvent> events;  // ring of events, indexed by count modulo its size
+    std::atomic<uint64_t> written;  // number of events the thread has added
+    std::atomic<uint64_t> read;  // number of events written out
+    std::atomic<uint64_t> dropped;  // number of events lost because the ring was full
+    std::thread::id owner;  // thread that records into the ring
+    GLuint thread;  // id of the thread in the trace
+    bool named;  // whether the thread's name has been written out
+    TraceBuffer* next;  // buffer of the thread that started recording before this one
+};
+
+//******************************************************************
+//
+//  Class: TraceRecorder
+//
+//  Purpose:  To record timed events from any thread into per-thread
+//            ring buffers (only the first event a thread records takes
+//            more than a few stores, to add its ring), and stream them
+//            to a Chrome trace JSON file whenever it's flushed.
+//
+//  Functions:
+//           Constructors
+//             TraceRecorder() creates a recorder that isn't recording
+//           Destructor
+//             ~TraceRecorder() finishes the trace and frees every ring
+//           getters
+//             get_dropped to return the number of events lost to full
+//                         rings
+//           mutators
+//             open(path) starts a trace at path
+//             flush() writes every event recorded so far to the trace
+//             close() writes out every event left and finishes the trace
+//           helpers
+//             is_open() returns true if events are being recorded
+//             now() returns the nanoseconds since the trace started
+//             add_span(category, name, start) records a span that started
+//                                             at start and ends now
+//             add_instant(category, name, arg_name,
+//                         arg)  records a moment, with an argument if
+//                               arg_name isn't null
+//           private helpers
+//             add(event) adds an event to the calling thread's ring
+//             get_buffer() returns the calling thread's ring, adding it if
+//                          it has never had one
+//             write_event(buffer, event) writes an event out as JSON
+//
+//******************************************************************
+
+class TraceRecorder {
+ public:
+    TraceRecorder() : recording(false), buffers(nullptr), num_threads(0), session(0), first_event(true) {}
+    TraceRecorder(const TraceRecorder&) = delete;  // no copy constructor
+    TraceRecorder operator=(const TraceRecorder&) = delete;  // no copy assignment operator
+    ~TraceRecorder();
+
+    // getters
+    uint64_t get_dropped() const;
+
+    // mutators
+    bool open(const std::string& path);
+    void flush();
+    void close();
+
+    // helpers
+    bool is_open() const;
+    uint64_t now() const;
+    void add_span(const char* category, const char* name, uint64_t start);
+    void add_instant(const char* category, const char* name, const char* arg_name = nullptr, uint64_t arg = 0);
+ private:
+    std::ofstream file;  // trace being written
+    std::atomic<bool> recording;  // whether a trace is open (read by every thread that records)
+    std::chrono::steady_clock::time_point origin;  // when the trace started
+    std::atomic<TraceBuffer*> buffers;  // ring of every thread that has recorded, newest first
+    std::atomic<GLuint> num_threads;  // number of rings added
+    uint64_t session;  // unique number of the trace, so threads can tell their ring belongs to it
+    bool first_event;  // whether no event has been written out yet
+
+    // static member variables
+    static std::atomic<uint64_t> sessions_started;  // number of traces opened by any recorder
+
+    // private helpers
+    void add(const TraceEvent& event);
+    TraceBuffer* get_buffer();
+    void write_event(TraceBuffer& buffer, const TraceEvent& event);
+};
+
+//******************************************************************
+//
+//  Class: ScopedTrace
+//
+//  Purpose:  To record the scope it lives in as a span of a trace. It
+//            does nothing (not even read the clock) if it's given no
+//            recorder, or one that isn't recording.
+//
+//  Functions:
+//           Constructors
+//             ScopedTrace() = delete
+//             ScopedTrace(trace, category, name) starts a span, recorded
+//                                                in trace (which may be
+//                                                null)
+//           Destructor
+//             ~ScopedTrace() records the span, ending now
+//
+//******************************************************************
+
+class ScopedTrace {
+ public:
+    ScopedTrace() = delete;  // no default constructor
+    ScopedTrace(TraceRecorder* trace, const char* category, const char* name)
+        : trace(trace != nullptr && trace->is_open() ? trace : nullptr), category(category), name(name),
+          start(this->trace != nullptr ? this->trace->now() : 0) {}
+    ScopedTrace(const ScopedTrace&) = delete;  // no copy constructor
+    ScopedTrace operator=(const ScopedTrace&) = delete;  // no copy assignment operator
+    ~ScopedTrace() {
+        if (trace != nullptr) {
+            trace->add_span(category, name, start);
+        }
+    }
+ private:
+    TraceRecorder* trace;  // where the span is recorded, or null to not record it (not owned)
+    const char* category;  // TRACE_ category of the span
+    const char* name;  // what the span is of
+    uint64_t start;  // nanoseconds since the trace started when the span started
+};
+
+#endif
@@ -0,0 +1,359 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        tree_grid.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a static uniform grid over the
+//                 trees of a map, so that traversability and line of
+//                 sight checks only test the trees near the query
+//                 instead of every tree in the map.
+//
+//    Date:        10/8/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+// Source libraries
+#include "reach_kernel.h"
+#include "tree_grid.h"
+
+//******************************************************************
+//
+//  Function:   TreeGrid::build
+//
+//  Purpose:    rebuilds the grid from the given trees
+//
+//  Parameters: trees, clearance
+//
+//  Member/Global Variables: origin, extent, cell_size, cols, rows,
+//                           cell_start, cell_trees, centers, radii,
+//                           pack_start, pack_xs, pack_ys, pack_r2s,
+//                           REACH_KERNEL_WIDTH, REACH_KERNEL_PAD_R2
+//
+//  Pre Conditions:  trees must hold the trees of the map
+//
+//  Post Conditions: the grid will cover every tree inflated by
+//                   clearance (trees that a negative clearance shrinks
+//                   to nothing are left out), and every cell will list the trees whose
+//                   bounding box overlaps it, both by index and packed
+//                   for the reach kernel
+//
+//  Calls:      CircleStore::get_position, CircleStore::get_radius, std::min,
+//              std::max, std::sqrt, std::ceil, cell_of
+//
+//******************************************************************
+void TreeGrid::build(const CircleStore& trees, float clearance) {
+    centers.clear();
+    radii.clear();
+    cell_start.clear();
+    cell_trees.clear();
+    pack_start.clear();
+    pack_xs.clear();
+    pack_ys.clear();
+    pack_r2s.clear();
+    cols = 0;
+    rows = 0;
+
+    // copy tree data and find the bounds of all inflated trees
+    vec2 low = vec2(std::numeric_limits<float>::max());
+    vec2 high = vec2(-std::numeric_limits<float>::max());
+    float max_radius = 0;
+    for (GLuint i = 0; i < trees.size(); ++i) {
+        vec2 center = trees.get_position(i);
+        float radius = trees.get_radius(i) + clearance;
+        if (radius <= 0) {
+            continue;  // a negative clearance shrank this tree away, so it can't block anything
+        }
+        centers.push_back(center);
+        radii.push_back(radius);
+
+        low = vec2(std::min(low.x, center.x - radius), std::min(low.y, center.y - radius));
+        high = vec2(std::max(high.x, center.x + radius), std::max(high.y, center.y + radius));
+        max_radius = std::max(max_radius, radius);
+    }
+
+    if (centers.size() == 0) {
+        return;  // nothing can block anything, leave the grid empty
+    }
+
+    // cells at least as wide as the largest tree keep each tree in at most 4 cells,
+    // and cells no smaller than the area per tree keep the cell count at most the tree count
+    vec2 span = high - low;
+    cell_size = std::max(2 * max_radius, std::sqrt(span.x * span.y / centers.size()));
+    origin = low;
+    extent = high;
+    cols = std::max(1, static_cast<int>(std::ceil(span.x / cell_size)));
+    rows = std::max(1, static_cast<int>(std::ceil(span.y / cell_size)));
+
+    // count how many trees land in each cell (offset by one for the prefix sum)
+    cell_start.assign(cols * rows + 1, 0);
+    for (GLuint i = 0; i < centers.size(); ++i) {
+        int min_col, min_row, max_col, max_row;
+        cell_of(centers[i] - vec2(radii[i]), min_col, min_row);
+        cell_of(centers[i] + vec2(radii[i]), max_col, max_row);
+        for (int row = min_row; row <= max_row; ++row) {
+            for (int col = min_col; col <= max_col; ++col) {
+                cell_start[row * cols + col + 1]++;
+            }
+        }
+    }
+
+    // turn counts into starting indices
+    for (int i = 0; i < cols * rows; ++i) {
+        cell_start[i + 1] += cell_start[i];
+    }
+
+    // fill in each cell's tree indices
+    cell_trees.resize(cell_start[cols * rows]);
+    std::vector<GLuint> fill(cell_start.begin(), cell_start.end() - 1);  // next free slot of each cell
+    for (GLuint i = 0; i < centers.size(); ++i) {
+        int min_col, min_row, max_col, max_row;
+        cell_of(centers[i] - vec2(radii[i]), min_col, min_row);
+        cell_of(centers[i] + vec2(radii[i]), max_col, max_row);
+        for (int row = min_row; row <= max_row; ++row) {
+            for (int col = min_col; col <= max_col; ++col) {
+                cell_trees[fill[row * cols + col]++] = i;
+            }
+        }
+    }
+
+    // copy each cell's trees next to each other for the reach kernel, padding every cell
+    // to a whole number of kernel steps with trees that can't block anything
+    pack_start.resize(cols * rows + 1);
+    for (int cell = 0; cell < cols * rows; ++cell) {
+        pack_start[cell] = pack_xs.size();
+        for (GLuint i = cell_start[cell]; i < cell_start[cell + 1]; ++i) {
+            GLuint tree = cell_trees[i];
+            pack_xs.push_back(centers[tree].x);
+            pack_ys.push_back(centers[tree].y);
+            pack_r2s.push_back(radii[tree] * radii[tree]);  // square minimum radius
+        }
+        while (pack_xs.size() % REACH_KERNEL_WIDTH != 0) {
+            pack_xs.push_back(0);
+            pack_ys.push_back(0);
+            pack_r2s.push_back(REACH_KERNEL_PAD_R2);
+        }
+    }
+    pack_start[cols * rows] = pack_xs.size();
+}
+
+//******************************************************************
+//
+//  Function:   TreeGrid::point_blocked
+//
+//  Purpose:    determines whether the given position is inside an
+//              inflated tree
+//
+//  Parameters: pos
+//
+//  Member/Global Variables: cols, cell_start, cell_trees, centers, radii
+//
+//  Pre Conditions:  the grid must have been built
+//
+//  Post Conditions: will return true if pos is within any tree's
+//                   inflated radius
+//
+//  Calls:      cell_of, length
+//
+//******************************************************************
+bool TreeGrid::point_blocked(const vec2& pos) const {
+    if (centers.size() == 0) {
+        return false;
+    }
+
+    int col, row;
+    cell_of(pos, col, row);
+    int cell = row * cols + col;
+    for (GLuint i = cell_start[cell]; i < cell_start[cell + 1]; ++i) {
+        GLuint tree = cell_trees[i];
+        // if position is within the tree's radius, it is blocked
+        if (length(pos - centers[tree]) < radii[tree]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//******************************************************************
+//
+//  Function:   TreeGrid::segment_blocked
+//
+//  Purpose:    determines whether a tree blocks the segment from a to b
+//
+//  Parameters: a, b, tested
+//
+//  Member/Global Variables: cols, rows, cell_size, origin
+//
+//  Pre Conditions:  the grid must have been built
+//
+//  Post Conditions: will return true if a tree's inflated radius
+//                   overlaps the segment from a to b, or contains b; if
+//                   tested isn't null, the number of trees the segment
+//                   was tested against will have been added to it
+//
+//  Calls:      clip_segment, cell_of, cell_blocks_segment, length,
+//              std::abs
+//
+//******************************************************************
+bool TreeGrid::segment_blocked(const vec2& a, const vec2& b, GLuint* tested) const {
+    if (centers.size() == 0) {
+        return false;
+    }
+
+    vec2 dir = b - a;  // get displacement vector from b to a
+    float dist = length(dir);
+
+    // only the part of the segment inside the grid can touch a tree
+    float t0, t1;
+    if (!clip_segment(a, b, t0, t1)) {
+        return false;
+    }
+    vec2 start = a + dir * t0;
+    vec2 end = a + dir * t1;
+
+    // walk the cells crossed by the segment (Amanatides & Woo voxel traversal)
+    int col, row, end_col, end_row;
+    cell_of(start, col, row);
+    cell_of(end, end_col, end_row);
+
+    vec2 cell_start_pos = (start - origin) / cell_size;  // segment start in cell units
+    vec2 cell_dir = (end - start) / cell_size;  // segment direction in cell units
+    const float inf = std::numeric_limits<float>::infinity();
+
+    int step_col = (cell_dir.x > 0) ? 1 : ((cell_dir.x < 0) ? -1 : 0);
+    int step_row = (cell_dir.y > 0) ? 1 : ((cell_dir.y < 0) ? -1 : 0);
+    // parametric distance along the segment to the next column/row boundary, and between boundaries
+    float t_max_col = (step_col != 0) ? (col + (step_col > 0) - cell_start_pos.x) / cell_dir.x : inf;
+    float t_max_row = (step_row != 0) ? (row + (step_row > 0) - cell_start_pos.y) / cell_dir.y : inf;
+    float t_delta_col = (step_col != 0) ? std::abs(1 / cell_dir.x) : inf;
+    float t_delta_row = (step_row != 0) ? std::abs(1 / cell_dir.y) : inf;
+
+    // the walk moves one column or row per step toward the end cell, so it always reaches it
+    for (;;) {
+        int cell = row * cols + col;
+        if (tested != nullptr) {
+            *tested += pack_start[cell + 1] - pack_start[cell];
+        }
+        if (cell_blocks_segment(cell, a, b, dir, dist)) {
+            return true;
+        }
+        if (col == end_col && row == end_row) {
+            break;
+        }
+
+        // step across whichever boundary comes first, never stepping past the end cell
+        if (row == end_row || (col != end_col && t_max_col < t_max_row)) {
+            col += step_col;
+            t_max_col += t_delta_col;
+        } else {
+            row += step_row;
+            t_max_row += t_delta_row;
+        }
+    }
+
+    return false;
+}
+
+//******************************************************************
+//
+//  Function:   TreeGrid::cell_of
+//
+//  Purpose:    finds the cell containing the given position
+//
+//  Parameters: pos, col, row
+//
+//  Member/Global Variables: origin, cell_size, cols, rows
+//
+//  Pre Conditions:  the grid must have been built
+//
+//  Post Conditions: col and row will be set to the cell containing pos,
+//                   clamped to the grid
+//
+//  Calls:      std::floor, std::min, std::max
+//
+//******************************************************************
+void TreeGrid::cell_of(const vec2& pos, int& col, int& row) const {
+    vec2 local = (pos - origin) / cell_size;
+    col = std::min(std::max(static_cast<int>(std::floor(local.x)), 0), cols - 1);
+    row = std::min(std::max(static_cast<int>(std::floor(local.y)), 0), rows - 1);
+}
+
+//******************************************************************
+//
+//  Function:   TreeGrid::cell_blocks_segment
+//
+//  Purpose:    tests the segment from a to b against the trees in
+//              one cell
+//
+//  Parameters: cell, a, b, dir, dist
+//
+//  Member/Global Variables: pack_start, pack_xs, pack_ys, pack_r2s
+//
+//  Pre Conditions:  cell must be a valid cell index, dir must equal
+//                   b - a and dist must equal length(dir)
+//
+//  Post Conditions: will return true if a tree in the cell overlaps
+//                   the segment or contains b
+//
+//  Calls:      segment_hits_circles
+//
+//******************************************************************
+bool TreeGrid::cell_blocks_segment(int cell, const vec2& a, const vec2& b, const vec2& dir, float dist) const {
+    GLuint start = pack_start[cell];
+    return segment_hits_circles(pack_xs.data() + start, pack_ys.data() + start, pack_r2s.data() + start,
+                                pack_start[cell + 1] - start, a, b, dir, dist);
+}
+
+//******************************************************************
+//
+//  Function:   TreeGrid::clip_segment
+//
+//  Purpose:    clips the segment from a to b to the grid bounds
+//              (Liang-Barsky clipping)
+//
+//  Parameters: a, b, t0, t1
+//
+//  Member/Global Variables: origin, extent
+//
+//  Pre Conditions:  the grid must have been built
+//
+//  Post Conditions: returns false if the segment misses the grid,
+//                   otherwise t0 and t1 will be set to the parametric
+//                   start and end of the segment inside the grid
+//
+//  Calls:      none
+//
+//******************************************************************
+bool TreeGrid::clip_segment(const vec2& a, const vec2& b, float& t0, float& t1) const {
+    vec2 dir = b - a;
+    float p[4] = { -dir.x, dir.x, -dir.y, dir.y };
+    float q[4] = { a.x - origin.x, extent.x - a.x, a.y - origin.y, extent.y - a.y };
+
+    t0 = 0;
+    t1 = 1;
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0) {
+            if (q[i] < 0) {
+                return false;  // parallel to this edge and outside of it
+            }
+        } else {
+            float t = q[i] / p[i];
+            if (p[i] < 0) {
+                t0 = std::max(t0, t);  // entering
+            } else {
+                t1 = std::min(t1, t);  // leaving
+            }
+        }
+    }
+
+    return t0 <= t1;
+}
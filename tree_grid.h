@@ -0,0 +1,96 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        tree_grid.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a static uniform grid over the
+//                 trees of a map, so that traversability and line of
+//                 sight checks only test the trees near the query
+//                 instead of every tree in the map.
+//
+//    Date:        10/8/2019
+//
+//*******************************************************************
+
+#ifndef TREE_GRID_H
+#define TREE_GRID_H
+
+// C/C++ Standard libraries
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "circle_store.h"
+
+//******************************************************************
+//
+//  Class: TreeGrid
+//
+//  Purpose:  To store the trees of a map in a uniform grid. Each tree
+//            is inflated by a clearance and stored in every cell its
+//            bounding box overlaps. Trees never move after a map is
+//            created, so the grid is built once per map.
+//
+//  Functions:
+//           Constructors
+//             TreeGrid() creates an empty grid
+//           mutators
+//             build(trees, clearance) rebuilds the grid from the given
+//                                     trees, inflating each by clearance
+//                                     (which may be negative to shrink them)
+//           helpers
+//             point_blocked(pos) returns true if pos is inside an
+//                                inflated tree
+//             segment_blocked(a, b, tested) returns true if a tree blocks
+//                                           the segment from a to b, adding
+//                                           the trees tested to tested if
+//                                           it isn't null
+//           private helpers
+//             cell_of(pos, col, row) finds the (clamped) cell containing pos
+//             cell_blocks_segment(cell, a, b, dir, dist) tests the segment
+//                                                        against one cell's trees
+//             clip_segment(a, b, t0, t1) clips the segment to the grid
+//                                        bounds
+//
+//******************************************************************
+
+class TreeGrid {
+ public:
+    TreeGrid() : origin(vec2()), extent(vec2()), cell_size(1), cols(0), rows(0) {}
+
+    // mutators
+    void build(const CircleStore& trees, float clearance);
+
+    // helpers
+    bool point_blocked(const vec2& pos) const;
+    bool segment_blocked(const vec2& a, const vec2& b, GLuint* tested = nullptr) const;
+ private:
+    vec2 origin;  // world position of the bottom left corner of the grid
+    vec2 extent;  // world position of the top right corner of the grid
+    float cell_size;  // width and height of a cell
+    int cols;  // number of columns of cells
+    int rows;  // number of rows of cells
+
+    std::vector<GLuint> cell_start;  // index into cell_trees where each cell's trees begin (cols * rows + 1 entries)
+    std::vector<GLuint> cell_trees;  // tree indices, grouped by cell
+    std::vector<vec2> centers;  // tree centers
+    std::vector<float> radii;  // tree radii, inflated by the clearance
+
+    // each cell's trees again, packed for the reach kernel and padded to whole kernel steps
+    std::vector<GLuint> pack_start;  // index into the pack arrays where each cell's trees begin (cols * rows + 1 entries)
+    std::vector<float> pack_xs;  // tree center x coordinates
+    std::vector<float> pack_ys;  // tree center y coordinates
+    std::vector<float> pack_r2s;  // inflated tree radii, squared
+
+    // private helpers
+    void cell_of(const vec2& pos, int& col, int& row) const;
+    bool cell_blocks_segment(int cell, const vec2& a, const vec2& b, const vec2& dir, float dist) const;
+    bool clip_segment(const vec2& a, const vec2& b, float& t0, float& t1) const;
+};
+
+#endif
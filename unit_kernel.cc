@@ -0,0 +1,776 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        unit_kernel.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These functions update the movement and rotation of
+//                 a batch of units stored one array per property,
+//                 several units at a time using SIMD instructions when
+//                 the processor has them, with fast approximations of
+//                 atan2 and angle_difference.
+//
+//    Date:        10/13/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+
+// Source libraries
+#include "unit_kernel.h"
+#include "utilities.h"
+
+// SIMD versions are only built for x86 compilers that let single functions
+// target newer instruction sets than the rest of the program
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define UNIT_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+// Angle constants, rounded to floats once so every version of the kernel uses the same ones
+const float PI_F = E_PI;  // pi
+const float HALF_PI_F = E_PI / 2;  // pi / 2
+const float TWO_PI_F = E_PI * 2;  // 2 * pi
+const float INV_TWO_PI_F = 1 / (E_PI * 2);  // 1 / (2 * pi)
+
+// Smallest boost duration, and largest distance from the target, that counts as nonzero
+// (the float just above the 1e-3 the exact update compares against as a double)
+const float UNIT_EPSILON = 1e-3f;
+
+// Odd polynomial approximating atan(t) for t in [0, 1]: t * (c0 + c1 t^2 + c2 t^4 + ...)
+struct AtanApproximation {
+    float max_error;  // most the approximation (evaluated in floats, with the quadrant fix ups) is off by
+    GLuint num_coeffs;  // number of coefficients used
+    float coeffs[6];  // coefficients, lowest power first
+};
+
+// Approximations from cheapest to most accurate (errors measured over [0, 1], plus rounding)
+const AtanApproximation ATAN_APPROXIMATIONS[] = {
+    { 5e-3, 2, { 0.97239411, -0.19194795 } },
+    { 7e-4, 3, { 0.995354, -0.288679, 0.079331 } },
+    { 2e-5, 5, { 0.9998660, -0.3302995, 0.1801410, -0.0851330, 0.0208351 } },
+    { 3e-6, 6, { 0.99997726, -0.33262347, 0.19354346, -0.11643287, 0.05265332, -0.01172120 } }
+};
+const GLuint NUM_ATAN_APPROXIMATIONS = sizeof(ATAN_APPROXIMATIONS) / sizeof(ATAN_APPROXIMATIONS[0]);
+
+// Signature shared by every version of the approximate kernel
+typedef void (*UnitKernel)(const UnitArrays& units, GLuint begin, GLuint end, float dt,
+                           const AtanApproximation& approx, float sleep_turn);
+
+//******************************************************************
+//
+//  Function:   find_approximation
+//
+//  Purpose:    picks the cheapest atan approximation within tolerance
+//
+//  Parameters: tolerance
+//
+//  Member/Global Variables: ATAN_APPROXIMATIONS, NUM_ATAN_APPROXIMATIONS
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the cheapest approximation whose error is at
+//                   most tolerance, or nullptr if none of them is
+//
+//  Calls:      none
+//
+//******************************************************************
+static const AtanApproximation* find_approximation(float tolerance) {
+    for (GLuint k = 0; k < NUM_ATAN_APPROXIMATIONS; ++k) {
+        if (ATAN_APPROXIMATIONS[k].max_error <= tolerance) {
+            return &ATAN_APPROXIMATIONS[k];
+        }
+    }
+    return nullptr;
+}
+
+//******************************************************************
+//
+//  Function:   approx_atan2
+//
+//  Purpose:    approximates std::atan2(y, x) with a polynomial
+//
+//  Parameters: y, x, approx
+//
+//  Member/Global Variables: HALF_PI_F, PI_F
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns an angle within approx.max_error of
+//                   std::atan2(y, x) (or of the same angle plus or
+//                   minus 2 pi), doing exactly the operations each lane
+//                   of the SIMD versions does
+//
+//  Calls:      std::fabs, std::max, std::min
+//
+//******************************************************************
+static inline float approx_atan2(float y, float x, const AtanApproximation& approx) {
+    // fold the angle into [0, pi / 4], where the polynomial is accurate
+    float ax = std::fabs(x);
+    float ay = std::fabs(y);
+    float hi = std::max(ax, ay);
+    float lo = std::min(ax, ay);
+    float t = hi > 0 ? lo / hi : 0;
+
+    float t2 = t * t;
+    float poly = approx.coeffs[approx.num_coeffs - 1];
+    for (GLuint k = approx.num_coeffs - 1; k > 0; --k) {
+        poly = poly * t2 + approx.coeffs[k - 1];
+    }
+    float angle = poly * t;
+
+    // then unfold it back into its octant
+    if (ay > ax) {
+        angle = HALF_PI_F - angle;
+    }
+    if (x < 0) {
+        angle = PI_F - angle;
+    }
+    if (y < 0) {
+        angle = -angle;
+    }
+    return angle;
+}
+
+//******************************************************************
+//
+//  Function:   fast_angle_difference
+//
+//  Purpose:    returns angle b minus angle a, as the smallest angle
+//              possible, without std::fmod
+//
+//  Parameters: a, b
+//
+//  Member/Global Variables: PI_F, TWO_PI_F, INV_TWO_PI_F
+//
+//  Pre Conditions:  b - a must be well within the range of an int times
+//                   2 pi
+//
+//  Post Conditions: returns the same angle as angle_difference, to
+//                   within a few float roundings of b - a, doing exactly
+//                   the operations each lane of the SIMD versions does
+//
+//  Calls:      std::floor
+//
+//******************************************************************
+float fast_angle_difference(float a, float b) {
+    float dif = b - a;
+    return dif - TWO_PI_F * std::floor((dif + PI_F) * INV_TWO_PI_F);
+}
+
+//******************************************************************
+//
+//  Function:   fast_atan2
+//
+//  Purpose:    approximates std::atan2(y, x) within a tolerance
+//
+//  Parameters: y, x, tolerance
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns an angle within unit_kernel_error(tolerance)
+//                   of std::atan2(y, x) (or of the same angle plus or
+//                   minus 2 pi), and exactly std::atan2(y, x) if no
+//                   approximation is within tolerance
+//
+//  Calls:      find_approximation, approx_atan2, std::atan2
+//
+//******************************************************************
+float fast_atan2(float y, float x, float tolerance) {
+    const AtanApproximation* approx = find_approximation(tolerance);
+    if (approx == nullptr) {
+        return std::atan2(y, x);
+    }
+    return approx_atan2(y, x, *approx);
+}
+
+//******************************************************************
+//
+//  Function:   unit_kernel_error
+//
+//  Purpose:    returns the most a target angle of update_units can be
+//              off by
+//
+//  Parameters: tolerance
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the error of the approximation used for
+//                   tolerance (at most tolerance), or 0 if the exact
+//                   functions are used; units are let to rest the rest
+//                   of the tolerance away from their target angles
+//
+//  Calls:      find_approximation
+//
+//******************************************************************
+float unit_kernel_error(float tolerance) {
+    const AtanApproximation* approx = find_approximation(tolerance);
+    return approx == nullptr ? 0 : approx->max_error;
+}
+
+//******************************************************************
+//
+//  Function:   update_units_scalar
+//
+//  Purpose:    updates the position, rotation, and boost of a range of
+//              units exactly, one unit at a time
+//
+//  Parameters: units, begin, end, dt, sleep_turn
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  the arrays of units must hold at least end units,
+//                   and dt must be a valid value
+//
+//  Post Conditions: units begin to end - 1 are updated based on dt, and
+//                   their old positions and rotations are kept for
+//                   drawing (units only touch their own elements, so
+//                   disjoint ranges can be updated at the same time);
+//                   a unit is marked asleep if it was already at its
+//                   target, has no boost left, and is within sleep_turn
+//                   of facing its target, so updating it any more could
+//                   only turn it by that much
+//
+//  Calls:      std::max, float_equal, std::atan2, dot, normalize,
+//              angle_difference, std::min, std::fabs
+//
+//******************************************************************
+void update_units_scalar(const UnitArrays& units, GLuint begin, GLuint end, float dt, float sleep_turn) {
+    for (GLuint i = begin; i < end; ++i) {
+        // keep where the unit was, so drawing can blend between updates
+        units.prev_positions[i] = units.positions[i];
+        units.prev_rotations[i] = units.rotations[i];
+
+        float unit_dt = dt;
+        if (units.boost_durations[i] > 1e-3) {
+            units.boost_durations[i] = std::max(units.boost_durations[i] - unit_dt, 0.0f);  // decrease boost duration by dt and clamp to positive values
+        }
+
+        if (units.boost_durations[i] > 1e-3) {
+            unit_dt *= units.boost_factors[i];  // multiply dt by boost factor if boost duration is greater than 0
+        }
+
+        // (target food never moves, so target_positions already holds its position)
+        bool moving = !float_equal(units.positions[i].x, units.target_positions[i].x)
+                      || !float_equal(units.positions[i].y, units.target_positions[i].y);
+        if (moving) {
+            vec2 dir = units.target_positions[i] - units.positions[i];
+            float movement = unit_dt * units.speeds[i];
+            units.target_rotations[i] = std::atan2(dir.y, dir.x);  // angle unit towards target
+            // avoid expensive square root
+            if (dot(dir, dir) <= movement*movement) {
+                units.positions[i] = units.target_positions[i];
+            } else {
+                units.positions[i] += normalize(dir) * movement;
+            }
+        }
+        units.rotations[i] += angle_difference(units.rotations[i], units.target_rotations[i])
+                              * std::min(unit_dt * 2, 1.0f);
+
+        units.asleep[i] = !moving && !(units.boost_durations[i] > 1e-3)
+                          && std::fabs(angle_difference(units.rotations[i], units.target_rotations[i])) <= sleep_turn;
+    }
+}
+
+//******************************************************************
+//
+//  Function:   update_units_approx
+//
+//  Purpose:    updates a range of units one unit at a time, with the
+//              approximate angle functions
+//
+//  Parameters: units, begin, end, dt, approx, sleep_turn
+//
+//  Member/Global Variables: UNIT_EPSILON
+//
+//  Pre Conditions:  same as update_units_scalar
+//
+//  Post Conditions: same as update_units_scalar, except that target
+//                   angles are within approx.max_error of its; this is also
+//                   exactly what each lane of the SIMD versions does, so
+//                   it finishes off the units left over from their last
+//                   full group
+//
+//  Calls:      std::fabs, std::max, std::sqrt, approx_atan2,
+//              fast_angle_difference, std::min
+//
+//******************************************************************
+static void update_units_approx(const UnitArrays& units, GLuint begin, GLuint end, float dt,
+                                const AtanApproximation& approx, float sleep_turn) {
+    for (GLuint i = begin; i < end; ++i) {
+        units.prev_positions[i] = units.positions[i];
+        units.prev_rotations[i] = units.rotations[i];
+
+        float unit_dt = dt;
+        if (units.boost_durations[i] >= UNIT_EPSILON) {
+            units.boost_durations[i] = std::max(units.boost_durations[i] - unit_dt, 0.0f);
+        }
+        if (units.boost_durations[i] >= UNIT_EPSILON) {
+            unit_dt *= units.boost_factors[i];
+        }
+
+        float dx = units.target_positions[i].x - units.positions[i].x;
+        float dy = units.target_positions[i].y - units.positions[i].y;
+        bool moving = std::fabs(dx) >= UNIT_EPSILON || std::fabs(dy) >= UNIT_EPSILON;
+        if (moving) {
+            float movement = unit_dt * units.speeds[i];
+            units.target_rotations[i] = approx_atan2(dy, dx, approx);
+            float dist2 = dx * dx + dy * dy;
+            if (dist2 <= movement * movement) {
+                units.positions[i] = units.target_positions[i];
+            } else {
+                float inv_dist = 1.0f / std::sqrt(dist2);
+                units.positions[i].x += dx * inv_dist * movement;
+                units.positions[i].y += dy * inv_dist * movement;
+            }
+        }
+        units.rotations[i] += fast_angle_difference(units.rotations[i], units.target_rotations[i])
+                              * std::min(unit_dt * 2, 1.0f);
+
+        units.asleep[i] = !moving && units.boost_durations[i] < UNIT_EPSILON
+                          && std::fabs(fast_angle_difference(units.rotations[i], units.target_rotations[i])) <= sleep_turn;
+    }
+}
+
+#ifdef UNIT_KERNEL_X86
+//******************************************************************
+//
+//  Function:   atan2_sse2
+//
+//  Purpose:    approximates atan2 of four pairs of values at once
+//
+//  Parameters: y, x, approx
+//
+//  Member/Global Variables: HALF_PI_F, PI_F
+//
+//  Pre Conditions:  the processor must support SSE2
+//
+//  Post Conditions: returns exactly what approx_atan2 would for each
+//                   lane
+//
+//  Calls:      SSE intrinsics
+//
+//******************************************************************
+__attribute__((target("sse2")))
+static inline __m128 atan2_sse2(__m128 y, __m128 x, const AtanApproximation& approx) {
+    __m128 zero = _mm_setzero_ps();
+    __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    __m128 ax = _mm_and_ps(x, abs_mask);
+    __m128 ay = _mm_and_ps(y, abs_mask);
+    __m128 hi = _mm_max_ps(ax, ay);
+    __m128 lo = _mm_min_ps(ax, ay);
+    __m128 t = _mm_and_ps(_mm_cmpgt_ps(hi, zero), _mm_div_ps(lo, hi));  // 0 / 0 is masked out
+
+    __m128 t2 = _mm_mul_ps(t, t);
+    __m128 poly = _mm_set1_ps(approx.coeffs[approx.num_coeffs - 1]);
+    for (GLuint k = approx.num_coeffs - 1; k > 0; --k) {
+        poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(approx.coeffs[k - 1]));
+    }
+    __m128 angle = _mm_mul_ps(poly, t);
+
+    __m128 steep = _mm_cmpgt_ps(ay, ax);
+    angle = _mm_or_ps(_mm_and_ps(steep, _mm_sub_ps(_mm_set1_ps(HALF_PI_F), angle)), _mm_andnot_ps(steep, angle));
+    __m128 left = _mm_cmplt_ps(x, zero);
+    angle = _mm_or_ps(_mm_and_ps(left, _mm_sub_ps(_mm_set1_ps(PI_F), angle)), _mm_andnot_ps(left, angle));
+    __m128 down = _mm_cmplt_ps(y, zero);
+    return _mm_or_ps(_mm_and_ps(down, _mm_sub_ps(zero, angle)), _mm_andnot_ps(down, angle));
+}
+
+//******************************************************************
+//
+//  Function:   angle_difference_sse2
+//
+//  Purpose:    calculates four angle differences at once
+//
+//  Parameters: a, b
+//
+//  Member/Global Variables: PI_F, TWO_PI_F, INV_TWO_PI_F
+//
+//  Pre Conditions:  same as fast_angle_difference, and the processor
+//                   must support SSE2
+//
+//  Post Conditions: returns exactly what fast_angle_difference would for
+//                   each lane
+//
+//  Calls:      SSE intrinsics
+//
+//******************************************************************
+__attribute__((target("sse2")))
+static inline __m128 angle_difference_sse2(__m128 a, __m128 b) {
+    __m128 dif = _mm_sub_ps(b, a);
+    __m128 turns = _mm_mul_ps(_mm_add_ps(dif, _mm_set1_ps(PI_F)), _mm_set1_ps(INV_TWO_PI_F));
+
+    // SSE2 can't round down, so truncate and step back one where that rounded up
+    __m128 whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(turns));
+    whole = _mm_sub_ps(whole, _mm_and_ps(_mm_cmpgt_ps(whole, turns), _mm_set1_ps(1)));
+    return _mm_sub_ps(dif, _mm_mul_ps(_mm_set1_ps(TWO_PI_F), whole));
+}
+
+//******************************************************************
+//
+//  Function:   update_units_sse2
+//
+//  Purpose:    updates a range of units four units at a time
+//
+//  Parameters: units, begin, end, dt, approx, sleep_turn
+//
+//  Member/Global Variables: UNIT_EPSILON
+//
+//  Pre Conditions:  same as update_units_scalar, and the processor must
+//                   support SSE2
+//
+//  Post Conditions: does exactly what update_units_approx would (every
+//                   lane does the same operations in the same order)
+//
+//  Calls:      SSE intrinsics, atan2_sse2, angle_difference_sse2,
+//              update_units_approx
+//
+//******************************************************************
+__attribute__((target("sse2")))
+static void update_units_sse2(const UnitArrays& units, GLuint begin, GLuint end, float dt,
+                              const AtanApproximation& approx, float sleep_turn) {
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1);
+    __m128 two = _mm_set1_ps(2);
+    __m128 epsilon = _mm_set1_ps(UNIT_EPSILON);
+    __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 step = _mm_set1_ps(dt);
+    __m128 rest = _mm_set1_ps(sleep_turn);
+
+    GLuint i = begin;
+    for (; i + 4 <= end; i += 4) {
+        // positions are (x, y) pairs, so split four of them into their x's and y's
+        float* pos = &units.positions[i].x;
+        const float* target = &units.target_positions[i].x;
+        __m128 pos_lo = _mm_loadu_ps(pos);
+        __m128 pos_hi = _mm_loadu_ps(pos + 4);
+        _mm_storeu_ps(&units.prev_positions[i].x, pos_lo);
+        _mm_storeu_ps(&units.prev_positions[i].x + 4, pos_hi);
+        __m128 px = _mm_shuffle_ps(pos_lo, pos_hi, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 py = _mm_shuffle_ps(pos_lo, pos_hi, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 target_lo = _mm_loadu_ps(target);
+        __m128 target_hi = _mm_loadu_ps(target + 4);
+        __m128 tx = _mm_shuffle_ps(target_lo, target_hi, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 ty = _mm_shuffle_ps(target_lo, target_hi, _MM_SHUFFLE(3, 1, 3, 1));
+
+        __m128 rot = _mm_loadu_ps(units.rotations + i);
+        _mm_storeu_ps(units.prev_rotations + i, rot);
+
+        // run the boost down, then speed up the units still boosted
+        __m128 boost = _mm_loadu_ps(units.boost_durations + i);
+        __m128 boosted = _mm_cmpge_ps(boost, epsilon);
+        boost = _mm_or_ps(_mm_and_ps(boosted, _mm_max_ps(_mm_sub_ps(boost, step), zero)), _mm_andnot_ps(boosted, boost));
+        _mm_storeu_ps(units.boost_durations + i, boost);
+        boosted = _mm_cmpge_ps(boost, epsilon);
+        __m128 unit_dt = _mm_or_ps(_mm_and_ps(boosted, _mm_mul_ps(step, _mm_loadu_ps(units.boost_factors + i))),
+                                   _mm_andnot_ps(boosted, step));
+
+        // move the units that aren't at their targets, stopping on the target if it's close enough
+        __m128 dx = _mm_sub_ps(tx, px);
+        __m128 dy = _mm_sub_ps(ty, py);
+        __m128 moving = _mm_or_ps(_mm_cmpge_ps(_mm_and_ps(dx, abs_mask), epsilon),
+                                  _mm_cmpge_ps(_mm_and_ps(dy, abs_mask), epsilon));
+        __m128 movement = _mm_mul_ps(unit_dt, _mm_loadu_ps(units.speeds + i));
+        __m128 dist2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 arrives = _mm_cmple_ps(dist2, _mm_mul_ps(movement, movement));
+        __m128 inv_dist = _mm_div_ps(one, _mm_sqrt_ps(dist2));
+        __m128 step_x = _mm_add_ps(px, _mm_mul_ps(_mm_mul_ps(dx, inv_dist), movement));
+        __m128 step_y = _mm_add_ps(py, _mm_mul_ps(_mm_mul_ps(dy, inv_dist), movement));
+        __m128 new_x = _mm_or_ps(_mm_and_ps(arrives, tx), _mm_andnot_ps(arrives, step_x));
+        __m128 new_y = _mm_or_ps(_mm_and_ps(arrives, ty), _mm_andnot_ps(arrives, step_y));
+        px = _mm_or_ps(_mm_and_ps(moving, new_x), _mm_andnot_ps(moving, px));
+        py = _mm_or_ps(_mm_and_ps(moving, new_y), _mm_andnot_ps(moving, py));
+        _mm_storeu_ps(pos, _mm_unpacklo_ps(px, py));
+        _mm_storeu_ps(pos + 4, _mm_unpackhi_ps(px, py));
+
+        // face the target, and ease towards facing it
+        __m128 target_rot = _mm_or_ps(_mm_and_ps(moving, atan2_sse2(dy, dx, approx)),
+                                      _mm_andnot_ps(moving, _mm_loadu_ps(units.target_rotations + i)));
+        _mm_storeu_ps(units.target_rotations + i, target_rot);
+        __m128 ease = _mm_min_ps(_mm_mul_ps(unit_dt, two), one);
+        rot = _mm_add_ps(rot, _mm_mul_ps(angle_difference_sse2(rot, target_rot), ease));
+        _mm_storeu_ps(units.rotations + i, rot);
+
+        // units that were already there, unboosted, and (nearly) facing their targets are at rest
+        __m128 turned = _mm_cmple_ps(_mm_and_ps(angle_difference_sse2(rot, target_rot), abs_mask), rest);
+        __m128 at_rest = _mm_andnot_ps(moving, _mm_and_ps(_mm_cmplt_ps(boost, epsilon), turned));
+        int rest_bits = _mm_movemask_ps(at_rest);
+        for (GLuint k = 0; k < 4; ++k) {
+            units.asleep[i + k] = (rest_bits >> k) & 1;
+        }
+    }
+
+    // units left over from the last full group of four
+    update_units_approx(units, i, end, dt, approx, sleep_turn);
+}
+
+//******************************************************************
+//
+//  Function:   atan2_avx
+//
+//  Purpose:    approximates atan2 of eight pairs of values at once
+//
+//  Parameters: y, x, approx
+//
+//  Member/Global Variables: HALF_PI_F, PI_F
+//
+//  Pre Conditions:  the processor must support AVX
+//
+//  Post Conditions: returns exactly what approx_atan2 would for each
+//                   lane
+//
+//  Calls:      AVX intrinsics
+//
+//******************************************************************
+__attribute__((target("avx")))
+static inline __m256 atan2_avx(__m256 y, __m256 x, const AtanApproximation& approx) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+    __m256 ax = _mm256_and_ps(x, abs_mask);
+    __m256 ay = _mm256_and_ps(y, abs_mask);
+    __m256 hi = _mm256_max_ps(ax, ay);
+    __m256 lo = _mm256_min_ps(ax, ay);
+    __m256 t = _mm256_and_ps(_mm256_cmp_ps(hi, zero, _CMP_GT_OQ), _mm256_div_ps(lo, hi));  // 0 / 0 is masked out
+
+    __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 poly = _mm256_set1_ps(approx.coeffs[approx.num_coeffs - 1]);
+    for (GLuint k = approx.num_coeffs - 1; k > 0; --k) {
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(approx.coeffs[k - 1]));
+    }
+    __m256 angle = _mm256_mul_ps(poly, t);
+
+    angle = _mm256_blendv_ps(angle, _mm256_sub_ps(_mm256_set1_ps(HALF_PI_F), angle), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+    angle = _mm256_blendv_ps(angle, _mm256_sub_ps(_mm256_set1_ps(PI_F), angle), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+    return _mm256_blendv_ps(angle, _mm256_sub_ps(zero, angle), _mm256_cmp_ps(y, zero, _CMP_LT_OQ));
+}
+
+//******************************************************************
+//
+//  Function:   angle_difference_avx
+//
+//  Purpose:    calculates eight angle differences at once
+//
+//  Parameters: a, b
+//
+//  Member/Global Variables: PI_F, TWO_PI_F, INV_TWO_PI_F
+//
+//  Pre Conditions:  same as fast_angle_difference, and the processor
+//                   must support AVX
+//
+//  Post Conditions: returns exactly what fast_angle_difference would for
+//                   each lane
+//
+//  Calls:      AVX intrinsics
+//
+//******************************************************************
+__attribute__((target("avx")))
+static inline __m256 angle_difference_avx(__m256 a, __m256 b) {
+    __m256 dif = _mm256_sub_ps(b, a);
+    __m256 turns = _mm256_mul_ps(_mm256_add_ps(dif, _mm256_set1_ps(PI_F)), _mm256_set1_ps(INV_TWO_PI_F));
+    return _mm256_sub_ps(dif, _mm256_mul_ps(_mm256_set1_ps(TWO_PI_F), _mm256_floor_ps(turns)));
+}
+
+//******************************************************************
+//
+//  Function:   update_units_avx
+//
+//  Purpose:    updates a range of units eight units at a time
+//
+//  Parameters: units, begin, end, dt, approx, sleep_turn
+//
+//  Member/Global Variables: UNIT_EPSILON
+//
+//  Pre Conditions:  same as update_units_scalar, and the processor must
+//                   support AVX
+//
+//  Post Conditions: does exactly what update_units_approx would (every
+//                   lane does the same operations in the same order)
+//
+//  Calls:      AVX intrinsics, atan2_avx, angle_difference_avx,
+//              update_units_approx
+//
+//******************************************************************
+__attribute__((target("avx")))
+static void update_units_avx(const UnitArrays& units, GLuint begin, GLuint end, float dt,
+                             const AtanApproximation& approx, float sleep_turn) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1);
+    __m256 two = _mm256_set1_ps(2);
+    __m256 epsilon = _mm256_set1_ps(UNIT_EPSILON);
+    __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 step = _mm256_set1_ps(dt);
+    __m256 rest = _mm256_set1_ps(sleep_turn);
+
+    GLuint i = begin;
+    for (; i + 8 <= end; i += 8) {
+        // positions are (x, y) pairs; pairing units 0-1 with 4-5 and 2-3 with 6-7 in each
+        // half lets one shuffle split them into their x's and y's in order
+        float* pos = &units.positions[i].x;
+        float* prev = &units.prev_positions[i].x;
+        const float* target = &units.target_positions[i].x;
+        _mm256_storeu_ps(prev, _mm256_loadu_ps(pos));
+        _mm256_storeu_ps(prev + 8, _mm256_loadu_ps(pos + 8));
+        __m256 pos_a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pos)), _mm_loadu_ps(pos + 8), 1);
+        __m256 pos_b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pos + 4)), _mm_loadu_ps(pos + 12), 1);
+        __m256 px = _mm256_shuffle_ps(pos_a, pos_b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 py = _mm256_shuffle_ps(pos_a, pos_b, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 target_a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(target)), _mm_loadu_ps(target + 8), 1);
+        __m256 target_b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(target + 4)), _mm_loadu_ps(target + 12), 1);
+        __m256 tx = _mm256_shuffle_ps(target_a, target_b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 ty = _mm256_shuffle_ps(target_a, target_b, _MM_SHUFFLE(3, 1, 3, 1));
+
+        __m256 rot = _mm256_loadu_ps(units.rotations + i);
+        _mm256_storeu_ps(units.prev_rotations + i, rot);
+
+        // run the boost down, then speed up the units still boosted
+        __m256 boost = _mm256_loadu_ps(units.boost_durations + i);
+        boost = _mm256_blendv_ps(boost, _mm256_max_ps(_mm256_sub_ps(boost, step), zero),
+                                 _mm256_cmp_ps(boost, epsilon, _CMP_GE_OQ));
+        _mm256_storeu_ps(units.boost_durations + i, boost);
+        __m256 unit_dt = _mm256_blendv_ps(step, _mm256_mul_ps(step, _mm256_loadu_ps(units.boost_factors + i)),
+                                          _mm256_cmp_ps(boost, epsilon, _CMP_GE_OQ));
+
+        // move the units that aren't at their targets, stopping on the target if it's close enough
+        __m256 dx = _mm256_sub_ps(tx, px);
+        __m256 dy = _mm256_sub_ps(ty, py);
+        __m256 moving = _mm256_or_ps(_mm256_cmp_ps(_mm256_and_ps(dx, abs_mask), epsilon, _CMP_GE_OQ),
+                                     _mm256_cmp_ps(_mm256_and_ps(dy, abs_mask), epsilon, _CMP_GE_OQ));
+        __m256 movement = _mm256_mul_ps(unit_dt, _mm256_loadu_ps(units.speeds + i));
+        __m256 dist2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 arrives = _mm256_cmp_ps(dist2, _mm256_mul_ps(movement, movement), _CMP_LE_OQ);
+        __m256 inv_dist = _mm256_div_ps(one, _mm256_sqrt_ps(dist2));
+        __m256 step_x = _mm256_add_ps(px, _mm256_mul_ps(_mm256_mul_ps(dx, inv_dist), movement));
+        __m256 step_y = _mm256_add_ps(py, _mm256_mul_ps(_mm256_mul_ps(dy, inv_dist), movement));
+        px = _mm256_blendv_ps(px, _mm256_blendv_ps(step_x, tx, arrives), moving);
+        py = _mm256_blendv_ps(py, _mm256_blendv_ps(step_y, ty, arrives), moving);
+        __m256 pos_lo = _mm256_unpacklo_ps(px, py);
+        __m256 pos_hi = _mm256_unpackhi_ps(px, py);
+        _mm_storeu_ps(pos, _mm256_castps256_ps128(pos_lo));
+        _mm_storeu_ps(pos + 4, _mm256_castps256_ps128(pos_hi));
+        _mm_storeu_ps(pos + 8, _mm256_extractf128_ps(pos_lo, 1));
+        _mm_storeu_ps(pos + 12, _mm256_extractf128_ps(pos_hi, 1));
+
+        // face the target, and ease towards facing it
+        __m256 target_rot = _mm256_blendv_ps(_mm256_loadu_ps(units.target_rotations + i), atan2_avx(dy, dx, approx), moving);
+        _mm256_storeu_ps(units.target_rotations + i, target_rot);
+        __m256 ease = _mm256_min_ps(_mm256_mul_ps(unit_dt, two), one);
+        rot = _mm256_add_ps(rot, _mm256_mul_ps(angle_difference_avx(rot, target_rot), ease));
+        _mm256_storeu_ps(units.rotations + i, rot);
+
+        // units that were already there, unboosted, and (nearly) facing their targets are at rest
+        __m256 turned = _mm256_cmp_ps(_mm256_and_ps(angle_difference_avx(rot, target_rot), abs_mask), rest, _CMP_LE_OQ);
+        __m256 at_rest = _mm256_andnot_ps(moving, _mm256_and_ps(_mm256_cmp_ps(boost, epsilon, _CMP_LT_OQ), turned));
+        int rest_bits = _mm256_movemask_ps(at_rest);
+        for (GLuint k = 0; k < 8; ++k) {
+            units.asleep[i + k] = (rest_bits >> k) & 1;
+        }
+    }
+
+    // units left over from the last full group of eight
+    update_units_approx(units, i, end, dt, approx, sleep_turn);
+}
+#endif
+
+//******************************************************************
+//
+//  Function:   choose_kernel
+//
+//  Purpose:    picks the widest version of the approximate kernel that
+//              the processor supports
+//
+//  Parameters: name
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the kernel to use, and sets name to the
+//                   name of its instruction set
+//
+//  Calls:      __builtin_cpu_supports
+//
+//******************************************************************
+static UnitKernel choose_kernel(const char*& name) {
+#ifdef UNIT_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) {
+        name = "avx";
+        return update_units_avx;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        name = "sse2";
+        return update_units_sse2;
+    }
+#endif
+    name = "scalar";
+    return update_units_approx;
+}
+
+// Kernel chosen for this processor (picked before main runs, so no thread can see it unset)
+static const char* kernel_name = nullptr;
+static const UnitKernel kernel = choose_kernel(kernel_name);
+
+//******************************************************************
+//
+//  Function:   update_units
+//
+//  Purpose:    updates the position, rotation, and boost of a range of
+//              units, with angles within a tolerance
+//
+//  Parameters: units, begin, end, dt, tolerance
+//
+//  Member/Global Variables: kernel
+//
+//  Pre Conditions:  same as update_units_scalar
+//
+//  Post Conditions: positions and boosts are exactly what
+//                   update_units_scalar would make them, and angles are
+//                   within tolerance of what it would make them if units
+//                   were never put to rest (target angles are within
+//                   unit_kernel_error(tolerance), and units come to rest
+//                   within the rest of the tolerance of them); the
+//                   result doesn't depend on how the units are split into
+//                   ranges, or on the processor
+//
+//  Calls:      find_approximation, update_units_scalar, kernel
+//
+//******************************************************************
+void update_units(const UnitArrays& units, GLuint begin, GLuint end, float dt, float tolerance) {
+    const AtanApproximation* approx = find_approximation(tolerance);
+    if (approx == nullptr) {
+        update_units_scalar(units, begin, end, dt, tolerance);
+        return;
+    }
+    kernel(units, begin, end, dt, *approx, tolerance - approx->max_error);
+}
+
+//******************************************************************
+//
+//  Function:   unit_kernel_name
+//
+//  Purpose:    returns the name of the instruction set the kernel uses
+//
+//  Parameters: none
+//
+//  Member/Global Variables: kernel_name
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns "avx", "sse2", or "scalar"
+//
+//  Calls:      none
+//
+//******************************************************************
+const char* unit_kernel_name() {
+    return kernel_name;
+}
@@ -0,0 +1,66 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        unit_kernel.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: These functions update the movement and rotation of
+//                 a batch of units stored one array per property,
+//                 several units at a time using SIMD instructions when
+//                 the processor has them, with fast approximations of
+//                 atan2 and angle_difference.
+//
+//    Date:        10/13/2019
+//
+//*******************************************************************
+
+#ifndef UNIT_KERNEL_H
+#define UNIT_KERNEL_H
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Angle tolerance that always uses std::atan2 and angle_difference (bit for bit the old update)
+const float UNIT_KERNEL_EXACT = 0;
+
+// Angle tolerance units start with (about 0.06 degrees, far below what can be seen)
+const float UNIT_KERNEL_DEFAULT_TOLERANCE = 1e-3;
+
+// The unit arrays a batch update reads and writes (each must hold every unit updated)
+struct UnitArrays {
+    vec2* positions;  // current position of each unit
+    vec2* prev_positions;  // position of each unit before the last update
+    const vec2* target_positions;  // position each unit is moving towards
+    float* rotations;  // current rotation of each unit
+    float* prev_rotations;  // rotation of each unit before the last update
+    float* target_rotations;  // rotation each unit is easing towards
+    const float* speeds;  // how far each unit can move per second
+    const float* boost_factors;  // speed multiplier while boosted
+    float* boost_durations;  // time left on each unit's boost
+    unsigned char* asleep;  // whether each unit came to rest on its last update
+};
+
+// Function to update units begin to end - 1, with every angle within tolerance radians of
+// the exact update's (positions and boosts always match it exactly), marking the units that
+// came to rest asleep
+void update_units(const UnitArrays& units, GLuint begin, GLuint end, float dt, float tolerance);
+
+// Function doing the exact update, one unit at a time with std::atan2 and angle_difference
+// (units within sleep_turn radians of facing their targets count as at rest)
+void update_units_scalar(const UnitArrays& units, GLuint begin, GLuint end, float dt, float sleep_turn);
+
+// Function to approximate std::atan2(y, x) within tolerance radians (exactly, if no approximation is close enough)
+float fast_atan2(float y, float x, float tolerance);
+
+// Function to calculate angle_difference(a, b) without std::fmod
+float fast_angle_difference(float a, float b);
+
+// Function to get the most a target angle of update_units can be off by for the given tolerance
+float unit_kernel_error(float tolerance);
+
+// Function to get the name of the instruction set the kernel uses on this processor
+const char* unit_kernel_name();
+
+#endif
@@ -0,0 +1,1031 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        unit_store.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class stores a group of units (chevron-type
+//                 shapes that move towards targets and collect food)
+//                 as a structure of arrays, so that updating every
+//                 unit streams linearly through memory.
+//
+//    Date:        10/3/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Source libraries
+#include "unit_store.h"
+#include "utilities.h"
+
+//******************************************************************
+//
+//  Function:   UnitStore::size
+//
+//  Purpose:    returns the number of units in the store
+//
+//  Parameters: none
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the number of units
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint UnitStore::size() const {
+    return positions.size();
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_id
+//
+//  Purpose:    returns the stable id of a unit
+//
+//  Parameters: i
+//
+//  Member/Global Variables: ids
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns the id of unit i
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint UnitStore::get_id(GLuint i) const {
+    return ids[i];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_position
+//
+//  Purpose:    returns the position of a unit
+//
+//  Parameters: i
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns the position of unit i
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 UnitStore::get_position(GLuint i) const {
+    return positions[i];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_positions
+//
+//  Purpose:    returns the positions of every unit
+//
+//  Parameters: none
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the positions array, indexed like the units
+//
+//  Calls:      none
+//
+//******************************************************************
+const std::vector<vec2>& UnitStore::get_positions() const {
+    return positions;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_prev_position
+//
+//  Purpose:    returns the position of a unit before its last update
+//
+//  Parameters: i
+//
+//  Member/Global Variables: prev_positions
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns the position unit i had before it last
+//                   moved (or its position, if it hasn't been updated
+//                   since it was placed)
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 UnitStore::get_prev_position(GLuint i) const {
+    return prev_positions[i];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_rotation
+//
+//  Purpose:    returns the rotation of a unit
+//
+//  Parameters: i
+//
+//  Member/Global Variables: rotations
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns the rotation of unit i
+//
+//  Calls:      none
+//
+//******************************************************************
+float UnitStore::get_rotation(GLuint i) const {
+    return rotations[i];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_rotations
+//
+//  Purpose:    returns the rotations of every unit
+//
+//  Parameters: none
+//
+//  Member/Global Variables: rotations
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the rotation of every unit, in index order
+//
+//  Calls:      none
+//
+//******************************************************************
+const std::vector<float>& UnitStore::get_rotations() const {
+    return rotations;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_drawn_position
+//
+//  Purpose:    returns the position of a unit between its last two
+//              updates
+//
+//  Parameters: i, alpha
+//
+//  Member/Global Variables: positions, prev_positions
+//
+//  Pre Conditions:  i must be a valid unit index, and alpha must be
+//                   between 0 and 1
+//
+//  Post Conditions: returns the position of unit i blended from its
+//                   previous position (alpha = 0) to its current
+//                   position (alpha = 1)
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 UnitStore::get_drawn_position(GLuint i, float alpha) const {
+    return prev_positions[i] + (positions[i] - prev_positions[i]) * alpha;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_drawn_rotation
+//
+//  Purpose:    returns the rotation of a unit between its last two
+//              updates
+//
+//  Parameters: i, alpha
+//
+//  Member/Global Variables: rotations, prev_rotations
+//
+//  Pre Conditions:  i must be a valid unit index, and alpha must be
+//                   between 0 and 1
+//
+//  Post Conditions: returns the rotation of unit i blended from its
+//                   previous rotation (alpha = 0) to its current
+//                   rotation (alpha = 1), turning the short way around
+//
+//  Calls:      angle_difference
+//
+//******************************************************************
+float UnitStore::get_drawn_rotation(GLuint i, float alpha) const {
+    return prev_rotations[i] + angle_difference(prev_rotations[i], rotations[i]) * alpha;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_size
+//
+//  Purpose:    returns the size of a unit
+//
+//  Parameters: i
+//
+//  Member/Global Variables: sizes
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns the width and height of unit i
+//
+//  Calls:      none
+//
+//******************************************************************
+float UnitStore::get_size(GLuint i) const {
+    return sizes[i];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_food
+//
+//  Purpose:    gets the amount of food a unit has gathered
+//
+//  Parameters: i
+//
+//  Member/Global Variables: foods
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns the food of unit i
+//
+//  Calls:      none
+//
+//******************************************************************
+float UnitStore::get_food(GLuint i) const {
+    return foods[i];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_target_food
+//
+//  Purpose:    gets the id of the food that a unit is targeting
+//
+//  Parameters: i
+//
+//  Member/Global Variables: target_foods
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns the targeted food id of unit i, or NO_ID
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint UnitStore::get_target_food(GLuint i) const {
+    return target_foods[i];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_target_position
+//
+//  Purpose:    gets the position that a unit is moving towards
+//
+//  Parameters: i
+//
+//  Member/Global Variables: target_positions
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns the target position of unit i (the position
+//                   of its target food, if it has one)
+//
+//  Calls:      none
+//
+//******************************************************************
+vec2 UnitStore::get_target_position(GLuint i) const {
+    return target_positions[i];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::get_angle_tolerance
+//
+//  Purpose:    returns how far the angles update computes may be off
+//
+//  Parameters: none
+//
+//  Member/Global Variables: angle_tolerance
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the value of angle_tolerance
+//
+//  Calls:      none
+//
+//******************************************************************
+float UnitStore::get_angle_tolerance() const {
+    return angle_tolerance;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::set_position
+//
+//  Purpose:    sets the position of a unit
+//
+//  Parameters: i, pos
+//
+//  Member/Global Variables: positions, prev_positions, target_positions,
+//                           asleep
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: sets position, previous position, and target
+//                   position of unit i to pos (so a moved unit isn't
+//                   drawn sliding across the world), and wakes it
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::set_position(GLuint i, const vec2& pos) {
+    target_positions[i] = pos;
+    positions[i] = pos;
+    prev_positions[i] = pos;
+    asleep[i] = 0;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::set_target_food
+//
+//  Purpose:    sets the target of a unit to the given food
+//
+//  Parameters: i, id, pos
+//
+//  Member/Global Variables: target_foods, target_positions, positions,
+//                           asleep
+//
+//  Pre Conditions:  i must be a valid unit index, and pos must be the
+//                   position of food id (food never moves, so the
+//                   position stays valid while the food exists)
+//
+//  Post Conditions: sets the target food and target position of unit i,
+//                   or makes it stop where it is if id is NO_ID, and
+//                   wakes it
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::set_target_food(GLuint i, GLuint id, const vec2& pos) {
+    asleep[i] = 0;
+    if (id != NO_ID) {
+        target_foods[i] = id;
+        target_positions[i] = pos;
+    } else {
+        target_foods[i] = NO_ID;
+        target_positions[i] = positions[i];
+    }
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::set_target_pos
+//
+//  Purpose:    sets the target of a unit to the given position
+//
+//  Parameters: i, pos
+//
+//  Member/Global Variables: target_foods, target_positions, asleep
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: sets the target position of unit i to pos, clears
+//                   its target food, and wakes it
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::set_target_pos(GLuint i, const vec2& pos) {
+    target_foods[i] = NO_ID;
+    target_positions[i] = pos;
+    asleep[i] = 0;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::steer
+//
+//  Purpose:    sets where a unit heads next on the way to its target
+//              food
+//
+//  Parameters: i, pos
+//
+//  Member/Global Variables: target_positions, asleep
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: sets the target position of unit i to pos, keeping
+//                   its target food; the unit is only woken if pos is
+//                   somewhere new, so a unit resting at its food stays
+//                   asleep
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::steer(GLuint i, const vec2& pos) {
+    if (target_positions[i].x != pos.x || target_positions[i].y != pos.y) {
+        target_positions[i] = pos;
+        asleep[i] = 0;
+    }
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::set_angle_tolerance
+//
+//  Purpose:    sets how far the angles update computes may be off
+//
+//  Parameters: tolerance
+//
+//  Member/Global Variables: angle_tolerance, asleep
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every unit will be woken (units at rest were only
+//                   close enough to facing their targets for the old
+//                   tolerance), and update will keep every unit's
+//                   rotation within
+//                   tolerance radians of the exact one (using faster
+//                   approximations the larger it is, and the exact
+//                   functions if it's UNIT_KERNEL_EXACT)
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::set_angle_tolerance(float tolerance) {
+    angle_tolerance = tolerance;
+    asleep.assign(asleep.size(), 0);
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::add
+//
+//  Purpose:    adds a unit to the store
+//
+//  Parameters: pos, rot, sz, max_f, spd, bst_factor
+//
+//  Member/Global Variables: all of the unit arrays, slots, free_ids
+//
+//  Pre Conditions:  all parameters must have valid values
+//
+//  Post Conditions: a unit standing at pos with no food, no target and
+//                   no boost will be appended, and its id returned
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint UnitStore::add(const vec2& pos, float rot, float sz, float max_f, float spd, float bst_factor) {
+    // reuse the id of a removed unit if there is one
+    GLuint id;
+    if (free_ids.size() > 0) {
+        id = free_ids.back();
+        free_ids.pop_back();
+    } else {
+        id = slots.size();
+        slots.push_back(NO_ID);
+    }
+    slots[id] = positions.size();
+
+    positions.push_back(pos);
+    prev_positions.push_back(pos);
+    target_positions.push_back(pos);
+    rotations.push_back(rot);
+    prev_rotations.push_back(rot);
+    target_rotations.push_back(0);  // units ease towards facing right until they first move
+    sizes.push_back(sz);
+    speeds.push_back(spd);
+    boost_factors.push_back(bst_factor);
+    boost_durations.push_back(0);
+    foods.push_back(0);
+    max_foods.push_back(max_f);
+    target_foods.push_back(NO_ID);
+    ids.push_back(id);
+    asleep.push_back(0);
+
+    return id;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::assign
+//
+//  Purpose:    replaces every unit with a batch of new units
+//
+//  Parameters: pos, rot, count, sz, max_f, spd, bst_factor
+//
+//  Member/Global Variables: all of the unit arrays, slots, free_ids
+//
+//  Pre Conditions:  pos and rot must each hold count values
+//
+//  Post Conditions: the store will hold count units with ids 0 to
+//                   count - 1, the same as adding each in turn to an
+//                   empty store; if enough room was reserved, nothing
+//                   is allocated
+//
+//  Calls:      std::iota
+//
+//******************************************************************
+void UnitStore::assign(const vec2* pos, const float* rot, GLuint count, float sz, float max_f, float spd,
+                       float bst_factor) {
+    positions.assign(pos, pos + count);
+    prev_positions.assign(pos, pos + count);
+    target_positions.assign(pos, pos + count);
+    rotations.assign(rot, rot + count);
+    prev_rotations.assign(rot, rot + count);
+    target_rotations.assign(count, 0);  // units ease towards facing right until they first move
+    sizes.assign(count, sz);
+    speeds.assign(count, spd);
+    boost_factors.assign(count, bst_factor);
+    boost_durations.assign(count, 0);
+    foods.assign(count, 0);
+    max_foods.assign(count, max_f);
+    target_foods.assign(count, NO_ID);
+    asleep.assign(count, 0);
+
+    // unit i gets id i, as it would if the units were added one by one
+    ids.resize(count);
+    slots.resize(count);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::iota(slots.begin(), slots.end(), 0);
+    free_ids.clear();
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::remove
+//
+//  Purpose:    removes a unit from the store
+//
+//  Parameters: i
+//
+//  Member/Global Variables: all of the unit arrays, slots, free_ids
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: unit i will be removed; order doesn't need to be
+//                   preserved, so the last unit is moved into index i
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::remove(GLuint i) {
+    GLuint last = positions.size() - 1;
+
+    slots[ids[i]] = NO_ID;
+    free_ids.push_back(ids[i]);
+    if (i != last) {
+        // move the last unit into the freed index
+        positions[i] = positions[last];
+        prev_positions[i] = prev_positions[last];
+        target_positions[i] = target_positions[last];
+        rotations[i] = rotations[last];
+        prev_rotations[i] = prev_rotations[last];
+        target_rotations[i] = target_rotations[last];
+        sizes[i] = sizes[last];
+        speeds[i] = speeds[last];
+        boost_factors[i] = boost_factors[last];
+        boost_durations[i] = boost_durations[last];
+        foods[i] = foods[last];
+        max_foods[i] = max_foods[last];
+        target_foods[i] = target_foods[last];
+        ids[i] = ids[last];
+        asleep[i] = asleep[last];
+        slots[ids[i]] = i;
+    }
+
+    positions.pop_back();
+    prev_positions.pop_back();
+    target_positions.pop_back();
+    rotations.pop_back();
+    prev_rotations.pop_back();
+    target_rotations.pop_back();
+    sizes.pop_back();
+    speeds.pop_back();
+    boost_factors.pop_back();
+    boost_durations.pop_back();
+    foods.pop_back();
+    max_foods.pop_back();
+    target_foods.pop_back();
+    ids.pop_back();
+    asleep.pop_back();
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::reserve
+//
+//  Purpose:    allocates room for a number of units up front
+//
+//  Parameters: count
+//
+//  Member/Global Variables: all of the unit arrays, slots, free_ids
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: adding and removing units will not allocate memory
+//                   while the store holds at most count units and no
+//                   more than count ids have been handed out
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::reserve(GLuint count) {
+    positions.reserve(count);
+    prev_positions.reserve(count);
+    target_positions.reserve(count);
+    rotations.reserve(count);
+    prev_rotations.reserve(count);
+    target_rotations.reserve(count);
+    sizes.reserve(count);
+    speeds.reserve(count);
+    boost_factors.reserve(count);
+    boost_durations.reserve(count);
+    foods.reserve(count);
+    max_foods.reserve(count);
+    target_foods.reserve(count);
+    ids.reserve(count);
+    asleep.reserve(count);
+    slots.reserve(count);
+    free_ids.reserve(count);
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::clear
+//
+//  Purpose:    removes every unit from the store
+//
+//  Parameters: none
+//
+//  Member/Global Variables: all of the unit arrays, slots, free_ids
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the store will be empty, and ids will start from 0;
+//                   the arrays keep their memory, so the store can be
+//                   refilled without allocating
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::clear() {
+    positions.clear();
+    prev_positions.clear();
+    target_positions.clear();
+    rotations.clear();
+    prev_rotations.clear();
+    target_rotations.clear();
+    sizes.clear();
+    speeds.clear();
+    boost_factors.clear();
+    boost_durations.clear();
+    foods.clear();
+    max_foods.clear();
+    target_foods.clear();
+    ids.clear();
+    asleep.clear();
+    slots.clear();
+    free_ids.clear();
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::save
+//
+//  Purpose:    writes every unit to a snapshot
+//
+//  Parameters: out
+//
+//  Member/Global Variables: all of the unit arrays, slots, free_ids
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every array of the store, ids included, will have
+//                   been appended to out in one copy each
+//
+//  Calls:      SnapshotWriter::write_array
+//
+//******************************************************************
+void UnitStore::save(SnapshotWriter& out) const {
+    out.write_array(positions);
+    out.write_array(prev_positions);
+    out.write_array(target_positions);
+    out.write_array(rotations);
+    out.write_array(prev_rotations);
+    out.write_array(target_rotations);
+    out.write_array(sizes);
+    out.write_array(speeds);
+    out.write_array(boost_factors);
+    out.write_array(boost_durations);
+    out.write_array(foods);
+    out.write_array(max_foods);
+    out.write_array(target_foods);
+    out.write_array(ids);
+    out.write_array(asleep);
+    out.write_array(slots);
+    out.write_array(free_ids);
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::restore
+//
+//  Purpose:    replaces every unit with the ones written to a snapshot
+//
+//  Parameters: in
+//
+//  Member/Global Variables: all of the unit arrays, slots, free_ids
+//
+//  Pre Conditions:  the next thing in the snapshot must be a store
+//                   written by save
+//
+//  Post Conditions: the store will be exactly as it was saved, ids
+//                   included, so ids saved elsewhere find the same units
+//                   again (the arrays only allocate if they have no room);
+//                   returns false if the snapshot ended or its arrays
+//                   don't all hold the same number of units, leaving
+//                   the store in no particular state
+//
+//  Calls:      SnapshotReader::read_array, SnapshotReader::is_ok
+//
+//******************************************************************
+bool UnitStore::restore(SnapshotReader& in) {
+    in.read_array(positions);
+    in.read_array(prev_positions);
+    in.read_array(target_positions);
+    in.read_array(rotations);
+    in.read_array(prev_rotations);
+    in.read_array(target_rotations);
+    in.read_array(sizes);
+    in.read_array(speeds);
+    in.read_array(boost_factors);
+    in.read_array(boost_durations);
+    in.read_array(foods);
+    in.read_array(max_foods);
+    in.read_array(target_foods);
+    in.read_array(ids);
+    in.read_array(asleep);
+    in.read_array(slots);
+    in.read_array(free_ids);
+
+    size_t count = positions.size();
+    return in.is_ok() && prev_positions.size() == count && target_positions.size() == count &&
+           rotations.size() == count && prev_rotations.size() == count && target_rotations.size() == count &&
+           sizes.size() == count && speeds.size() == count && boost_factors.size() == count &&
+           boost_durations.size() == count && foods.size() == count && max_foods.size() == count &&
+           target_foods.size() == count && ids.size() == count && asleep.size() == count;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::give_food
+//
+//  Purpose:    gives a unit an amount of food
+//
+//  Parameters: i, amnt
+//
+//  Member/Global Variables: foods, max_foods
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: tries to give unit i amnt food, and returns
+//                   the total amount actually given, after maxing
+//                   out at its max food
+//
+//  Calls:      none
+//
+//******************************************************************
+float UnitStore::give_food(GLuint i, float amnt) {
+    if ((foods[i] + amnt) > max_foods[i]) {
+        float taken = max_foods[i] - foods[i];
+        foods[i] = max_foods[i];
+        return taken;  // return amount that we took
+    } else {
+        foods[i] += amnt;
+        return amnt;  // return amount that we took
+    }
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::give_boost
+//
+//  Purpose:    gives a unit a speed boost
+//
+//  Parameters: i, duration
+//
+//  Member/Global Variables: boost_durations, asleep
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: the boost duration of unit i is set to duration, and
+//                   it is woken
+//
+//  Calls:      none
+//
+//******************************************************************
+void UnitStore::give_boost(GLuint i, float duration) {
+    boost_durations[i] = duration;
+    asleep[i] = 0;
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::update
+//
+//  Purpose:    updates every unit's position, rotation, and other
+//              properties based on the given delta time
+//
+//  Parameters: dt
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  dt must be a valid value
+//
+//  Post Conditions: every unit's position, rotation, and other
+//                   properties are updated based on dt, and their old
+//                   positions and rotations are kept for drawing
+//
+//  Calls:      update
+//
+//******************************************************************
+void UnitStore::update(float dt) {
+    update(0, positions.size(), dt);
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::update
+//
+//  Purpose:    updates the position, rotation, and other properties of
+//              a range of units based on the given delta time
+//
+//  Parameters: begin, end, dt
+//
+//  Member/Global Variables: positions, prev_positions, target_positions,
+//                           rotations, prev_rotations, target_rotations,
+//                           speeds, boost_factors, boost_durations,
+//                           asleep, angle_tolerance
+//
+//  Pre Conditions:  begin and end must be a valid range of unit indices,
+//                   and dt must be a valid value
+//
+//  Post Conditions: the awake units of begin to end - 1 are updated based
+//                   on dt, and their old positions and rotations are kept
+//                   for drawing (units only touch their own elements, so
+//                   disjoint ranges can be updated at the same time);
+//                   positions are exact, and rotations are within
+//                   angle_tolerance of exact; units that came to rest are
+//                   put to sleep, and skipped until they're given a new
+//                   target, position, or boost
+//
+//  Calls:      update_units
+//
+//******************************************************************
+void UnitStore::update(GLuint begin, GLuint end, float dt) {
+    UnitArrays units = {
+        positions.data(), prev_positions.data(), target_positions.data(),
+        rotations.data(), prev_rotations.data(), target_rotations.data(),
+        speeds.data(), boost_factors.data(), boost_durations.data(), asleep.data()
+    };
+
+    // a sleeping unit would stay exactly where it is, so only runs of awake units are updated
+    GLuint i = begin;
+    while (i < end) {
+        while (i < end && asleep[i]) {
+            i++;
+        }
+        GLuint run = i;
+        while (i < end && !asleep[i]) {
+            i++;
+        }
+        if (run < i) {
+            update_units(units, run, i, dt, angle_tolerance);
+        }
+    }
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::find
+//
+//  Purpose:    finds the index of the unit with the given id
+//
+//  Parameters: id
+//
+//  Member/Global Variables: slots
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the index of the unit with id, or NO_ID if
+//                   no unit has that id
+//
+//  Calls:      none
+//
+//******************************************************************
+GLuint UnitStore::find(GLuint id) const {
+    if (id >= slots.size()) {
+        return NO_ID;
+    }
+    return slots[id];
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::is_full
+//
+//  Purpose:    returns whether a unit is full of food or not
+//
+//  Parameters: i
+//
+//  Member/Global Variables: foods, max_foods
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns true if the unit's food equals its max food
+//
+//  Calls:      float_equal
+//
+//******************************************************************
+bool UnitStore::is_full(GLuint i) const {
+    return float_equal(foods[i], max_foods[i]);
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::is_at_target
+//
+//  Purpose:    returns whether a unit is at its target or not
+//
+//  Parameters: i
+//
+//  Member/Global Variables: positions, target_positions
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns true if the unit's position equals its
+//                   target position
+//
+//  Calls:      float_equal
+//
+//******************************************************************
+bool UnitStore::is_at_target(GLuint i) const {
+    return float_equal(positions[i].x, target_positions[i].x)
+        && float_equal(positions[i].y, target_positions[i].y);
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::is_at
+//
+//  Purpose:    returns whether a unit is at a position or not
+//
+//  Parameters: i, pos
+//
+//  Member/Global Variables: positions
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns true if the unit's position equals pos
+//
+//  Calls:      float_equal
+//
+//******************************************************************
+bool UnitStore::is_at(GLuint i, const vec2& pos) const {
+    return float_equal(positions[i].x, pos.x) && float_equal(positions[i].y, pos.y);
+}
+
+//******************************************************************
+//
+//  Function:   UnitStore::is_asleep
+//
+//  Purpose:    returns whether a unit is at rest, and skipped by update
+//
+//  Parameters: i
+//
+//  Member/Global Variables: asleep
+//
+//  Pre Conditions:  i must be a valid unit index
+//
+//  Post Conditions: returns true if unit i came to rest on its last
+//                   update and nothing has woken it since
+//
+//  Calls:      none
+//
+//******************************************************************
+bool UnitStore::is_asleep(GLuint i) const {
+    return asleep[i] != 0;
+}
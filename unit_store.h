@@ -0,0 +1,169 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        unit_store.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class stores a group of units (chevron-type
+//                 shapes that move towards targets and collect food)
+//                 as a structure of arrays, so that updating every
+//                 unit streams linearly through memory.
+//
+//    Date:        10/3/2019
+//
+//*******************************************************************
+
+#ifndef UNIT_STORE_H
+#define UNIT_STORE_H
+
+// C/C++ Standard libraries
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "snapshot.h"
+#include "unit_kernel.h"
+#include "utilities.h"
+
+//******************************************************************
+//
+//  Class: UnitStore
+//
+//  Purpose:  To provide contiguous storage for units, with one array
+//            per property. Units are addressed by index for iteration,
+//            and by a stable id that survives other units being removed.
+//            Units that have come to rest (at their target, unboosted,
+//            and facing their target) sleep, and are skipped by update
+//            until a new target, position, or boost wakes them.
+//
+//  Functions:
+//           Constructors
+//             UnitStore() creates an empty store
+//           getters
+//             size to return the number of units
+//             get_id(i) to return the stable id of unit i
+//             get_position(i) to return the position of unit i
+//             get_positions to return the positions of every unit
+//             get_prev_position(i) to return the position of unit i before
+//                                  its last update
+//             get_rotation(i) to return the rotation of unit i
+//             get_rotations to return the rotations of every unit
+//             get_drawn_position(i, alpha) to return the position of unit i
+//                                          blended between its last two
+//                                          updates
+//             get_drawn_rotation(i, alpha) to return the rotation of unit i
+//                                          blended between its last two
+//                                          updates
+//             get_size(i) to return the size of unit i
+//             get_food(i) to return the amount of food unit i has gathered
+//             get_target_food(i) to return the id of the food unit i targets
+//             get_target_position(i) to return the position unit i moves to
+//             get_angle_tolerance to return how far updated angles may be off
+//           setters
+//             set_position(i, pos) to set the position (and target) of unit i
+//             set_target_food(i, id, pos) to make unit i target food id at pos
+//             set_target_pos(i, pos) to make unit i move to pos
+//             steer(i, pos) to make unit i move to pos on the way to its
+//                           target food
+//             set_angle_tolerance(tolerance) to let updated angles be off by up
+//                                            to tolerance radians
+//           mutators
+//             add(pos, rot, sz, max_f, spd, bst_factor) adds a unit and
+//                                                       returns its id
+//             assign(pos, rot, count, sz, max_f,
+//                    spd, bst_factor)  replaces every unit with count units
+//                                      at the given positions and rotations,
+//                                      copying each array in one go
+//             remove(i) removes unit i by swapping the last unit into its place
+//             clear() removes every unit
+//             reserve(count) allocates room for count units up front
+//             save(out) writes every unit to a snapshot
+//             restore(in) replaces every unit with the ones in a snapshot
+//             give_food(i, amnt) to give food to unit i
+//             give_boost(i, duration) to give a boost in speed to unit i
+//             update(dt) to update every unit's movement and animations
+//             update(begin, end, dt) to update the movement and animations
+//                                    of units begin to end - 1
+//           helpers
+//             find(id) returns the index of the unit with id, or NO_ID
+//             is_full(i) returns true if unit i is full of food
+//             is_at_target(i) returns true if unit i is at its target
+//             is_at(i, pos) returns true if unit i is at pos
+//             is_asleep(i) returns true if unit i is at rest
+//
+//******************************************************************
+
+class UnitStore {
+ public:
+    UnitStore() : angle_tolerance(UNIT_KERNEL_DEFAULT_TOLERANCE) {}
+
+    // getters
+    GLuint size() const;
+    GLuint get_id(GLuint i) const;
+    vec2 get_position(GLuint i) const;
+    const std::vector<vec2>& get_positions() const;
+    vec2 get_prev_position(GLuint i) const;
+    float get_rotation(GLuint i) const;
+    const std::vector<float>& get_rotations() const;
+    vec2 get_drawn_position(GLuint i, float alpha) const;
+    float get_drawn_rotation(GLuint i, float alpha) const;
+    float get_size(GLuint i) const;
+    float get_food(GLuint i) const;
+    GLuint get_target_food(GLuint i) const;
+    vec2 get_target_position(GLuint i) const;
+    float get_angle_tolerance() const;
+
+    // setters
+    void set_position(GLuint i, const vec2& pos);
+    void set_target_food(GLuint i, GLuint id, const vec2& pos);
+    void set_target_pos(GLuint i, const vec2& pos);
+    void steer(GLuint i, const vec2& pos);
+    void set_angle_tolerance(float tolerance);
+
+    // mutators
+    GLuint add(const vec2& pos, float rot, float sz, float max_f, float spd, float bst_factor);
+    void assign(const vec2* pos, const float* rot, GLuint count, float sz, float max_f, float spd, float bst_factor);
+    void remove(GLuint i);
+    void clear();
+    void reserve(GLuint count);
+    void save(SnapshotWriter& out) const;
+    bool restore(SnapshotReader& in);
+    float give_food(GLuint i, float amnt);
+    void give_boost(GLuint i, float duration);
+    void update(float dt);
+    void update(GLuint begin, GLuint end, float dt);
+
+    // helpers
+    GLuint find(GLuint id) const;
+    bool is_full(GLuint i) const;
+    bool is_at_target(GLuint i) const;
+    bool is_at(GLuint i, const vec2& pos) const;
+    bool is_asleep(GLuint i) const;
+ private:
+    std::vector<vec2> positions;  // current position of each unit
+    std::vector<vec2> prev_positions;  // position of each unit before the last update
+    std::vector<vec2> target_positions;  // position each unit is moving towards
+    std::vector<float> rotations;  // current rotation of each unit
+    std::vector<float> prev_rotations;  // rotation of each unit before the last update
+    std::vector<float> target_rotations;  // rotation each unit is easing towards
+    std::vector<float> sizes;  // width and height of each unit
+    std::vector<float> speeds;  // how far each unit can move per second
+    std::vector<float> boost_factors;  // speed multiplier while boosted
+    std::vector<float> boost_durations;  // time left on each unit's boost
+    std::vector<float> foods;  // food each unit has gathered
+    std::vector<float> max_foods;  // food each unit needs to be full
+    std::vector<GLuint> target_foods;  // id of the food each unit targets (or NO_ID)
+    std::vector<GLuint> ids;  // stable id of each unit
+    std::vector<unsigned char> asleep;  // whether each unit is at rest (skipped by update)
+
+    std::vector<GLuint> slots;  // index of the unit with each id (or NO_ID)
+    std::vector<GLuint> free_ids;  // ids of removed units, ready for reuse
+
+    float angle_tolerance;  // most that update may let rotations be off by, in radians
+};
+
+#endif
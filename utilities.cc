@@ -15,62 +15,13 @@
 
 // C/C++ Standard libraries
 #include <cmath>
-#include <random>
 
 #define EPSILON 1e-3
+#define HASH_PRIME 1099511628211ULL  // FNV-1a 64 bit prime
 
 // Source libraries
 #include "utilities.h"
 
-// NOTE: cmpcolor code is written by Professor Chelberg
-//******************************************************************
-//
-//  Function:   cmpcolor
-//
-//  Purpose:    compares a 24-bit RGB color with a vec3 color
-//
-//  Parameters: colora, colorb
-//
-//  Member/Global Variables: none
-//
-//  Pre Conditions:  colora and colorb must have valid values
-//
-//  Post Conditions: returns true if colora matches colorb
-//
-//  Calls:      none
-//
-//******************************************************************
-bool cmpcolor(unsigned char colora[], vec3 colorb) {
-  return((colora[0]==int(colorb.x*255+0.5)) &&
-	 (colora[1]==int(colorb.y*255+0.5)) &&
-	 (colora[2]==int(colorb.z*255+0.5)));
-}
-
-//******************************************************************
-//
-//  Function:   generate_random
-//
-//  Purpose:    generates a random number in the range 0 to 1
-//
-//  Parameters: none
-//
-//  Member/Global Variables: none
-//
-//  Pre Conditions:  none
-//
-//  Post Conditions: returns a random number in the range 0 to 1
-//
-//  Calls:      none
-//
-//******************************************************************
-float generate_random() {
-    static std::default_random_engine generator;
-    static std::uniform_real_distribution<float> distribution(0.0, 1.0);
-
-    return distribution(generator);
-}
-
-// NOTE: Method to find angle difference is from https://stackoverflow.com/a/11498248
 //******************************************************************
 //
 //  Function:   angle_difference
@@ -121,3 +72,30 @@ float angle_difference(float a, float b) {
 bool float_equal(float a, float b) {
     return (std::fabs(a - b) < EPSILON);
 }
+
+//******************************************************************
+//
+//  Function:   hash_bytes
+//
+//  Purpose:    hashes bytes with FNV-1a
+//
+//  Parameters: bytes, count, hash
+//
+//  Member/Global Variables: HASH_PRIME
+//
+//  Pre Conditions:  bytes must hold count bytes
+//
+//  Post Conditions: returns the hash of the bytes, carrying on from hash
+//                   (so hashing two arrays in turn is the same as
+//                   hashing them joined together)
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t hash_bytes(const void* bytes, size_t count, uint64_t hash) {
+    const unsigned char* data = static_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < count; ++i) {
+        hash = (hash ^ data[i]) * HASH_PRIME;
+    }
+    return hash;
+}
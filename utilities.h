@@ -16,18 +16,18 @@
 #ifndef UTILITIES_H
 #define UTILITIES_H
 
+// C/C++ Standard libraries
+#include <cstddef>
+#include <cstdint>
+
 // Third Party libraries
 #include <Angel.h>
 
 // Definition of pi to many decimal places
 #define E_PI 3.1415926535897932384626433832795028841971693993751058209749445923078164062
 
-// NOTE: cmpcolor code is written by Professor Chelberg
-// Function to compare a 24 bit RGB color to a vec3 color
-bool cmpcolor(unsigned char colora[], vec3 colorb);
-
-// Function to generate a random number between 0 and 1
-float generate_random();
+// Value used for "no id" (no target food, or an id that isn't in a store)
+const GLuint NO_ID = 0xFFFFFFFF;
 
 // NOTE: Method to find angle difference is from https://stackoverflow.com/a/11498248
 // Function to calculate the smallest angle difference between two angle
@@ -36,4 +36,10 @@ float angle_difference(float a, float b);
 // Function to determine if two floats are equal
 bool float_equal(float a, float b);
 
+// Value every hash of bytes starts from (the FNV-1a offset basis)
+const uint64_t HASH_START = 14695981039346656037ULL;
+
+// Function to hash bytes with FNV-1a, carrying on from hash (to hash several arrays as one)
+uint64_t hash_bytes(const void* bytes, size_t count, uint64_t hash = HASH_START);
+
 #endif
\ No newline at end of file
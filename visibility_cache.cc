@@ -0,0 +1,265 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        visibility_cache.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a lazily filled table of whether
+//                 the trees of a map block every, none, or only some
+//                 of the segments between two small cells, so that most
+//                 line of sight checks never have to test any trees.
+//
+//    Date:        10/11/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+// Source libraries
+#include "visibility_cache.h"
+
+// coordinates in the world are a few thousand units at most, where the exact test's
+// rounding errors are far smaller than this
+const float VisibilityCache::MARGIN = 0.5;
+
+//******************************************************************
+//
+//  Function:   VisibilityCache::get_bytes
+//
+//  Purpose:    returns the memory the pair table takes
+//
+//  Parameters: none
+//
+//  Member/Global Variables: cols, pairs
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the bytes of the pair table, or 0 if the
+//                   cache isn't answering (cleared, or too big to build)
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t VisibilityCache::get_bytes() const {
+    return cols == 0 ? 0 : pairs.size();
+}
+
+//******************************************************************
+//
+//  Function:   VisibilityCache::build
+//
+//  Purpose:    forgets every pair and sets up the cells and grids for
+//              the given trees
+//
+//  Parameters: trees, clearance, low, high, size, range
+//
+//  Member/Global Variables: origin, cell_size, cols, rows, reach, span,
+//                           grown, shrunk, pairs, MARGIN, PAIRS_PER_ENTRY,
+//                           MAX_ENTRIES
+//
+//  Pre Conditions:  trees must hold the trees of the map, clearance must
+//                   be the clearance the exact test inflates them by,
+//                   and size must be greater than 0
+//
+//  Post Conditions: every pair of cells up to range apart in the box
+//                   from low to high will be unclassified, and will be
+//                   classified the first time it's looked up; if the
+//                   table would take more than MAX_ENTRIES bytes, the
+//                   cache is cleared instead (every lookup is unknown)
+//                   and the memory of any earlier table freed
+//
+//  Calls:      TreeGrid::build, clear, std::ceil, std::max, std::sqrt,
+//              std::atomic::store
+//
+//******************************************************************
+void VisibilityCache::build(const CircleStore& trees, float clearance, const vec2& low, const vec2& high,
+                            float size, float range) {
+    origin = low;
+    cell_size = size;
+    cols = std::max(1, static_cast<int>(std::ceil((high.x - low.x) / cell_size)));
+    rows = std::max(1, static_cast<int>(std::ceil((high.y - low.y) / cell_size)));
+    reach = static_cast<int>(std::ceil(range / cell_size)) + 1;  // points range apart can be one more cell apart
+    span = 2 * reach + 1;
+
+    uint64_t entries = (static_cast<uint64_t>(cols) * rows * span * span + PAIRS_PER_ENTRY - 1) / PAIRS_PER_ENTRY;
+    if (entries > MAX_ENTRIES) {
+        // a table this big would cost more memory than the exact tests it saves, and one kept
+        // from a smaller map would only hold memory no lookup uses
+        clear();
+        std::vector<std::atomic<unsigned char>>().swap(pairs);
+        return;
+    }
+
+    // every point of a cell is within half a diagonal of its center, so every segment between
+    // two cells is within half a diagonal of the segment between their centers
+    float half_diagonal = cell_size * std::sqrt(2.0f) / 2;
+    grown.build(trees, clearance + half_diagonal + MARGIN);
+    shrunk.build(trees, clearance - half_diagonal - MARGIN);
+
+    // atomics can't be moved, so only make a new table when the size changes
+    GLuint count = static_cast<GLuint>(entries);
+    if (pairs.size() != count) {
+        pairs = std::vector<std::atomic<unsigned char>>(count);
+    }
+    for (GLuint i = 0; i < count; ++i) {
+        pairs[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   VisibilityCache::clear
+//
+//  Purpose:    forgets every pair, so that every lookup is unknown
+//
+//  Parameters: none
+//
+//  Member/Global Variables: cols, rows
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the cache will have no cells, keeping its memory
+//                   for the next build
+//
+//  Calls:      none
+//
+//******************************************************************
+void VisibilityCache::clear() {
+    cols = 0;
+    rows = 0;
+}
+
+//******************************************************************
+//
+//  Function:   VisibilityCache::lookup
+//
+//  Purpose:    determines what the trees do to the segment from a to b
+//
+//  Parameters: a, b
+//
+//  Member/Global Variables: reach, span, cols, pairs, PAIRS_PER_ENTRY
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns VISIBILITY_CLEAR or VISIBILITY_BLOCKED if
+//                   the exact test is certain to say the same, or
+//                   VISIBILITY_UNKNOWN if it has to be run; the pair of
+//                   cells will have been classified if it wasn't yet
+//
+//  Calls:      cell_of, classify, std::abs, std::atomic::load,
+//              std::atomic::fetch_or
+//
+//******************************************************************
+Visibility VisibilityCache::lookup(const vec2& a, const vec2& b) const {
+    int a_col, a_row, b_col, b_row;
+    if (!cell_of(a, a_col, a_row) || !cell_of(b, b_col, b_row)) {
+        return VISIBILITY_UNKNOWN;
+    }
+    int d_col = b_col - a_col;
+    int d_row = b_row - a_row;
+    if (std::abs(d_col) > reach || std::abs(d_row) > reach) {
+        return VISIBILITY_UNKNOWN;  // further apart than any pair the cache is for
+    }
+
+    // each pair is 2 bits holding its visibility plus one, so 0 means it hasn't been classified
+    GLuint pair = (a_row * cols + a_col) * span * span + (d_row + reach) * span + (d_col + reach);
+    GLuint entry = pair / PAIRS_PER_ENTRY;
+    GLuint shift = (pair % PAIRS_PER_ENTRY) * 2;
+    GLuint known = (pairs[entry].load(std::memory_order_relaxed) >> shift) & 3;
+    if (known != 0) {
+        return static_cast<Visibility>(known - 1);
+    }
+
+    // two threads classifying the same pair at once both get the same answer, and or-ing it in
+    // can't disturb the other pairs sharing the entry
+    Visibility result = classify(a_col, a_row, b_col, b_row);
+    pairs[entry].fetch_or((result + 1) << shift, std::memory_order_relaxed);
+    return result;
+}
+
+//******************************************************************
+//
+//  Function:   VisibilityCache::cell_of
+//
+//  Purpose:    finds the cell containing the given position
+//
+//  Parameters: pos, col, row
+//
+//  Member/Global Variables: origin, cell_size, cols, rows
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: col and row will be set to the cell containing pos,
+//                   returning false if pos is outside of every cell
+//
+//  Calls:      std::floor
+//
+//******************************************************************
+bool VisibilityCache::cell_of(const vec2& pos, int& col, int& row) const {
+    vec2 local = (pos - origin) / cell_size;
+    if (!(local.x >= 0 && local.x < cols && local.y >= 0 && local.y < rows)) {  // also catches NaN
+        return false;
+    }
+    col = static_cast<int>(std::floor(local.x));
+    row = static_cast<int>(std::floor(local.y));
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   VisibilityCache::classify
+//
+//  Purpose:    works out what the trees do to every segment from the
+//              first cell to the second
+//
+//  Parameters: a_col, a_row, b_col, b_row
+//
+//  Member/Global Variables: origin, cell_size, grown, shrunk
+//
+//  Pre Conditions:  the cache must have been built and both cells must
+//                   be inside it
+//
+//  Post Conditions: returns VISIBILITY_CLEAR if no segment between the
+//                   cells can be blocked, VISIBILITY_BLOCKED if every
+//                   one is, or VISIBILITY_UNKNOWN otherwise
+//
+//  Calls:      TreeGrid::point_blocked, TreeGrid::segment_blocked
+//
+//******************************************************************
+Visibility VisibilityCache::classify(int a_col, int a_row, int b_col, int b_row) const {
+    vec2 a = origin + cell_size * vec2(a_col + 0.5, a_row + 0.5);
+    vec2 b = origin + cell_size * vec2(b_col + 0.5, b_row + 0.5);
+
+    // a shrunk tree containing b's center contains all of b's cell, so every segment ends inside of it
+    if (shrunk.point_blocked(b)) {
+        return VISIBILITY_BLOCKED;
+    }
+
+    // the exact test misses trees that the segment starts inside of and leaves, so the rest
+    // only holds if no point of a's cell is inside any tree
+    if (grown.point_blocked(a)) {
+        return VISIBILITY_UNKNOWN;
+    }
+    if (a_col == b_col && a_row == b_row) {
+        return VISIBILITY_CLEAR;
+    }
+
+    // no grown tree touching the segment between the centers means no tree touches any segment
+    if (!grown.segment_blocked(a, b)) {
+        return VISIBILITY_CLEAR;
+    }
+
+    // a shrunk tree touching the segment between the centers at some point contains the whole
+    // cell-sized square around that point, which every segment between the cells passes through
+    if (shrunk.segment_blocked(a, b)) {
+        return VISIBILITY_BLOCKED;
+    }
+
+    return VISIBILITY_UNKNOWN;
+}
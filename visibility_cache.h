@@ -0,0 +1,124 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        visibility_cache.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class provides a lazily filled table of whether
+//                 the trees of a map block every, none, or only some
+//                 of the segments between two small cells, so that most
+//                 line of sight checks never have to test any trees.
+//
+//    Date:        10/11/2019
+//
+//*******************************************************************
+
+#ifndef VISIBILITY_CACHE_H
+#define VISIBILITY_CACHE_H
+
+// C/C++ Standard libraries
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Source libraries
+#include "circle_store.h"
+#include "tree_grid.h"
+
+// What the trees do to the segments between two cells
+enum Visibility {
+    VISIBILITY_UNKNOWN = 0,  // some segments may be blocked and others not (or the pair isn't covered)
+    VISIBILITY_CLEAR = 1,  // no segment is blocked
+    VISIBILITY_BLOCKED = 2  // every segment is blocked
+};
+
+//******************************************************************
+//
+//  Class: VisibilityCache
+//
+//  Purpose:  To answer "does a tree block the segment from a to b" for
+//            pairs of points that are within range of each other,
+//            without testing any trees for most pairs. The world is cut
+//            into square cells and, the first time a pair of cells is
+//            asked about, the pair is classified once using two grids of
+//            the same trees: one grown by half a cell diagonal (if it
+//            doesn't block the segment between the cell centers, nothing
+//            blocks any segment between the cells) and one shrunk by it
+//            (if it blocks that segment, every segment between the cells
+//            passes deep inside a tree). Both are grown by a small margin
+//            so the answers always agree with the exact test. Pairs in
+//            between are answered UNKNOWN, and the caller falls back to
+//            the exact test. Entries are atomic, so the table can be
+//            filled in from several threads at once.
+//
+//  Functions:
+//           Constructors
+//             VisibilityCache() creates an empty cache that knows nothing
+//           getters
+//             get_bytes to return the memory the pair table takes (0 if the
+//                       cache isn't answering)
+//           mutators
+//             build(trees, clearance, low, high,
+//                   size, range)  forgets every pair and covers the box from
+//                                 low to high with cells of the given size,
+//                                 for trees inflated by clearance and pairs
+//                                 of points up to range apart (or stops
+//                                 answering and frees the table, if the
+//                                 box is too big)
+//             clear() forgets every pair and stops answering
+//           helpers
+//             lookup(a, b) returns what the trees do to the segment from a
+//                          to b, classifying its pair of cells if needed
+//           private helpers
+//             cell_of(pos, col, row) finds the cell containing pos, returning
+//                                    false if it's outside the cache
+//             classify(a_col, a_row, b_col, b_row) works out what the trees do
+//                                                  to a pair of cells
+//
+//******************************************************************
+
+class VisibilityCache {
+ public:
+    VisibilityCache() : origin(vec2()), cell_size(1), cols(0), rows(0), reach(0), span(0) {}
+
+    // getters
+    uint64_t get_bytes() const;
+
+    // mutators
+    void build(const CircleStore& trees, float clearance, const vec2& low, const vec2& high,
+               float size, float range);
+    void clear();
+
+    // helpers
+    Visibility lookup(const vec2& a, const vec2& b) const;
+ private:
+    vec2 origin;  // world position of the bottom left corner of the cells
+    float cell_size;  // width and height of a cell
+    int cols;  // number of columns of cells
+    int rows;  // number of rows of cells
+    int reach;  // largest column or row difference between cached pairs
+    int span;  // number of columns (and rows) of cells each cell has pairs with (2 * reach + 1)
+
+    TreeGrid grown;  // the trees grown by half a cell diagonal plus the margin
+    TreeGrid shrunk;  // the trees shrunk by half a cell diagonal plus the margin
+
+    // Visibility of each pair of cells, by the first cell and then the offset to the second,
+    // packed 2 bits to a pair (mutable since lookups fill it in)
+    mutable std::vector<std::atomic<unsigned char>> pairs;
+
+    // static member variables
+    static const float MARGIN;  // distance trees are grown by to cover rounding in the exact test
+    static const GLuint PAIRS_PER_ENTRY = 4;  // number of pairs packed into each byte of pairs
+    static const GLuint MAX_ENTRIES = 1 << 26;  // most bytes pairs may take (past it, the world is too big to cache)
+
+    // private helpers
+    bool cell_of(const vec2& pos, int& col, int& row) const;
+    Visibility classify(int a_col, int a_row, int b_col, int b_row) const;
+};
+
+#endif
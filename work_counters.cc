@@ -0,0 +1,364 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        work_counters.cc
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class counts the algorithmic work the game does
+//                 every tick (line of sight tests, trees tested, wander
+//                 targets tried, food drops considered, objects removed,
+//                 flow fields built, and draw calls and uniforms sent), so
+//                 a slowdown can be told apart as more work being done or
+//                 the same work being done slower. Counts can be read
+//                 after any tick and written to a text file every so many
+//                 ticks.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+// C/C++ Standard libraries
+#include <algorithm>
+#include <iostream>
+
+// Source libraries
+#include "work_counters.h"
+
+// The block the calling thread last counted into, and the counters it belongs to
+struct ThreadBlock {
+    uint64_t id;  // unique number of the counters (0 for none)
+    CounterBlock* block;  // the thread's block in them
+};
+static thread_local ThreadBlock thread_block = { 0, nullptr };
+
+std::atomic<uint64_t> WorkCounters::counters_made(0);
+
+//******************************************************************
+//
+//  Function:   WorkCounters::WorkCounters
+//
+//  Purpose:    creates counters that have counted nothing
+//
+//  Parameters: none
+//
+//  Member/Global Variables: blocks, id, counters_made, ticks,
+//                           last_tick, totals, interval_counts,
+//                           dump_interval
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every count will be 0, and nothing is dumped
+//
+//  Calls:      std::fill
+//
+//******************************************************************
+WorkCounters::WorkCounters()
+    : blocks(nullptr), id(++counters_made), ticks(0), dump_interval(DEFAULT_DUMP_TICKS) {
+    std::fill(last_tick, last_tick + NUM_COUNTERS, 0);
+    std::fill(totals, totals + NUM_COUNTERS, 0);
+    std::fill(interval_counts, interval_counts + NUM_COUNTERS, 0);
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::~WorkCounters
+//
+//  Purpose:    finishes the dump and frees every block
+//
+//  Parameters: none
+//
+//  Member/Global Variables: blocks
+//
+//  Pre Conditions:  no thread may be counting
+//
+//  Post Conditions: the dump will have been closed, if one was open,
+//                   and every block freed
+//
+//  Calls:      close
+//
+//******************************************************************
+WorkCounters::~WorkCounters() {
+    close();
+
+    CounterBlock* block = blocks.load();
+    while (block != nullptr) {
+        CounterBlock* next = block->next;
+        delete block;
+        block = next;
+    }
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::get_ticks
+//
+//  Purpose:    returns the number of ticks ended
+//
+//  Parameters: none
+//
+//  Member/Global Variables: ticks
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the number of times end_tick was called
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t WorkCounters::get_ticks() const {
+    return ticks;
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::get_last_tick
+//
+//  Purpose:    returns a counter's count in the last tick ended
+//
+//  Parameters: counter
+//
+//  Member/Global Variables: last_tick
+//
+//  Pre Conditions:  counter must be below NUM_COUNTERS
+//
+//  Post Conditions: returns the work counted, on every thread, between
+//                   the last two calls to end_tick
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t WorkCounters::get_last_tick(GLuint counter) const {
+    return last_tick[counter];
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::get_total
+//
+//  Purpose:    returns a counter's count over every tick ended
+//
+//  Parameters: counter
+//
+//  Member/Global Variables: totals
+//
+//  Pre Conditions:  counter must be below NUM_COUNTERS
+//
+//  Post Conditions: returns the work counted, on every thread, up to the
+//                   last call to end_tick
+//
+//  Calls:      none
+//
+//******************************************************************
+uint64_t WorkCounters::get_total(GLuint counter) const {
+    return totals[counter];
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::add
+//
+//  Purpose:    counts work on the calling thread
+//
+//  Parameters: counter, amount
+//
+//  Member/Global Variables: none
+//
+//  Pre Conditions:  counter must be below NUM_COUNTERS, and end_tick
+//                   must not be running
+//
+//  Post Conditions: amount will have been added to the calling thread's
+//                   count of counter
+//
+//  Calls:      get_block
+//
+//******************************************************************
+void WorkCounters::add(GLuint counter, uint64_t amount) {
+    get_block()->counts[counter] += amount;
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::end_tick
+//
+//  Purpose:    totals the work counted since the last tick ended
+//
+//  Parameters: none
+//
+//  Member/Global Variables: blocks, ticks, last_tick, totals,
+//                           interval_counts, file, dump_interval,
+//                           COUNTER_NAMES
+//
+//  Pre Conditions:  no other thread may be counting (threads that count
+//                   must have been joined or waited on since)
+//
+//  Post Conditions: the counts of every thread will have been moved into
+//                   the last tick's counts and the totals; if a dump is
+//                   open and dump_interval ticks have ended since its
+//                   last line, a line of the counts since then will have
+//                   been written to it
+//
+//  Calls:      std::fill, std::ofstream::operator<<
+//
+//******************************************************************
+void WorkCounters::end_tick() {
+    std::fill(last_tick, last_tick + NUM_COUNTERS, 0);
+    for (CounterBlock* block = blocks.load(std::memory_order_acquire); block != nullptr; block = block->next) {
+        for (GLuint i = 0; i < NUM_COUNTERS; ++i) {
+            last_tick[i] += block->counts[i];
+            block->counts[i] = 0;
+        }
+    }
+    for (GLuint i = 0; i < NUM_COUNTERS; ++i) {
+        totals[i] += last_tick[i];
+        interval_counts[i] += last_tick[i];
+    }
+    ticks++;
+
+    if (is_open() && ticks % dump_interval == 0) {
+        file << ticks;
+        for (GLuint i = 0; i < NUM_COUNTERS; ++i) {
+            file << " " << interval_counts[i];
+        }
+        file << "\n";
+        std::fill(interval_counts, interval_counts + NUM_COUNTERS, 0);
+    }
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::open
+//
+//  Purpose:    starts a dump of the counts
+//
+//  Parameters: path, interval
+//
+//  Member/Global Variables: file, dump_interval, interval_counts,
+//                           COUNTER_NAMES
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: the file at path will start with a line naming the
+//                   columns (tick, then every counter in the order of
+//                   COUNTER_NAMES), and whenever the number of ticks
+//                   ended is a multiple of interval a line of it and the
+//                   counts since the last line is added; returns false, after printing why to
+//                   standard error, if it couldn't be written
+//
+//  Calls:      close, std::max, std::ofstream::open
+//
+//******************************************************************
+bool WorkCounters::open(const std::string& path, GLuint interval) {
+    close();
+
+    file.open(path, std::ios::trunc);
+    file << "tick";
+    for (GLuint i = 0; i < NUM_COUNTERS; ++i) {
+        file << " " << COUNTER_NAMES[i];
+    }
+    file << "\n";
+    if (!file) {
+        file.close();
+        std::cerr << "Unable to write counters " << path << ".\n";
+        return false;
+    }
+
+    dump_interval = std::max(interval, 1u);
+    std::fill(interval_counts, interval_counts + NUM_COUNTERS, 0);
+    return true;
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::close
+//
+//  Purpose:    finishes the dump
+//
+//  Parameters: none
+//
+//  Member/Global Variables: file
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: every line of the dump will have been written out,
+//                   and no more are added
+//
+//  Calls:      std::ofstream::close
+//
+//******************************************************************
+void WorkCounters::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::is_open
+//
+//  Purpose:    returns whether counts are being dumped
+//
+//  Parameters: none
+//
+//  Member/Global Variables: file
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns true if a dump is open
+//
+//  Calls:      std::ofstream::is_open
+//
+//******************************************************************
+bool WorkCounters::is_open() const {
+    return file.is_open();
+}
+
+//******************************************************************
+//
+//  Function:   WorkCounters::get_block
+//
+//  Purpose:    returns the calling thread's block
+//
+//  Parameters: none
+//
+//  Member/Global Variables: blocks, id, thread_block
+//
+//  Pre Conditions:  none
+//
+//  Post Conditions: returns the block the calling thread counts into,
+//                   after adding one to the front of the list if it has
+//                   none (with a compare and swap, so threads never
+//                   wait on each other)
+//
+//  Calls:      std::this_thread::get_id,
+//              std::atomic::compare_exchange_weak
+//
+//******************************************************************
+CounterBlock* WorkCounters::get_block() {
+    if (thread_block.id == id) {
+        return thread_block.block;
+    }
+
+    // a thread that counted into other counters in between already has a block here
+    std::thread::id owner = std::this_thread::get_id();
+    CounterBlock* block = blocks.load(std::memory_order_acquire);
+    while (block != nullptr && block->owner != owner) {
+        block = block->next;
+    }
+
+    if (block == nullptr) {
+        block = new CounterBlock();
+        std::fill(block->counts, block->counts + NUM_COUNTERS, 0);
+        block->owner = owner;
+        block->next = blocks.load(std::memory_order_relaxed);
+        while (!blocks.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+            // another thread added its block first, so block->next now holds it; try again
+        }
+    }
+
+    thread_block.id = id;
+    thread_block.block = block;
+    return block;
+}
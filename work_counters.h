@@ -0,0 +1,135 @@
+//*******************************************************************
+//
+//    Program:     Project 2 - Food Drop Game
+//    File:        work_counters.h
+//
+//    Author:      Kirk Saunders
+//    Email:       ks825016@ohio.edu
+//
+//    Description: This class counts the algorithmic work the game does
+//                 every tick (line of sight tests, trees tested, wander
+//                 targets tried, food drops considered, objects removed,
+//                 flow fields built, and draw calls and uniforms sent), so
+//                 a slowdown can be told apart as more work being done or
+//                 the same work being done slower. Counts can be read
+//                 after any tick and written to a text file every so many
+//                 ticks.
+//
+//    Date:        10/17/2019
+//
+//*******************************************************************
+
+#ifndef WORK_COUNTERS_H
+#define WORK_COUNTERS_H
+
+// C/C++ Standard libraries
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+
+// Third-Party libraries
+#include <Angel.h>
+
+// Kinds of work counted
+const GLuint COUNTER_CAN_REACH = 0;  // line of sight tests (Simulation::can_reach calls)
+const GLuint COUNTER_TREE_TESTS = 1;  // trees a line of sight test was checked against (cache misses only)
+const GLuint COUNTER_WANDER_ATTEMPTS = 2;  // wander targets tried, including the ones rejected
+const GLuint COUNTER_TARGET_FOOD = 3;  // food drops a unit considered targeting
+const GLuint COUNTER_REMOVED = 4;  // food drops and units removed
+const GLuint COUNTER_DRAW_CALLS = 5;  // draw calls made
+const GLuint COUNTER_UNIFORM_UPLOADS = 6;  // uniform values sent to the shader
+const GLuint COUNTER_FLOW_FIELDS = 7;  // flow fields built for food drops
+const GLuint NUM_COUNTERS = 8;  // number of kinds of work counted
+
+// Names counters are written with, by counter (the columns of a dump, which never change order)
+constexpr char const* COUNTER_NAMES[NUM_COUNTERS] = {
+    "can_reach_calls", "tree_tests", "wander_attempts", "target_food_evaluations", "entities_removed",
+    "draw_calls", "uniform_uploads", "flow_fields_built"
+};
+
+// Default ticks between lines of a dump
+const GLuint DEFAULT_DUMP_TICKS = 60;
+
+// One thread's counts since the last tick ended
+struct CounterBlock {
+    uint64_t counts[NUM_COUNTERS];  // work counted by the thread, by counter
+    std::thread::id owner;  // thread that counts into the block
+    CounterBlock* next;  // block of the thread that started counting before this one
+    char padding[64];  // keeps the counts of blocks allocated next to each other off the same cache line
+};
+
+//******************************************************************
+//
+//  Class: WorkCounters
+//
+//  Purpose:  To count work from any thread without locking or sharing
+//            memory (every thread adds to a block of its own, found
+//            through a thread local pointer), and total the blocks once
+//            a tick is over.
+//
+//  Functions:
+//           Constructors
+//             WorkCounters() creates counters that have counted nothing
+//           Destructor
+//             ~WorkCounters() finishes the dump and frees every block
+//           getters
+//             get_ticks to return the number of ticks ended
+//             get_last_tick(counter) to return a counter's count in the
+//                                    last tick ended
+//             get_total(counter) to return a counter's count over every
+//                                tick ended
+//           mutators
+//             add(counter, amount) counts work on the calling thread
+//             end_tick() totals the work counted since the last tick, and
+//                        dumps it if it's time to
+//             open(path, interval) starts a dump of the counts of every
+//                                  interval ticks
+//             close() finishes the dump
+//           helpers
+//             is_open() returns true if counts are being dumped
+//           private helpers
+//             get_block() returns the calling thread's block, adding it if
+//                         it has none
+//
+//******************************************************************
+
+class WorkCounters {
+ public:
+    WorkCounters();
+    WorkCounters(const WorkCounters&) = delete;  // no copy constructor
+    WorkCounters operator=(const WorkCounters&) = delete;  // no copy assignment operator
+    ~WorkCounters();
+
+    // getters
+    uint64_t get_ticks() const;
+    uint64_t get_last_tick(GLuint counter) const;
+    uint64_t get_total(GLuint counter) const;
+
+    // mutators
+    void add(GLuint counter, uint64_t amount = 1);
+    void end_tick();
+    bool open(const std::string& path, GLuint interval = DEFAULT_DUMP_TICKS);
+    void close();
+
+    // helpers
+    bool is_open() const;
+ private:
+    std::atomic<CounterBlock*> blocks;  // block of every thread that has counted, newest first
+    uint64_t id;  // unique number of the counters, so threads can tell their block belongs to them
+    uint64_t ticks;  // number of ticks ended
+    uint64_t last_tick[NUM_COUNTERS];  // counts of the last tick ended
+    uint64_t totals[NUM_COUNTERS];  // counts of every tick ended
+    uint64_t interval_counts[NUM_COUNTERS];  // counts since the last line of the dump
+    std::ofstream file;  // dump being written
+    GLuint dump_interval;  // ticks between lines of the dump
+
+    // static member variables
+    static std::atomic<uint64_t> counters_made;  // number of counters made
+
+    // private helpers
+    CounterBlock* get_block();
+};
+
+#endif